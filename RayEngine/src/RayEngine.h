@@ -1,3 +1,21 @@
 #include "RayEngine/Core/Application.h"
 #include "RayEngine/Core/Log.h"
-#include "RayEngine/Core/Profiler.h"
\ No newline at end of file
+#include "RayEngine/Core/Profiler.h"
+#include "RayEngine/Core/AllocationTracker.h"
+#include "RayEngine/Core/Task.h"
+#include "RayEngine/Core/Scheduler.h"
+#include "RayEngine/Core/SharedAssets.h"
+#include "RayEngine/Core/ParallelFor.h"
+#include "RayEngine/Core/Topology.h"
+#include "RayEngine/Core/NumaMemory.h"
+#include "RayEngine/ECS/World.h"
+#include "RayEngine/IO/IOService.h"
+#include "RayEngine/Geometry/BVH.h"
+#include "RayEngine/Geometry/CompressedWideBVH.h"
+#include "RayEngine/Geometry/StreamingGeometry.h"
+#include "RayEngine/Lighting/LightBVH.h"
+#include "RayEngine/Sampling/Sampler.h"
+#include "RayEngine/Film/Film.h"
+#include "RayEngine/Render/TileCache.h"
+#include "RayEngine/Render/IncrementalRenderer.h"
+#include "RayEngine/Render/PathIntegrator.h"
@@ -0,0 +1,253 @@
+#include "AllocationTracker.h"
+#include "Log.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace RayEngine
+{
+	namespace
+	{
+		struct TagCounters
+		{
+			std::atomic<std::uint64_t> Allocations{ 0 };
+			std::atomic<std::uint64_t> Frees{ 0 };
+			std::atomic<std::uint64_t> TotalBytes{ 0 };
+			std::atomic<std::int64_t> LiveBytes{ 0 };
+			std::atomic<std::int64_t> PeakBytes{ 0 };
+		};
+
+		constexpr std::size_t tagCount = static_cast<std::size_t>(AllocationTag::Count);
+
+		// constinit: operator new can run before any dynamic initializer.
+		constinit std::array<TagCounters, tagCount> s_Tags{};
+
+		// Per thread, so every Application's main loop closes only its own frames.
+		constinit thread_local std::uint64_t t_FrameAllocations = 0;
+		constinit thread_local std::uint64_t t_FrameBytes = 0;
+		constinit thread_local FrameAllocationStats t_LastFrame{};
+
+		constinit thread_local AllocationTag t_Tag = AllocationTag::Untagged;
+		constinit thread_local std::uint32_t t_NoAllocDepth = 0;
+		constinit thread_local std::uint64_t t_Violations = 0;
+		constinit thread_local std::uint64_t t_ViolationBytes = 0;
+	}
+
+	const char* ToString(AllocationTag tag) noexcept
+	{
+		switch (tag)
+		{
+		case AllocationTag::Untagged:  return "Untagged";
+		case AllocationTag::Core:      return "Core";
+		case AllocationTag::Layers:    return "Layers";
+		case AllocationTag::Scheduler: return "Scheduler";
+		case AllocationTag::IO:        return "IO";
+		case AllocationTag::Client:    return "Client";
+		default:                       return "Unknown";
+		}
+	}
+
+	AllocationTag AllocationTracker::GetCurrentTag() noexcept
+	{
+		return t_Tag;
+	}
+
+	void AllocationTracker::SetCurrentTag(AllocationTag tag) noexcept
+	{
+		t_Tag = tag;
+	}
+
+	AllocationTagStats AllocationTracker::GetTagStats(AllocationTag tag) noexcept
+	{
+		const auto index = static_cast<std::size_t>(tag);
+		if (index >= tagCount)
+			return {};
+
+		const TagCounters& counters = s_Tags[index];
+		AllocationTagStats stats;
+		stats.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+		stats.Frees = counters.Frees.load(std::memory_order_relaxed);
+		stats.TotalBytes = counters.TotalBytes.load(std::memory_order_relaxed);
+		stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+		stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	FrameAllocationStats AllocationTracker::EndFrame() noexcept
+	{
+		t_LastFrame = { std::exchange(t_FrameAllocations, 0), std::exchange(t_FrameBytes, 0) };
+		return t_LastFrame;
+	}
+
+	FrameAllocationStats AllocationTracker::GetLastFrame() noexcept
+	{
+		return t_LastFrame;
+	}
+
+	void AllocationTracker::LogReport()
+	{
+		if (!IsEnabled())
+			return;
+
+		RAY_CORE_INFO("[AllocationTracker] {:<10} {:>10} {:>10} {:>14} {:>12} {:>12}",
+			"tag", "allocs", "frees", "total bytes", "live bytes", "peak bytes");
+		for (std::size_t i = 0; i < tagCount; ++i)
+		{
+			const auto tag = static_cast<AllocationTag>(i);
+			const AllocationTagStats stats = GetTagStats(tag);
+			RAY_CORE_INFO("[AllocationTracker] {:<10} {:>10} {:>10} {:>14} {:>12} {:>12}",
+				ToString(tag), stats.Allocations, stats.Frees, stats.TotalBytes, stats.LiveBytes, stats.PeakBytes);
+		}
+	}
+
+	void AllocationTracker::OnAllocate(AllocationTag tag, std::size_t size) noexcept
+	{
+		TagCounters& counters = s_Tags[static_cast<std::size_t>(tag)];
+		counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+		counters.TotalBytes.fetch_add(size, std::memory_order_relaxed);
+		const std::int64_t live = counters.LiveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed)
+			+ static_cast<std::int64_t>(size);
+
+		std::int64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+		++t_FrameAllocations;
+		t_FrameBytes += size;
+
+		if (NoAllocationScope::IsActive())
+			NoAllocationScope::RecordViolation(size);
+	}
+
+	void AllocationTracker::OnFree(AllocationTag tag, std::size_t size) noexcept
+	{
+		TagCounters& counters = s_Tags[static_cast<std::size_t>(tag)];
+		counters.Frees.fetch_add(1, std::memory_order_relaxed);
+		counters.LiveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+	}
+
+	// --- NoAllocationScope ---
+	NoAllocationScope::NoAllocationScope(std::string_view name, bool assertOnViolation) noexcept
+		: m_Name(name)
+		, m_Assert(assertOnViolation)
+		, m_StartViolations(t_Violations)
+		, m_StartBytes(t_ViolationBytes)
+	{
+		++t_NoAllocDepth;
+	}
+
+	NoAllocationScope::~NoAllocationScope()
+	{
+		--t_NoAllocDepth;
+
+		const std::uint64_t violations = GetViolations();
+		if (violations == 0)
+			return;
+
+		const std::uint64_t bytes = t_ViolationBytes - m_StartBytes;
+		RAY_CORE_ERROR("[AllocationTracker] {} allocation(s), {} bytes inside no-allocation scope '{}'", violations, bytes, m_Name);
+		assert(!m_Assert && "allocation inside NoAllocationScope");
+	}
+
+	std::uint64_t NoAllocationScope::GetViolations() const noexcept
+	{
+		return t_Violations - m_StartViolations;
+	}
+
+	bool NoAllocationScope::IsActive() noexcept
+	{
+		return t_NoAllocDepth > 0;
+	}
+
+	void NoAllocationScope::RecordViolation(std::size_t size) noexcept
+	{
+		++t_Violations;
+		t_ViolationBytes += size;
+	}
+}
+
+#ifdef RAY_TRACK_ALLOCATIONS
+// Replacement global allocation functions.
+// Every block carries a 16-byte header in front of the user pointer recording its size, tag and
+// the distance back to the malloc'd base, so sized/unsized and aligned/unaligned deletes all work.
+namespace
+{
+	struct alignas(16) AllocationHeader
+	{
+		std::uint64_t Size;
+		std::uint32_t Offset;
+		RayEngine::AllocationTag Tag;
+	};
+	static_assert(sizeof(AllocationHeader) == 16);
+
+	void* TrackedAllocate(std::size_t size, std::size_t alignment) noexcept
+	{
+		alignment = alignment < alignof(AllocationHeader) ? alignof(AllocationHeader) : alignment;
+		const std::size_t overhead = sizeof(AllocationHeader) + (alignment - alignof(AllocationHeader));
+		if (size > std::numeric_limits<std::size_t>::max() - overhead)
+			return nullptr; // the padded size would wrap; callers that may throw report bad_alloc
+		const std::size_t total = size + overhead;
+		auto* base = static_cast<unsigned char*>(std::malloc(total));
+		if (!base)
+			return nullptr;
+
+		const auto first = reinterpret_cast<std::uintptr_t>(base) + sizeof(AllocationHeader);
+		const auto user = (first + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+		auto* header = reinterpret_cast<AllocationHeader*>(user - sizeof(AllocationHeader));
+		header->Size = size;
+		header->Offset = static_cast<std::uint32_t>(user - reinterpret_cast<std::uintptr_t>(base));
+		header->Tag = RayEngine::AllocationTracker::GetCurrentTag();
+
+		RayEngine::AllocationTracker::OnAllocate(header->Tag, size);
+		return reinterpret_cast<void*>(user);
+	}
+
+	void TrackedFree(void* ptr) noexcept
+	{
+		if (!ptr)
+			return;
+		auto* header = reinterpret_cast<AllocationHeader*>(static_cast<unsigned char*>(ptr) - sizeof(AllocationHeader));
+		RayEngine::AllocationTracker::OnFree(header->Tag, header->Size);
+		std::free(static_cast<unsigned char*>(ptr) - header->Offset);
+	}
+
+	void* TrackedAllocateOrThrow(std::size_t size, std::size_t alignment)
+	{
+		for (;;)
+		{
+			if (void* ptr = TrackedAllocate(size, alignment))
+				return ptr;
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc();
+			handler();
+		}
+	}
+}
+
+void* operator new(std::size_t size) { return TrackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return TrackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t align) { return TrackedAllocateOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return TrackedAllocateOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace RayEngine
+{
+	// Subsystem attributed to an allocation. The tag is taken from the allocating thread
+	// (see AllocationTagScope), not from the type being allocated.
+	enum class AllocationTag : std::uint8_t
+	{
+		Untagged = 0,
+		Core,
+		Layers,
+		Scheduler,
+		IO,
+		Client,
+		Count
+	};
+
+	[[nodiscard]] const char* ToString(AllocationTag tag) noexcept;
+
+	struct AllocationTagStats
+	{
+		std::uint64_t Allocations = 0;
+		std::uint64_t Frees = 0;
+		std::uint64_t TotalBytes = 0;
+		std::int64_t LiveBytes = 0;
+		std::int64_t PeakBytes = 0;
+	};
+
+	struct FrameAllocationStats
+	{
+		std::uint64_t Allocations = 0;
+		std::uint64_t Bytes = 0;
+	};
+
+	// Optional global allocation instrumentation.
+	// Build with -DRAY_TRACK_ALLOCATIONS=ON to replace global operator new/delete; every allocation
+	// is then attributed to the calling thread's current tag and counted per frame.
+	// Without the option all queries return zeros and the scope helpers compile to nothing.
+	class AllocationTracker
+	{
+	public:
+		[[nodiscard]] static constexpr bool IsEnabled() noexcept
+		{
+#ifdef RAY_TRACK_ALLOCATIONS
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		[[nodiscard]] static AllocationTag GetCurrentTag() noexcept;
+		static void SetCurrentTag(AllocationTag tag) noexcept;
+
+		[[nodiscard]] static AllocationTagStats GetTagStats(AllocationTag tag) noexcept;
+
+		// Close the current frame: returns its totals and starts counting the next one.
+		// Called once per frame by Application::Run(). Frame totals are per thread: they count
+		// allocations made on the calling thread since its last EndFrame(), so each Application
+		// sees only its own loop, and work handed to pool threads is not included.
+		static FrameAllocationStats EndFrame() noexcept;
+		// Totals of the calling thread's last closed frame.
+		[[nodiscard]] static FrameAllocationStats GetLastFrame() noexcept;
+
+		// Per-tag live / peak / total table through the core logger.
+		static void LogReport();
+
+		// Hooks used by the replaced operator new/delete.
+		static void OnAllocate(AllocationTag tag, std::size_t size) noexcept;
+		static void OnFree(AllocationTag tag, std::size_t size) noexcept;
+	};
+
+	// Attribute allocations made on this thread to `tag` until the scope ends.
+	class AllocationTagScope
+	{
+	public:
+		explicit AllocationTagScope(AllocationTag tag) noexcept
+			: m_Previous(AllocationTracker::GetCurrentTag())
+		{
+			AllocationTracker::SetCurrentTag(tag);
+		}
+		~AllocationTagScope() { AllocationTracker::SetCurrentTag(m_Previous); }
+
+		AllocationTagScope(const AllocationTagScope&) = delete;
+		AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+		AllocationTagScope(AllocationTagScope&&) = delete;
+		AllocationTagScope& operator=(AllocationTagScope&&) = delete;
+
+	private:
+		AllocationTag m_Previous;
+	};
+
+	// "No allocations allowed here": any allocation on this thread while the scope is alive is a
+	// violation. Violations are counted inside operator new (which cannot log) and reported when
+	// the scope ends; with `assertOnViolation` the report is followed by an assert in debug builds.
+	class NoAllocationScope
+	{
+	public:
+		explicit NoAllocationScope(std::string_view name, bool assertOnViolation = true) noexcept;
+		~NoAllocationScope();
+
+		NoAllocationScope(const NoAllocationScope&) = delete;
+		NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+		NoAllocationScope(NoAllocationScope&&) = delete;
+		NoAllocationScope& operator=(NoAllocationScope&&) = delete;
+
+		[[nodiscard]] std::uint64_t GetViolations() const noexcept;
+
+		// Used by operator new.
+		[[nodiscard]] static bool IsActive() noexcept;
+		static void RecordViolation(std::size_t size) noexcept;
+
+	private:
+		std::string_view m_Name;
+		bool m_Assert;
+		std::uint64_t m_StartViolations;
+		std::uint64_t m_StartBytes;
+	};
+}
+
+// Macros for allocation tracking
+#ifdef RAY_TRACK_ALLOCATIONS
+// Two levels so __LINE__ is expanded before pasting.
+#define RAY_ALLOC_CONCAT_IMPL(a, b) a##b
+#define RAY_ALLOC_CONCAT(a, b) RAY_ALLOC_CONCAT_IMPL(a, b)
+#define RAY_ALLOC_TAG(tag) ::RayEngine::AllocationTagScope RAY_ALLOC_CONCAT(allocTag, __LINE__)(::RayEngine::AllocationTag::tag)
+#define RAY_NO_ALLOC_SCOPE(name) ::RayEngine::NoAllocationScope RAY_ALLOC_CONCAT(noAlloc, __LINE__)(name)
+#else // tracking disabled: no-op
+#define RAY_ALLOC_TAG(tag)
+#define RAY_NO_ALLOC_SCOPE(name)
+#endif
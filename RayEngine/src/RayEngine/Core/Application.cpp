@@ -2,6 +2,7 @@
 #include "Log.h"
 #include "Profiler.h"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <utility>
@@ -10,12 +11,62 @@
 
 namespace RayEngine
 {
+	namespace
+	{
+		thread_local Application* t_CurrentApplication = nullptr;
+	}
+
 	// initialize owned resources so callers can PushLayer before Run()
-	Application::Application()
-		: m_Time()
+	Application::Application(ApplicationSpecification specification)
+		: m_Specification(std::move(specification))
+		, m_Time()
 		, m_IsRunning(false)
 		, m_LayerStack(std::make_unique<LayerStack>())
+		, m_Topology(m_Specification.SimulatedNumaNodes > 0
+			? CpuTopology::Simulate(m_Specification.SimulatedNumaNodes)
+			: CpuTopology::Detect())
+		, m_ThreadPool(std::make_unique<ThreadPool>(m_Specification.WorkerThreads,
+			ThreadPlacement{ &m_Topology, m_Specification.WorkerAffinity }))
+		, m_Scheduler(std::make_unique<Scheduler>())
+		, m_World(std::make_unique<World>())
+		, m_IOService(std::make_unique<IOService>(m_Specification.IOBackend))
+	{
+		m_Scheduler->SetThreadPool(m_ThreadPool.get());
+		m_Scheduler->SetWakeEvent(&m_WakeEvent);
+		m_IOService->SetWakeEvent(&m_WakeEvent);
+		m_World->SetWakeEvent(&m_WakeEvent);
+	}
+
+	Application::~Application()
+	{
+		// Layers may log or call GetInstance() from OnDetach; keep them pointed at this instance.
+		CurrentScope scope(*this);
+		m_LayerStack.reset();
+	}
+
+	Application& Application::GetInstance() noexcept
 	{
+		if (t_CurrentApplication)
+			return *t_CurrentApplication;
+		static Application instance;
+		return instance;
+	}
+
+	Application* Application::GetCurrent() noexcept
+	{
+		return t_CurrentApplication;
+	}
+
+	Application::CurrentScope::CurrentScope(Application& app) noexcept
+		: m_Previous(t_CurrentApplication)
+		, m_LogScope(&app.m_CoreLogger, &app.m_ClientLogger)
+	{
+		t_CurrentApplication = &app;
+	}
+
+	Application::CurrentScope::~CurrentScope()
+	{
+		t_CurrentApplication = m_Previous;
 	}
 
 	/*
@@ -29,14 +80,33 @@ namespace RayEngine
 		  during the update loop is undefined for iteration safety.
 		- PopLayerAsync provides a callback that receives the popped ownership on the main
 		  thread so callers can reuse the layer object if needed.
+		- ApplyPending() also applies the World's deferred entity commands (CreateDeferred,
+		  DestroyDeferred, ...) after the layer operations, so systems see a stable world all frame.
+		- IOService::Update() runs right after ApplyPending(): finished reads invoke their callbacks
+		  on the main thread and reads queued during the previous frame are submitted as one batch.
+		- With RAY_TRACK_ALLOCATIONS, each phase runs under its AllocationTag (Layers, IO, Scheduler,
+		  Client for layer updates) and per-frame allocation totals are closed at the end of the frame.
+		- Spawned coroutine Tasks are resumed by the Scheduler after ApplyPending() and Tick(),
+		  before layers are updated. Tasks awaiting AwaitPushLayer/AwaitPopLayer therefore observe
+		  the mutation in the same frame it is applied.
+		- Between frames the loop sleeps 1 ms. With WakeOnWork, when nothing is pending (no queued
+		  layer ops or entity commands, no coroutine ready or due, no RequestFrame()), it blocks on
+		  m_WakeEvent until the next timer instead. Async layer requests, Scheduler::Post(),
+		  IOService reads and completions, World::*Deferred commands, RequestFrame() and Stop()
+		  signal the event. The blocked
+		  time is passed to Time::SkipIdle(), so the next frame's delta only covers real frame time.
 	*/
 
 	[[nodiscard]] bool Application::Run()
 	{
+		CurrentScope current(*this);
 		RAY_PROFILE_FUNCTION();
+		RAY_ALLOC_TAG(Core);
 
 		m_Time.Reset();
 		m_IsRunning.store(true);
+		// Start-up allocations do not belong to the first frame.
+		AllocationTracker::EndFrame();
 
 		RAY_CORE_INFO("Application started");
 
@@ -49,13 +119,26 @@ namespace RayEngine
 			// or during previous frames. This must run before we iterate/update layers.
 			ApplyPending();
 
+			// Same safe point: run I/O completion callbacks and submit this frame's read batch.
+			{
+				RAY_ALLOC_TAG(IO);
+				m_IOService->Update();
+			}
+
 			// Delta time in seconds (float)
 			m_Time.Tick();
 			const float deltaTime = m_Time.GetDeltaSecondsf();
 
+			// Resume coroutines that are due this frame (next-frame, timers, background completions).
+			{
+				RAY_ALLOC_TAG(Scheduler);
+				m_Scheduler->Tick();
+			}
+
 			// Iterate live LayerStack directly. Mutations during the frame must be enqueued.
 			if (m_LayerStack)
 			{
+				RAY_ALLOC_TAG(Client);
 				for (auto& uptr : *m_LayerStack) // iterates std::unique_ptr<Layer>&
 				{
 					if (!uptr) continue;
@@ -74,8 +157,9 @@ namespace RayEngine
 				}
 			}
 
-			// small sleep to avoid busy-loop while you refine frame timing / message pump
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			EndFrameAllocations();
+
+			WaitForWork();
 		}
 
 		RAY_CORE_INFO("Application stopping");
@@ -88,7 +172,17 @@ namespace RayEngine
 		// Initialize logging first.
 		try
 		{
-			Log::Init();
+			if (!m_LogInitialized)
+			{
+				Log::Init();
+				m_LogInitialized = true;
+			}
+			if (!m_Specification.Name.empty())
+			{
+				m_CoreLogger = Log::CreateInstanceLogger(m_Specification.Name);
+				m_ClientLogger = Log::CreateInstanceLogger(m_Specification.Name + ":APP");
+			}
+			CurrentScope current(*this);
 			RAY_CORE_INFO("Application initializing");
 			return true;
 		}
@@ -109,20 +203,37 @@ namespace RayEngine
 
 	void Application::Shutdown() noexcept
 	{
+		CurrentScope current(*this);
 		RAY_PROFILE_FUNCTION();
 		RAY_CORE_INFO("Shutting down...");
-		Log::ShutDown();
+		if (AllocationTracker::IsEnabled())
+		{
+			RAY_CORE_INFO("[Application] {} frame(s) exceeded the allocation budget", m_FramesOverAllocationBudget);
+			AllocationTracker::LogReport();
+		}
+		// Finish outstanding reads so no caller buffer is written after this point.
+		m_IOService->Drain();
+		// Join workers first so no background job can post into a scheduler that is being cleared.
+		m_ThreadPool->Shutdown();
+		m_Scheduler->Clear();
+		if (m_LogInitialized)
+		{
+			m_LogInitialized = false;
+			Log::ShutDown();
+		}
 	}
 
 	// --- synchronous operations (main-thread expected) ---
 	void Application::PushLayer(std::unique_ptr<Layer> layer)
 	{
+		CurrentScope current(*this);
 		if (m_LayerStack && layer)
 			m_LayerStack->PushLayer(std::move(layer));
 	}
 
 	void Application::PushOverlay(std::unique_ptr<Layer> overlay)
 	{
+		CurrentScope current(*this);
 		if (m_LayerStack && overlay)
 			m_LayerStack->PushOverlay(std::move(overlay));
 	}
@@ -142,13 +253,16 @@ namespace RayEngine
 		// remains CopyConstructible (std::function requires copyable targets).
 		auto holder = std::make_shared<std::unique_ptr<Layer>>(std::move(layer));
 
-		std::lock_guard lock(m_PendingMutex);
-		m_PendingOps.emplace_back([this, holder]() mutable {
-			if (m_LayerStack && holder && *holder)
-			{
-				m_LayerStack->PushLayer(std::move(*holder));
-			}
-		});
+		{
+			std::lock_guard lock(m_PendingMutex);
+			m_PendingOps.emplace_back([this, holder]() mutable {
+				if (m_LayerStack && holder && *holder)
+				{
+					m_LayerStack->PushLayer(std::move(*holder));
+				}
+			});
+		}
+		m_WakeEvent.Signal();
 	}
 
 	void Application::PushOverlayAsync(std::unique_ptr<Layer> overlay) noexcept
@@ -157,22 +271,28 @@ namespace RayEngine
 
 		auto holder = std::make_shared<std::unique_ptr<Layer>>(std::move(overlay));
 
-		std::lock_guard lock(m_PendingMutex);
-		m_PendingOps.emplace_back([this, holder]() mutable {
-			if (m_LayerStack && holder && *holder)
-			{
-				m_LayerStack->PushOverlay(std::move(*holder));
-			}
-		});
+		{
+			std::lock_guard lock(m_PendingMutex);
+			m_PendingOps.emplace_back([this, holder]() mutable {
+				if (m_LayerStack && holder && *holder)
+				{
+					m_LayerStack->PushOverlay(std::move(*holder));
+				}
+			});
+		}
+		m_WakeEvent.Signal();
 	}
 
 	void Application::RemoveLayerAsync(Layer* layer) noexcept
 	{
 		if (!layer) return;
-		std::lock_guard lock(m_PendingMutex);
-		m_PendingOps.emplace_back([this, layer]() {
-			if (m_LayerStack) m_LayerStack->RemoveLayer(layer);
-		});
+		{
+			std::lock_guard lock(m_PendingMutex);
+			m_PendingOps.emplace_back([this, layer]() {
+				if (m_LayerStack) m_LayerStack->RemoveLayer(layer);
+			});
+		}
+		m_WakeEvent.Signal();
 	}
 
 	void Application::PopLayerAsync(Layer* layer, PopCallback cb) noexcept
@@ -182,28 +302,118 @@ namespace RayEngine
 			if (cb) cb(nullptr);
 			return;
 		}
-		std::lock_guard lock(m_PendingMutex);
-		// Capture `cb` by value (copy) instead of using a move-capture; this keeps the lambda copyable.
-		m_PendingOps.emplace_back([this, layer, cb]() mutable {
-			if (!m_LayerStack)
-			{
-				if (cb) cb(nullptr);
-				return;
-			}
-			auto popped = m_LayerStack->PopLayer(layer); // returns unique_ptr
-			if (cb) cb(std::move(popped));
-		});
+		{
+			std::lock_guard lock(m_PendingMutex);
+			// Capture `cb` by value (copy) instead of using a move-capture; this keeps the lambda copyable.
+			m_PendingOps.emplace_back([this, layer, cb]() mutable {
+				if (!m_LayerStack)
+				{
+					if (cb) cb(nullptr);
+					return;
+				}
+				auto popped = m_LayerStack->PopLayer(layer); // returns unique_ptr
+				if (cb) cb(std::move(popped));
+			});
+		}
+		m_WakeEvent.Signal();
+	}
+
+	// --- coroutine support ---
+	void Application::Spawn(Task<> task)
+	{
+		m_Scheduler->Spawn(std::move(task));
+	}
+
+	Scheduler& Application::GetScheduler() noexcept
+	{
+		assert(m_Scheduler && "Scheduler must be initialized");
+		return *m_Scheduler;
+	}
+
+	ThreadPool& Application::GetThreadPool() noexcept
+	{
+		assert(m_ThreadPool && "ThreadPool must be initialized");
+		return *m_ThreadPool;
+	}
+
+	World& Application::GetWorld() noexcept
+	{
+		assert(m_World && "World must be initialized");
+		return *m_World;
+	}
+
+	IOService& Application::GetIOService() noexcept
+	{
+		assert(m_IOService && "IOService must be initialized");
+		return *m_IOService;
+	}
+
+	Application::LayerPushAwaitable Application::AwaitPushLayer(std::unique_ptr<Layer> layer) noexcept
+	{
+		return LayerPushAwaitable(*this, std::move(layer), false);
+	}
+
+	Application::LayerPushAwaitable Application::AwaitPushOverlay(std::unique_ptr<Layer> overlay) noexcept
+	{
+		return LayerPushAwaitable(*this, std::move(overlay), true);
+	}
+
+	Application::LayerPopAwaitable Application::AwaitPopLayer(Layer* layer) noexcept
+	{
+		return LayerPopAwaitable(*this, layer);
+	}
+
+	// The awaitables live in the suspended coroutine frame, so the pending op only needs `this`.
+	void Application::LayerPushAwaitable::await_suspend(std::coroutine_handle<> handle)
+	{
+		{
+			std::lock_guard lock(m_App->m_PendingMutex);
+			m_App->m_PendingOps.emplace_back([this, handle]() {
+				Application& app = *m_App;
+				Layer* raw = m_Layer.get();
+				try
+				{
+					if (m_Overlay)
+						app.m_LayerStack->PushOverlay(std::move(m_Layer));
+					else
+						app.m_LayerStack->PushLayer(std::move(m_Layer));
+					m_Result = raw;
+				}
+				catch (...)
+				{
+					// LayerStack already logged and rolled back; resume the task with nullptr.
+					m_Result = nullptr;
+				}
+				app.m_Scheduler->Schedule(handle);
+			});
+		}
+		m_App->m_WakeEvent.Signal();
+	}
+
+	void Application::LayerPopAwaitable::await_suspend(std::coroutine_handle<> handle)
+	{
+		{
+			std::lock_guard lock(m_App->m_PendingMutex);
+			m_App->m_PendingOps.emplace_back([this, handle]() {
+				Application& app = *m_App;
+				m_Result = app.m_LayerStack->PopLayer(m_Layer);
+				app.m_Scheduler->Schedule(handle);
+			});
+		}
+		m_App->m_WakeEvent.Signal();
 	}
 
 	// Apply pending ops on main thread. Safe point to mutate LayerStack.
 	void Application::ApplyPending() noexcept
 	{
-		std::vector<std::function<void()>> ops;
+		RAY_ALLOC_TAG(Layers);
+
+		// m_ExecutingOps is empty here; swapping keeps both buffers' capacity across frames.
 		{
 			std::lock_guard lock(m_PendingMutex);
-			ops.swap(m_PendingOps);
+			m_ExecutingOps.swap(m_PendingOps);
 		}
-		for (auto& op : ops)
+		for (auto& op : m_ExecutingOps)
 		{
 			try
 			{
@@ -218,6 +428,33 @@ namespace RayEngine
 				RAY_CORE_ERROR("[Application] pending op threw unknown exception");
 			}
 		}
+		m_ExecutingOps.clear();
+
+		// Same safe point for entity structural changes queued by layers, tasks and workers.
+		try
+		{
+			m_World->ApplyPending();
+		}
+		catch (const std::exception& e)
+		{
+			RAY_CORE_ERROR(std::string("[Application] applying deferred entity commands threw: ") + e.what());
+		}
+	}
+
+	void Application::EndFrameAllocations() noexcept
+	{
+		if constexpr (AllocationTracker::IsEnabled())
+		{
+			const FrameAllocationStats frame = AllocationTracker::EndFrame();
+			if (frame.Allocations > m_FrameAllocationBudget)
+			{
+				if (m_FramesOverAllocationBudget++ == 0)
+				{
+					RAY_CORE_WARN("[Application] frame allocated {} time(s) / {} bytes, budget is {} allocation(s)",
+						frame.Allocations, frame.Bytes, m_FrameAllocationBudget);
+				}
+			}
+		}
 	}
 
 	[[nodiscard]] bool Application::IsRunning() const noexcept
@@ -228,5 +465,52 @@ namespace RayEngine
 	void Application::Stop() noexcept
 	{
 		m_IsRunning.store(false);
+		m_WakeEvent.Signal();
+	}
+
+	void Application::RequestFrame() noexcept
+	{
+		m_FrameRequested.store(true, std::memory_order_release);
+		m_WakeEvent.Signal();
+	}
+
+	bool Application::HasWorkPending() noexcept
+	{
+		if (!m_IsRunning.load() || m_FrameRequested.exchange(false, std::memory_order_acq_rel))
+			return true;
+		{
+			std::lock_guard lock(m_PendingMutex);
+			if (!m_PendingOps.empty())
+				return true;
+		}
+		if (m_World->GetPendingCommandCount() > 0)
+			return true;
+		const std::optional<Scheduler::TimePoint> wake = m_Scheduler->GetNextWakeTime();
+		return wake && *wake <= Scheduler::Clock::now();
+	}
+
+	void Application::WaitForWork() noexcept
+	{
+		if (!m_Specification.WakeOnWork || HasWorkPending())
+		{
+			// Frame pacing while there is work (and the classic loop): avoid a busy loop.
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			return;
+		}
+
+		const auto start = WakeEvent::Clock::now();
+		std::optional<WakeEvent::Clock::duration> timeout;
+		if (const std::optional<Scheduler::TimePoint> wake = m_Scheduler->GetNextWakeTime())
+			timeout = *wake - start;
+		// Without completion signals, in-flight reads are only noticed by polling Update().
+		if (m_IOService->HasInFlightWork() && !m_IOService->SignalsCompletions())
+			timeout = std::min<WakeEvent::Clock::duration>(timeout.value_or(std::chrono::milliseconds(1)), std::chrono::milliseconds(1));
+
+		const bool signaled = m_WakeEvent.Wait(timeout);
+		const auto idle = WakeEvent::Clock::now() - start;
+		m_Time.SkipIdle(idle);
+		m_IdleStats.Waits++;
+		m_IdleStats.Signaled += signaled;
+		m_IdleStats.Seconds += std::chrono::duration<double>(idle).count();
 	}
 }
\ No newline at end of file
@@ -5,28 +5,70 @@
 #include <mutex>
 #include <vector>
 #include <functional>
+#include <string>
 
+#include "AllocationTracker.h"
 #include "LayerStack.h"
+#include "Log.h"
+#include "Scheduler.h"
+#include "Task.h"
+#include "ThreadPool.h"
 #include "Time.h"
+#include "Topology.h"
+#include "WakeEvent.h"
+#include "RayEngine/ECS/World.h"
+#include "RayEngine/IO/IOService.h"
 
 namespace RayEngine
 {
+	struct ApplicationSpecification
+	{
+		// Instance name. Non-empty names get instance-scoped loggers ("<Name>" / "<Name>:APP");
+		// the default instance keeps logging through the process-wide loggers.
+		std::string Name;
+		std::size_t WorkerThreads = 0; // ThreadPool size, 0 = hardware_concurrency() - 1
+		IOService::BackendType IOBackend = IOService::BackendType::Auto;
+		AffinityPolicy WorkerAffinity = AffinityPolicy::None; // how ThreadPool workers are pinned
+		// > 0: split the real CPUs into this many fake NUMA nodes instead of reading sysfs, so
+		// multi-node placement can be exercised on single-node machines.
+		std::uint32_t SimulatedNumaNodes = 0;
+		// Block between frames while there is nothing to do instead of polling every millisecond.
+		// Frames then only run when an async layer request, a posted or due coroutine, an I/O
+		// request or completion, RequestFrame() or Stop() wakes the loop; layers that animate
+		// call RequestFrame() from OnUpdate() to keep frames coming.
+		bool WakeOnWork = false;
+	};
+
+	struct ApplicationIdleStats
+	{
+		std::uint64_t Waits = 0;       // times the main loop blocked (WakeOnWork only)
+		std::uint64_t Signaled = 0;    // waits ended by a wake signal rather than a timer
+		double Seconds = 0.0;          // total time spent blocked
+	};
 
 	// Application owns the LayerStack and a Time instance.
 	// Use the async APIs (PushLayerAsync / PushOverlayAsync / RemoveLayerAsync / PopLayerAsync)
 	// to safely request layer mutations from any thread or from inside layer callbacks.
 	// Pending requests are applied on the main thread at the start of each frame via ApplyPending().
+	// Coroutine Tasks spawned with Spawn() are resumed by the Scheduler right after ApplyPending().
+	// With ApplicationSpecification::WakeOnWork the main thread sleeps between frames until there
+	// is work (see Run()), so an idle application costs no CPU.
+	//
+	// Several Applications may exist in one process, each run on its own thread. "Main thread"
+	// below means the thread that calls Run() on that instance. While an instance is running (or
+	// pushing layers synchronously) it is the thread's current application, so GetInstance() and
+	// the RAY_* log macros inside layer code resolve to that instance.
 	class Application final
 	{
-	private:
-		Application();
-
 	public:
-		static Application& GetInstance() noexcept
-		{
-			static Application instance;
-			return instance;
-		}
+		explicit Application(ApplicationSpecification specification = {});
+		~Application();
+
+		// The application current on this thread, or the process-default instance when none is.
+		static Application& GetInstance() noexcept;
+		// The application current on this thread, or nullptr.
+		[[nodiscard]] static Application* GetCurrent() noexcept;
+
 		// Non-copyable and non-movable
 		Application(const Application&) = delete;
 		Application& operator=(const Application&) = delete;
@@ -37,8 +79,18 @@ namespace RayEngine
 		[[nodiscard]] bool Initialize() noexcept;
 		[[nodiscard]] bool Run();
 		[[nodiscard]] bool IsRunning() const noexcept;
+		// Any thread; wakes the main loop if it is idle.
 		void Stop() noexcept;
 
+		// Any thread: run at least one more frame, waking the main loop if it is idle (WakeOnWork).
+		void RequestFrame() noexcept;
+
+		// Frame timing. Time blocked waiting for work is excluded from the delta (Time::GetIdleSeconds()).
+		[[nodiscard]] const Time& GetTime() const noexcept { return m_Time; }
+		[[nodiscard]] const ApplicationIdleStats& GetIdleStats() const noexcept { return m_IdleStats; }
+
+		[[nodiscard]] const ApplicationSpecification& GetSpecification() const noexcept { return m_Specification; }
+
 		// Synchronous layer helpers (direct, main-thread only).
 		// These forward directly to the LayerStack and call OnAttach/OnDetach immediately.
 		void PushLayer(std::unique_ptr<Layer> layer);
@@ -55,22 +107,141 @@ namespace RayEngine
 		using PopCallback = std::function<void(std::unique_ptr<Layer>)>;
 		void PopLayerAsync(Layer* layer, PopCallback cb = nullptr) noexcept;
 
+		// Allocation budget per frame, checked when built with RAY_TRACK_ALLOCATIONS. Only
+		// allocations made on this Application's loop thread count towards it.
+		// Frames above the budget are counted; the first one is logged. Default: unlimited.
+		void SetFrameAllocationBudget(std::uint64_t maxAllocations) noexcept { m_FrameAllocationBudget = maxAllocations; }
+		[[nodiscard]] std::uint64_t GetFramesOverAllocationBudget() const noexcept { return m_FramesOverAllocationBudget; }
+
+		// Coroutine support.
+		// Spawn() hands a root task to the main-thread Scheduler; it first runs on the next frame.
+		void Spawn(Task<> task);
+		[[nodiscard]] Scheduler& GetScheduler() noexcept;
+		[[nodiscard]] ThreadPool& GetThreadPool() noexcept;
+		// CPU / NUMA layout the ThreadPool was placed on (detected or simulated).
+		[[nodiscard]] const CpuTopology& GetTopology() const noexcept { return m_Topology; }
+
+		// Entity-component store. Deferred structural changes are applied on the main thread at the
+		// end of ApplyPending(), after the queued layer operations.
+		[[nodiscard]] World& GetWorld() noexcept;
+
+		// Asynchronous file reads; completion callbacks run on the main thread right after ApplyPending().
+		[[nodiscard]] IOService& GetIOService() noexcept;
+
+		// Awaitable counterparts of the async layer API, for use inside Tasks:
+		//   Layer* child = co_await app.AwaitPushLayer(std::make_unique<MyLayer>());
+		//   std::unique_ptr<Layer> popped = co_await app.AwaitPopLayer(child);
+		// The request is applied at the next ApplyPending() and the task resumes in that same frame.
+		// The awaiting task must stay alive until it resumes (it is owned by the Scheduler).
+		class LayerPushAwaitable
+		{
+		public:
+			LayerPushAwaitable(Application& app, std::unique_ptr<Layer> layer, bool overlay) noexcept
+				: m_App(&app), m_Layer(std::move(layer)), m_Overlay(overlay)
+			{
+			}
+
+			[[nodiscard]] bool await_ready() const noexcept { return !m_Layer; }
+			void await_suspend(std::coroutine_handle<> handle);
+			// Returns the attached layer, or nullptr if OnAttach threw and the push was rolled back.
+			[[nodiscard]] Layer* await_resume() const noexcept { return m_Result; }
+
+		private:
+			Application* m_App;
+			std::unique_ptr<Layer> m_Layer;
+			bool m_Overlay;
+			Layer* m_Result = nullptr;
+		};
+
+		class LayerPopAwaitable
+		{
+		public:
+			LayerPopAwaitable(Application& app, Layer* layer) noexcept
+				: m_App(&app), m_Layer(layer)
+			{
+			}
+
+			[[nodiscard]] bool await_ready() const noexcept { return m_Layer == nullptr; }
+			void await_suspend(std::coroutine_handle<> handle);
+			// Returns ownership of the popped layer, or nullptr if it was not in the stack.
+			[[nodiscard]] std::unique_ptr<Layer> await_resume() noexcept { return std::move(m_Result); }
+
+		private:
+			Application* m_App;
+			Layer* m_Layer;
+			std::unique_ptr<Layer> m_Result;
+		};
+
+		[[nodiscard]] LayerPushAwaitable AwaitPushLayer(std::unique_ptr<Layer> layer) noexcept;
+		[[nodiscard]] LayerPushAwaitable AwaitPushOverlay(std::unique_ptr<Layer> overlay) noexcept;
+		[[nodiscard]] LayerPopAwaitable AwaitPopLayer(Layer* layer) noexcept;
+
 	private:
+		// Makes this instance current on the calling thread (GetInstance() and log routing).
+		class CurrentScope
+		{
+		public:
+			explicit CurrentScope(Application& app) noexcept;
+			~CurrentScope();
+
+			CurrentScope(const CurrentScope&) = delete;
+			CurrentScope& operator=(const CurrentScope&) = delete;
+			CurrentScope(CurrentScope&&) = delete;
+			CurrentScope& operator=(CurrentScope&&) = delete;
+
+		private:
+			Application* m_Previous;
+			Log::Scope m_LogScope;
+		};
+
 		void Shutdown() noexcept;
 
 		// ApplyPending executes all queued requests on the main thread.
 		// It must be called from the main thread (Run() calls it at the top of each frame).
 		void ApplyPending() noexcept;
 
+		// Close the per-frame allocation counters and check them against the budget.
+		void EndFrameAllocations() noexcept;
+
+		// End of frame: sleep 1 ms, or with WakeOnWork and nothing due, block until woken.
+		void WaitForWork() noexcept;
+		[[nodiscard]] bool HasWorkPending() noexcept;
+
 	private:
+		ApplicationSpecification m_Specification;
+		bool m_LogInitialized = false;
+		std::shared_ptr<spdlog::logger> m_CoreLogger;   // null for unnamed instances
+		std::shared_ptr<spdlog::logger> m_ClientLogger;
+
 		Time m_Time;
 		std::atomic_bool m_IsRunning = false;
 
+		// Signaled by everything that gives an idle main loop work; declared before the scheduler
+		// and I/O service that hold pointers to it.
+		WakeEvent m_WakeEvent;
+		std::atomic_bool m_FrameRequested = false;
+		ApplicationIdleStats m_IdleStats;
+
 		// Owned layer stack
 		std::unique_ptr<LayerStack> m_LayerStack;
 
+		// Background workers (RunInBackground) and the main-thread coroutine scheduler.
+		CpuTopology m_Topology;
+		std::unique_ptr<ThreadPool> m_ThreadPool;
+		std::unique_ptr<Scheduler> m_Scheduler;
+
+		std::unique_ptr<World> m_World;
+
+		// Async file I/O; updated at the same safe point as ApplyPending().
+		std::unique_ptr<IOService> m_IOService;
+
 		// Pending operations (thread-safe queue of lambdas). Lambdas execute on main thread.
 		mutable std::mutex m_PendingMutex;
 		std::vector<std::function<void()>> m_PendingOps;
+		// Swapped with m_PendingOps by ApplyPending() so neither vector loses its capacity.
+		std::vector<std::function<void()>> m_ExecutingOps;
+
+		std::uint64_t m_FrameAllocationBudget = UINT64_MAX;
+		std::uint64_t m_FramesOverAllocationBudget = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "FramePool.h"
+
+#include <new>
+
+namespace RayEngine
+{
+	void* FramePool::Allocate(std::size_t size)
+	{
+		if (size == 0 || size > maxPooledSize)
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stats.FallbackAllocations++;
+			return ::operator new(size);
+		}
+
+		const std::size_t index = ClassIndex(size);
+		std::lock_guard lock(m_Mutex);
+		m_Stats.PooledAllocations++;
+		m_Stats.LiveFrames++;
+
+		if (FreeNode* node = m_FreeLists[index])
+		{
+			m_FreeLists[index] = node->Next;
+			return node;
+		}
+		return Carve(index);
+	}
+
+	void FramePool::Deallocate(void* ptr, std::size_t size) noexcept
+	{
+		if (!ptr)
+			return;
+
+		if (size == 0 || size > maxPooledSize)
+		{
+			::operator delete(ptr, size);
+			return;
+		}
+
+		const std::size_t index = ClassIndex(size);
+		std::lock_guard lock(m_Mutex);
+		auto* node = static_cast<FreeNode*>(ptr);
+		node->Next = m_FreeLists[index];
+		m_FreeLists[index] = node;
+		m_Stats.LiveFrames--;
+	}
+
+	void FramePool::Reserve(std::size_t size, std::size_t count)
+	{
+		if (size == 0 || size > maxPooledSize)
+			return;
+
+		const std::size_t index = ClassIndex(size);
+		std::lock_guard lock(m_Mutex);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto* node = static_cast<FreeNode*>(Carve(index));
+			node->Next = m_FreeLists[index];
+			m_FreeLists[index] = node;
+		}
+	}
+
+	FramePool::Stats FramePool::GetStats() const noexcept
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Stats;
+	}
+
+	// Caller holds m_Mutex. Only touches the heap when the current arena is exhausted.
+	void* FramePool::Carve(std::size_t classIndex)
+	{
+		const std::size_t blockSize = (classIndex + 1) * granularity;
+		if (m_ArenaRemaining < blockSize)
+		{
+			m_Arenas.emplace_back(std::make_unique<std::byte[]>(arenaSize));
+			m_ArenaCursor = m_Arenas.back().get();
+			m_ArenaRemaining = arenaSize;
+			m_Stats.ArenaBytes += arenaSize;
+		}
+
+		void* block = m_ArenaCursor;
+		m_ArenaCursor += blockSize;
+		m_ArenaRemaining -= blockSize;
+		return block;
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RayEngine
+{
+	// Size-class pool for coroutine frames.
+	// Frames are rounded up to a multiple of `granularity` and recycled through per-class free lists,
+	// so spawning and resuming tasks in steady state never reaches the global heap.
+	// Frames larger than `maxPooledSize` fall back to ::operator new.
+	class FramePool
+	{
+	public:
+		static constexpr std::size_t granularity = 64;
+		static constexpr std::size_t maxPooledSize = 4096;
+		static constexpr std::size_t arenaSize = 64 * 1024;
+
+		struct Stats
+		{
+			std::uint64_t PooledAllocations = 0;
+			std::uint64_t FallbackAllocations = 0;
+			std::size_t LiveFrames = 0;
+			std::size_t ArenaBytes = 0;
+		};
+
+		static FramePool& Get() noexcept
+		{
+			static FramePool instance;
+			return instance;
+		}
+
+		FramePool(const FramePool&) = delete;
+		FramePool& operator=(const FramePool&) = delete;
+		FramePool(FramePool&&) = delete;
+		FramePool& operator=(FramePool&&) = delete;
+
+		[[nodiscard]] void* Allocate(std::size_t size);
+		void Deallocate(void* ptr, std::size_t size) noexcept;
+
+		// Pre-carve `count` blocks able to hold frames of `size` bytes (e.g. before a benchmark).
+		void Reserve(std::size_t size, std::size_t count);
+
+		[[nodiscard]] Stats GetStats() const noexcept;
+
+	private:
+		FramePool() = default;
+
+		struct FreeNode
+		{
+			FreeNode* Next;
+		};
+
+		static constexpr std::size_t classCount = maxPooledSize / granularity;
+
+		[[nodiscard]] static std::size_t ClassIndex(std::size_t size) noexcept { return (size + granularity - 1) / granularity - 1; }
+		[[nodiscard]] void* Carve(std::size_t classIndex);
+
+	private:
+		mutable std::mutex m_Mutex;
+		std::array<FreeNode*, classCount> m_FreeLists{};
+		std::vector<std::unique_ptr<std::byte[]>> m_Arenas;
+		std::byte* m_ArenaCursor = nullptr;
+		std::size_t m_ArenaRemaining = 0;
+		Stats m_Stats;
+	};
+}
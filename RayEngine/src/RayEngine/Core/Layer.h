@@ -11,7 +11,7 @@ namespace RayEngine
 	class Layer
 	{
 	public:
-		Layer(const std::string name = "Layer")
+		Layer(std::string name = "Layer")
 			: m_Name(std::move(name))
 		{
 		}
@@ -4,11 +4,22 @@ namespace RayEngine {
 
     std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
     std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
+    thread_local std::shared_ptr<spdlog::logger>* Log::t_CoreLogger = nullptr;
+    thread_local std::shared_ptr<spdlog::logger>* Log::t_ClientLogger = nullptr;
+
+    std::mutex Log::s_InitMutex;
+    int Log::s_InitCount = 0;
+    std::string Log::s_InstancePattern;
+
+    void Log::Init(const char* pattern, const char* instancePattern) {
+        std::lock_guard lock(s_InitMutex);
+        if (s_InitCount++ > 0)
+            return; // already initialized by another engine instance
 
-    void Log::Init(const char* pattern) {
         try {
 			// Set log pattern
             spdlog::set_pattern(pattern);
+            s_InstancePattern = instancePattern;
 
             // Core logger (engine)
             s_CoreLogger = spdlog::stdout_color_mt("RAYENGINE");
@@ -35,8 +46,42 @@ namespace RayEngine {
         }
     }
 
+    void Log::ShutDown() noexcept {
+        std::lock_guard lock(s_InitMutex);
+        if (s_InitCount == 0 || --s_InitCount > 0)
+            return; // other engine instances still log
+        spdlog::shutdown();
+    }
+
+    std::shared_ptr<spdlog::logger>& Log::GetCoreLogger() { return t_CoreLogger ? *t_CoreLogger : s_CoreLogger; }
+    std::shared_ptr<spdlog::logger>& Log::GetClientLogger() { return t_ClientLogger ? *t_ClientLogger : s_ClientLogger; }
+
+    std::shared_ptr<spdlog::logger> Log::CreateInstanceLogger(const std::string& name) {
+        std::lock_guard lock(s_InitMutex);
+        if (!s_CoreLogger)
+            return nullptr;
+
+        // Same sinks as the process-wide logger so output stays ordered on one console.
+        auto logger = std::make_shared<spdlog::logger>(name, s_CoreLogger->sinks().begin(), s_CoreLogger->sinks().end());
+        logger->set_pattern(s_InstancePattern);
+        logger->set_level(s_CoreLogger->level());
+        logger->flush_on(spdlog::level::err);
+        return logger;
+    }
+
+    Log::Scope::Scope(std::shared_ptr<spdlog::logger>* core, std::shared_ptr<spdlog::logger>* client) noexcept
+        : m_PreviousCore(t_CoreLogger)
+        , m_PreviousClient(t_ClientLogger)
+    {
+        if (core && *core)
+            t_CoreLogger = core;
+        if (client && *client)
+            t_ClientLogger = client;
+    }
 
-    std::shared_ptr<spdlog::logger>& Log::GetCoreLogger() { return s_CoreLogger; }
-    std::shared_ptr<spdlog::logger>& Log::GetClientLogger() { return s_ClientLogger; }
+    Log::Scope::~Scope() {
+        t_CoreLogger = m_PreviousCore;
+        t_ClientLogger = m_PreviousClient;
+    }
 
 } 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <string>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -8,14 +10,46 @@ namespace RayEngine {
 
     class Log {
     public:
-        static void Init(const char* pattern = "[%T] [%^%l%$] %v");
-        static void ShutDown() noexcept { spdlog::shutdown(); }
+        // Reference counted: every Init() must be paired with a ShutDown(); spdlog is shut down
+        // when the last engine instance releases it.
+        static void Init(const char* pattern = "[%T] [%^%l%$] %v", const char* instancePattern = "[%T] [%n] [%^%l%$] %v");
+        static void ShutDown() noexcept;
+
+        // Logger for the calling thread: the instance logger installed by a Log::Scope, or the
+        // process-wide logger when no scope is active.
         [[nodiscard]] static std::shared_ptr<spdlog::logger>& GetCoreLogger();
         [[nodiscard]] static std::shared_ptr<spdlog::logger>& GetClientLogger();
 
+        // Create an unregistered logger that shares the process-wide sinks (used per Application).
+        [[nodiscard]] static std::shared_ptr<spdlog::logger> CreateInstanceLogger(const std::string& name);
+
+        // Routes RAY_CORE_* / RAY_CLIENT_* on this thread to the given loggers until destroyed.
+        // Null loggers leave the corresponding route unchanged.
+        class Scope
+        {
+        public:
+            Scope(std::shared_ptr<spdlog::logger>* core, std::shared_ptr<spdlog::logger>* client) noexcept;
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope&&) = delete;
+
+        private:
+            std::shared_ptr<spdlog::logger>* m_PreviousCore;
+            std::shared_ptr<spdlog::logger>* m_PreviousClient;
+        };
+
     private:
         static std::shared_ptr<spdlog::logger> s_CoreLogger;
         static std::shared_ptr<spdlog::logger> s_ClientLogger;
+        static thread_local std::shared_ptr<spdlog::logger>* t_CoreLogger;
+        static thread_local std::shared_ptr<spdlog::logger>* t_ClientLogger;
+
+        static std::mutex s_InitMutex;
+        static int s_InitCount;
+        static std::string s_InstancePattern;
     };
 
     // macros
@@ -31,4 +65,4 @@ namespace RayEngine {
 #define RAY_CLIENT_ERROR(...)    ::RayEngine::Log::GetClientLogger()->error(__VA_ARGS__)
 #define RAY_CLIENT_CRITICAL(...) ::RayEngine::Log::GetClientLogger()->critical(__VA_ARGS__)
 
-}
\ No newline at end of file
+}
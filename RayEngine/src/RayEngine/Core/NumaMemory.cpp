@@ -0,0 +1,121 @@
+#include "NumaMemory.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <cstdlib>
+#endif
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::size_t pageSize = 4096;
+
+#ifdef __linux__
+		// From <numaif.h>; spelled out to avoid a libnuma dependency.
+		constexpr unsigned long mpolFlagNode = 1ul << 0;
+		constexpr unsigned long mpolFlagAddress = 1ul << 1;
+#endif
+	}
+
+	FirstTouchBuffer::FirstTouchBuffer(std::size_t bytes)
+	{
+		if (bytes == 0)
+			return;
+		const std::size_t size = (bytes + pageSize - 1) & ~(pageSize - 1);
+#ifdef __linux__
+		void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED)
+			throw std::bad_alloc();
+#else
+		void* memory = std::aligned_alloc(pageSize, size);
+		if (!memory)
+			throw std::bad_alloc();
+#endif
+		m_Data = static_cast<std::byte*>(memory);
+		m_Size = bytes;
+	}
+
+	FirstTouchBuffer::~FirstTouchBuffer()
+	{
+		if (!m_Data)
+			return;
+#ifdef __linux__
+		::munmap(m_Data, (m_Size + pageSize - 1) & ~(pageSize - 1));
+#else
+		std::free(m_Data);
+#endif
+	}
+
+	FirstTouchBuffer::FirstTouchBuffer(FirstTouchBuffer&& other) noexcept
+		: m_Data(std::exchange(other.m_Data, nullptr))
+		, m_Size(std::exchange(other.m_Size, 0))
+	{
+	}
+
+	FirstTouchBuffer& FirstTouchBuffer::operator=(FirstTouchBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			FirstTouchBuffer old(std::move(*this));
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+		}
+		return *this;
+	}
+
+	void FirstTouchBuffer::Touch() noexcept
+	{
+		for (std::size_t offset = 0; offset < m_Size; offset += pageSize)
+			m_Data[offset] = std::byte{ 0 };
+	}
+
+	std::uint32_t QueryMemoryNode(const void* address) noexcept
+	{
+#ifdef __linux__
+		int node = -1;
+		if (::syscall(SYS_get_mempolicy, &node, nullptr, 0ul, const_cast<void*>(address), mpolFlagNode | mpolFlagAddress) == 0 && node >= 0)
+			return static_cast<std::uint32_t>(node);
+#else
+		(void)address;
+#endif
+		return CpuTopology::unknownNode;
+	}
+
+	WorkerBufferSet::WorkerBufferSet(ThreadPool& pool, std::size_t bufferCount, std::size_t bytesEach)
+		: m_WorkerCount(std::max<std::size_t>(1, pool.GetWorkerCount()))
+	{
+		m_Buffers.reserve(bufferCount);
+		m_IntendedNodes.reserve(bufferCount);
+		for (std::size_t i = 0; i < bufferCount; ++i)
+		{
+			m_Buffers.emplace_back(bytesEach);
+			m_IntendedNodes.push_back(pool.GetWorkerNode(GetOwner(i)));
+		}
+
+		pool.RunOnEachWorker([this](std::size_t worker) {
+			for (std::size_t i = worker; i < m_Buffers.size(); i += m_WorkerCount)
+				m_Buffers[i].Touch();
+		});
+	}
+
+	std::vector<std::size_t> WorkerBufferSet::GetBytesPerNode(std::size_t nodeCount) const
+	{
+		std::vector<std::size_t> bytes(nodeCount + 1, 0);
+		for (const FirstTouchBuffer& buffer : m_Buffers)
+		{
+			const std::uint32_t node = QueryMemoryNode(buffer.GetData());
+			bytes[node < nodeCount ? node : nodeCount] += buffer.GetSize();
+		}
+		return bytes;
+	}
+}
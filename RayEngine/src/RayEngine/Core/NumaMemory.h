@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Topology.h"
+
+namespace RayEngine
+{
+	class ThreadPool;
+
+	// Page-aligned anonymous memory whose pages are not touched on allocation, so on Linux each
+	// page lands on the NUMA node of the thread that first writes it ("first touch").
+	class FirstTouchBuffer
+	{
+	public:
+		FirstTouchBuffer() = default;
+		explicit FirstTouchBuffer(std::size_t bytes);
+		~FirstTouchBuffer();
+
+		FirstTouchBuffer(const FirstTouchBuffer&) = delete;
+		FirstTouchBuffer& operator=(const FirstTouchBuffer&) = delete;
+		FirstTouchBuffer(FirstTouchBuffer&& other) noexcept;
+		FirstTouchBuffer& operator=(FirstTouchBuffer&& other) noexcept;
+
+		[[nodiscard]] std::byte* GetData() const noexcept { return m_Data; }
+		[[nodiscard]] std::size_t GetSize() const noexcept { return m_Size; }
+		[[nodiscard]] std::span<std::byte> GetBytes() const noexcept { return { m_Data, m_Size }; }
+		[[nodiscard]] explicit operator bool() const noexcept { return m_Data != nullptr; }
+
+		// Write every page once from the calling thread.
+		void Touch() noexcept;
+
+	private:
+		std::byte* m_Data = nullptr;
+		std::size_t m_Size = 0;
+	};
+
+	// Physical NUMA node backing the page at `address`, or CpuTopology::unknownNode if the page is
+	// not resident or the kernel cannot tell (non-Linux, no NUMA support).
+	[[nodiscard]] std::uint32_t QueryMemoryNode(const void* address) noexcept;
+
+	// A set of equally sized buffers, each first-touched by the pool worker that owns it: buffer i
+	// belongs to worker i % workerCount. One buffer per worker gives per-worker scratch memory;
+	// one per tile gives per-tile accumulation memory, as long as the tile is processed by its owner
+	// (see GetOwner()). The pages then live on the owner's node, or with the NodeLocal / Compact /
+	// Scatter policies on the node the owner is pinned to.
+	class WorkerBufferSet
+	{
+	public:
+		WorkerBufferSet() = default;
+		WorkerBufferSet(ThreadPool& pool, std::size_t bufferCount, std::size_t bytesEach);
+
+		[[nodiscard]] std::size_t GetCount() const noexcept { return m_Buffers.size(); }
+		[[nodiscard]] std::span<std::byte> Get(std::size_t index) const noexcept { return m_Buffers[index].GetBytes(); }
+		[[nodiscard]] std::size_t GetOwner(std::size_t index) const noexcept { return index % m_WorkerCount; }
+		// Node the owner worker was placed on (the intended home node of the buffer).
+		[[nodiscard]] std::uint32_t GetIntendedNode(std::size_t index) const noexcept { return m_IntendedNodes[index]; }
+
+		// Resident bytes per physical node, sampling the first page of every buffer; the last entry
+		// counts buffers whose node is unknown. Only meaningful on real multi-node machines.
+		[[nodiscard]] std::vector<std::size_t> GetBytesPerNode(std::size_t nodeCount) const;
+
+	private:
+		std::vector<FirstTouchBuffer> m_Buffers;
+		std::vector<std::uint32_t> m_IntendedNodes;
+		std::size_t m_WorkerCount = 1;
+	};
+}
@@ -0,0 +1,82 @@
+#include "ParallelFor.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace RayEngine
+{
+	namespace
+	{
+		struct ParallelForState
+		{
+			const std::function<void(std::size_t)>* Fn = nullptr;
+			std::size_t Count = 0;
+			std::atomic<std::size_t> Next{ 0 };
+			std::atomic<std::size_t> Remaining{ 0 };
+
+			std::mutex Mutex;
+			std::condition_variable Done;
+			std::exception_ptr Exception;
+
+			// Claim and run indices until none are left. Fn is only touched for claimed indices,
+			// which the caller is still waiting on, so late helpers never see a dangling function.
+			void Work() noexcept
+			{
+				for (;;)
+				{
+					const std::size_t index = Next.fetch_add(1, std::memory_order_relaxed);
+					if (index >= Count)
+						return;
+
+					try
+					{
+						(*Fn)(index);
+					}
+					catch (...)
+					{
+						std::lock_guard lock(Mutex);
+						if (!Exception)
+							Exception = std::current_exception();
+					}
+
+					if (Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						std::lock_guard lock(Mutex);
+						Done.notify_all();
+					}
+				}
+			}
+		};
+	}
+
+	void ParallelFor(ThreadPool* pool, std::size_t count, const std::function<void(std::size_t)>& fn)
+	{
+		if (count == 0)
+			return;
+
+		auto state = std::make_shared<ParallelForState>();
+		state->Fn = &fn;
+		state->Count = count;
+		state->Remaining.store(count, std::memory_order_relaxed);
+
+		const std::size_t helpers = pool ? std::min(pool->GetWorkerCount(), count - 1) : 0;
+		for (std::size_t i = 0; i < helpers; ++i)
+		{
+			if (!pool->Submit([state]() { state->Work(); }))
+				break;
+		}
+
+		state->Work();
+		{
+			std::unique_lock lock(state->Mutex);
+			state->Done.wait(lock, [&]() { return state->Remaining.load(std::memory_order_acquire) == 0; });
+		}
+		if (state->Exception)
+			std::rethrow_exception(state->Exception);
+	}
+}
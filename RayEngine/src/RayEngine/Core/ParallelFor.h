@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace RayEngine
+{
+	class ThreadPool;
+
+	// Run fn(i) for every i in [0, count) and return when all have finished.
+	// Indices are handed out dynamically to the pool's workers and to the calling thread, which
+	// always takes part, so this also works (serially) with a null or busy pool. The first
+	// exception thrown by fn is rethrown on the calling thread once the loop has drained.
+	void ParallelFor(ThreadPool* pool, std::size_t count, const std::function<void(std::size_t)>& fn);
+}
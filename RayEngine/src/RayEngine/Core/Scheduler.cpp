@@ -0,0 +1,179 @@
+#include "Scheduler.h"
+#include "Log.h"
+#include "WakeEvent.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace RayEngine
+{
+	namespace Detail
+	{
+		void NotifyRootFinished(Scheduler* scheduler, std::size_t rootIndex) noexcept
+		{
+			if (!scheduler)
+				return;
+			try
+			{
+				scheduler->m_Finished.push_back(rootIndex);
+			}
+			catch (...)
+			{
+				// Out of memory: the frame is reclaimed by Clear() at shutdown instead.
+			}
+		}
+	}
+
+	Scheduler::~Scheduler()
+	{
+		Clear();
+	}
+
+	void Scheduler::Spawn(Task<> task)
+	{
+		if (!task.IsValid() || task.IsDone())
+			return;
+
+		auto handle = task.Release();
+		auto& promise = handle.promise();
+		promise.m_Scheduler = this;
+		promise.m_RootIndex = m_Roots.size();
+		m_Roots.push_back(handle);
+		m_Ready.push_back(handle);
+	}
+
+	void Scheduler::Schedule(std::coroutine_handle<> handle)
+	{
+		if (handle)
+			m_Ready.push_back(handle);
+	}
+
+	void Scheduler::ScheduleAt(std::coroutine_handle<> handle, TimePoint when)
+	{
+		if (!handle)
+			return;
+		m_Timers.push_back(Timer{ when, handle });
+		std::push_heap(m_Timers.begin(), m_Timers.end());
+	}
+
+	void Scheduler::Post(std::coroutine_handle<> handle)
+	{
+		if (!handle)
+			return;
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			m_Incoming.push_back(handle);
+		}
+		if (m_WakeEvent)
+			m_WakeEvent->Signal();
+	}
+
+	void Scheduler::Tick(TimePoint now) noexcept
+	{
+		const auto start = Clock::now();
+
+		// Gather this frame's work. Anything scheduled while resuming lands in m_Ready for next frame.
+		m_Resuming.swap(m_Ready);
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			m_Resuming.insert(m_Resuming.end(), m_Incoming.begin(), m_Incoming.end());
+			m_Incoming.clear();
+		}
+		while (!m_Timers.empty() && m_Timers.front().When <= now)
+		{
+			std::pop_heap(m_Timers.begin(), m_Timers.end());
+			m_Resuming.push_back(m_Timers.back().Handle);
+			m_Timers.pop_back();
+		}
+
+		// Task bodies catch into their promise, so resume() itself does not throw.
+		for (auto handle : m_Resuming)
+			handle.resume();
+
+		const std::size_t resumed = m_Resuming.size();
+		m_Resuming.clear();
+		DestroyFinished();
+
+		m_Stats.Frames++;
+		m_Stats.Resumed += resumed;
+		m_Stats.LastFrameResumed = resumed;
+		m_Stats.LiveTasks = m_Roots.size();
+		m_Stats.TickNanoseconds += static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+	}
+
+	std::optional<Scheduler::TimePoint> Scheduler::GetNextWakeTime() const
+	{
+		if (!m_Ready.empty())
+			return TimePoint::min();
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			if (!m_Incoming.empty())
+				return TimePoint::min();
+		}
+		if (!m_Timers.empty())
+			return m_Timers.front().When;
+		return std::nullopt;
+	}
+
+	void Scheduler::Clear() noexcept
+	{
+		m_Ready.clear();
+		m_Resuming.clear();
+		m_Timers.clear();
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			m_Incoming.clear();
+		}
+
+		// Destroying a root destroys the child Task objects living in its frame as well.
+		for (auto root : m_Roots)
+			root.destroy();
+		m_Roots.clear();
+		m_Finished.clear();
+		m_Stats.LiveTasks = 0;
+	}
+
+	void Scheduler::ResetStats() noexcept
+	{
+		m_Stats = SchedulerStats{};
+		m_Stats.LiveTasks = m_Roots.size();
+	}
+
+	void Scheduler::DestroyFinished() noexcept
+	{
+		if (m_Finished.empty())
+			return;
+
+		// Highest index first so swap-and-pop never moves a root that is still waiting to be removed.
+		std::sort(m_Finished.begin(), m_Finished.end(), std::greater<>());
+		for (std::size_t index : m_Finished)
+		{
+			auto root = m_Roots[index];
+			if (const auto& exception = root.promise().GetException())
+			{
+				try
+				{
+					std::rethrow_exception(exception);
+				}
+				catch (const std::exception& e)
+				{
+					RAY_CORE_ERROR(std::string("[Scheduler] Task threw: ") + e.what());
+				}
+				catch (...)
+				{
+					RAY_CORE_ERROR("[Scheduler] Task threw unknown exception");
+				}
+			}
+
+			if (index != m_Roots.size() - 1)
+			{
+				m_Roots[index] = m_Roots.back();
+				m_Roots[index].promise().m_RootIndex = index;
+			}
+			m_Roots.pop_back();
+			root.destroy();
+		}
+		m_Finished.clear();
+	}
+}
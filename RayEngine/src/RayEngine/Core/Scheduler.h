@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Task.h"
+#include "ThreadPool.h"
+#include "Time.h"
+
+namespace RayEngine
+{
+	class WakeEvent;
+
+	struct SchedulerStats
+	{
+		std::uint64_t Frames = 0;
+		std::uint64_t Resumed = 0;          // total coroutine resumptions
+		std::uint64_t TickNanoseconds = 0;  // total time spent inside Tick(), coroutine bodies included
+		std::size_t LastFrameResumed = 0;
+		std::size_t LiveTasks = 0;
+
+		[[nodiscard]] double AverageNanosecondsPerResume() const noexcept
+		{
+			return Resumed ? static_cast<double>(TickNanoseconds) / static_cast<double>(Resumed) : 0.0;
+		}
+	};
+
+	// Resumes coroutine Tasks on the main thread.
+	// - Spawn() takes ownership of a root task; it first runs at the next Tick().
+	// - Schedule() / ScheduleAt() are main-thread only; Post() may be called from any thread.
+	// - Tick() is called once per frame from Application::Run() right after ApplyPending(),
+	//   so tasks waiting on layer push/pop resume in the same frame the mutation is applied.
+	// - Coroutines scheduled while Tick() is resuming run on the following frame.
+	// Queues keep their capacity between frames so steady-state scheduling does not allocate.
+	class Scheduler
+	{
+	public:
+		using Clock = Time::Clock;
+		using TimePoint = Time::TimePoint;
+
+		Scheduler() = default;
+		~Scheduler();
+
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator=(const Scheduler&) = delete;
+		Scheduler(Scheduler&&) = delete;
+		Scheduler& operator=(Scheduler&&) = delete;
+
+		// Take ownership of a root task and start it on the next Tick().
+		void Spawn(Task<> task);
+
+		// Main thread: resume `handle` on the next Tick().
+		void Schedule(std::coroutine_handle<> handle);
+		// Main thread: resume `handle` on the first Tick() at or after `when`.
+		void ScheduleAt(std::coroutine_handle<> handle, TimePoint when);
+		// Any thread: resume `handle` on the next Tick().
+		void Post(std::coroutine_handle<> handle);
+
+		// Resume everything that is due. Main thread only.
+		void Tick(TimePoint now = Clock::now()) noexcept;
+
+		// Main thread: when the next Tick() has something to resume. TimePoint::min() if work is
+		// already queued, the earliest timer otherwise, nullopt if there is nothing at all.
+		[[nodiscard]] std::optional<TimePoint> GetNextWakeTime() const;
+
+		// Destroy all root tasks (and, transitively, the children they are awaiting).
+		void Clear() noexcept;
+
+		// Optional pool used by RunInBackground(); when null, background work runs inline.
+		void SetThreadPool(ThreadPool* pool) noexcept { m_ThreadPool = pool; }
+		[[nodiscard]] ThreadPool* GetThreadPool() const noexcept { return m_ThreadPool; }
+		// Optional event signaled by Post(), so an idle main thread wakes for posted work.
+		// Set before other threads may post; the event must outlive the scheduler's use of it.
+		void SetWakeEvent(WakeEvent* event) noexcept { m_WakeEvent = event; }
+
+		[[nodiscard]] const SchedulerStats& GetStats() const noexcept { return m_Stats; }
+		void ResetStats() noexcept;
+		[[nodiscard]] std::size_t GetLiveTaskCount() const noexcept { return m_Roots.size(); }
+
+	private:
+		friend void Detail::NotifyRootFinished(Scheduler* scheduler, std::size_t rootIndex) noexcept;
+
+		struct Timer
+		{
+			TimePoint When;
+			std::coroutine_handle<> Handle;
+
+			// min-heap ordering for std::push_heap / std::pop_heap
+			[[nodiscard]] bool operator<(const Timer& other) const noexcept { return When > other.When; }
+		};
+
+		void DestroyFinished() noexcept;
+
+	private:
+		std::vector<Task<>::Handle> m_Roots;
+		std::vector<std::size_t> m_Finished;
+
+		std::vector<std::coroutine_handle<>> m_Ready;    // filled by Schedule()
+		std::vector<std::coroutine_handle<>> m_Resuming; // drained by Tick()
+		std::vector<Timer> m_Timers;                     // heap ordered by When
+
+		mutable std::mutex m_IncomingMutex;
+		std::vector<std::coroutine_handle<>> m_Incoming; // filled by Post()
+
+		ThreadPool* m_ThreadPool = nullptr;
+		WakeEvent* m_WakeEvent = nullptr;
+		SchedulerStats m_Stats;
+	};
+
+	// --- awaitables ---
+
+	// co_await NextFrame(); resumes on the next frame.
+	struct NextFrameAwaitable
+	{
+		[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+		template<typename Promise>
+		void await_suspend(std::coroutine_handle<Promise> handle) const
+		{
+			Scheduler* scheduler = handle.promise().GetScheduler();
+			assert(scheduler && "Task must be spawned on a Scheduler to await NextFrame()");
+			scheduler->Schedule(handle);
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	[[nodiscard]] inline NextFrameAwaitable NextFrame() noexcept { return {}; }
+
+	// co_await Delay(seconds); resumes on the first frame after the delay has elapsed.
+	class DelayAwaitable
+	{
+	public:
+		explicit DelayAwaitable(double seconds) noexcept
+			: m_Seconds(seconds)
+		{
+		}
+
+		[[nodiscard]] bool await_ready() const noexcept { return m_Seconds <= 0.0; }
+
+		template<typename Promise>
+		void await_suspend(std::coroutine_handle<Promise> handle) const
+		{
+			Scheduler* scheduler = handle.promise().GetScheduler();
+			assert(scheduler && "Task must be spawned on a Scheduler to await Delay()");
+			const auto delay = std::chrono::duration_cast<Scheduler::Clock::duration>(std::chrono::duration<double>(m_Seconds));
+			scheduler->ScheduleAt(handle, Scheduler::Clock::now() + delay);
+		}
+
+		void await_resume() const noexcept {}
+
+	private:
+		double m_Seconds;
+	};
+
+	[[nodiscard]] inline DelayAwaitable Delay(double seconds) noexcept { return DelayAwaitable(seconds); }
+
+	// co_await RunInBackground(fn); runs `fn` on the scheduler's ThreadPool and resumes on the
+	// main thread with its result. Exceptions thrown by `fn` are rethrown in the awaiting task.
+	template<typename F>
+	class BackgroundAwaitable
+	{
+	public:
+		using Result = std::invoke_result_t<F&>;
+
+		explicit BackgroundAwaitable(F fn)
+			: m_Fn(std::move(fn))
+		{
+		}
+
+		[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+		template<typename Promise>
+		bool await_suspend(std::coroutine_handle<Promise> handle)
+		{
+			Scheduler* scheduler = handle.promise().GetScheduler();
+			ThreadPool* pool = scheduler ? scheduler->GetThreadPool() : nullptr;
+			// The awaitable lives in the suspended frame, so capturing `this` is safe until resume.
+			if (pool && pool->Submit([this, scheduler, handle]() { Execute(); scheduler->Post(handle); }))
+				return true;
+
+			Execute(); // no pool (or pool shutting down): run inline and do not suspend
+			return false;
+		}
+
+		Result await_resume()
+		{
+			if (m_Exception)
+				std::rethrow_exception(m_Exception);
+			if constexpr (!std::is_void_v<Result>)
+				return std::move(*m_Result);
+		}
+
+	private:
+		void Execute() noexcept
+		{
+			try
+			{
+				if constexpr (std::is_void_v<Result>)
+					m_Fn();
+				else
+					m_Result.emplace(m_Fn());
+			}
+			catch (...)
+			{
+				m_Exception = std::current_exception();
+			}
+		}
+
+		struct Empty {};
+
+		F m_Fn;
+		std::conditional_t<std::is_void_v<Result>, Empty, std::optional<Result>> m_Result;
+		std::exception_ptr m_Exception;
+	};
+
+	template<typename F>
+	[[nodiscard]] BackgroundAwaitable<std::decay_t<F>> RunInBackground(F&& fn)
+	{
+		return BackgroundAwaitable<std::decay_t<F>>(std::forward<F>(fn));
+	}
+}
@@ -0,0 +1,34 @@
+#include "SharedAssets.h"
+
+namespace RayEngine
+{
+	void SharedAssets::Release(std::string_view key)
+	{
+		std::lock_guard lock(GetMutex());
+		GetEntries().erase(std::string(key));
+	}
+
+	void SharedAssets::Clear()
+	{
+		std::lock_guard lock(GetMutex());
+		GetEntries().clear();
+	}
+
+	std::size_t SharedAssets::GetCount()
+	{
+		std::lock_guard lock(GetMutex());
+		return GetEntries().size();
+	}
+
+	std::mutex& SharedAssets::GetMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	std::unordered_map<std::string, SharedAssets::Entry>& SharedAssets::GetEntries()
+	{
+		static std::unordered_map<std::string, Entry> entries;
+		return entries;
+	}
+}
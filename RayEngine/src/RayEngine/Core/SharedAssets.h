@@ -0,0 +1,81 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace RayEngine
+{
+	// Process-wide cache of immutable assets shared by every Application instance in the process.
+	// Assets are handed out as std::shared_ptr<const T>, so instances running on different threads
+	// can read them concurrently without copies. Each key is loaded exactly once: concurrent
+	// requests for a key that is still loading wait for the first loader instead of loading again.
+	class SharedAssets
+	{
+	public:
+		SharedAssets() = delete;
+
+		// Return the asset stored under `key`, calling `loader()` (returning std::shared_ptr<T> or
+		// std::shared_ptr<const T>) on first use. Returns nullptr if the key holds a different type
+		// or the loader threw.
+		template<typename T, typename Loader>
+		[[nodiscard]] static std::shared_ptr<const T> GetOrLoad(std::string_view key, Loader&& loader)
+		{
+			std::promise<std::shared_ptr<const void>> promise;
+			std::shared_future<std::shared_ptr<const void>> future;
+			bool isLoader = false;
+			{
+				std::lock_guard lock(GetMutex());
+				auto& entries = GetEntries();
+				auto it = entries.find(std::string(key));
+				if (it == entries.end())
+				{
+					future = promise.get_future().share();
+					entries.emplace(std::string(key), Entry{ std::type_index(typeid(T)), future });
+					isLoader = true;
+				}
+				else
+				{
+					if (it->second.Type != std::type_index(typeid(T)))
+						return nullptr;
+					future = it->second.Asset;
+				}
+			}
+
+			if (isLoader)
+			{
+				try
+				{
+					std::shared_ptr<const T> asset = loader();
+					promise.set_value(std::static_pointer_cast<const void>(asset));
+				}
+				catch (...)
+				{
+					promise.set_value(nullptr);
+					Release(key); // allow a later retry
+				}
+			}
+			return std::static_pointer_cast<const T>(future.get());
+		}
+
+		// Drop the cache's reference; instances that still hold the asset keep it alive.
+		static void Release(std::string_view key);
+		static void Clear();
+		[[nodiscard]] static std::size_t GetCount();
+
+	private:
+		struct Entry
+		{
+			std::type_index Type;
+			std::shared_future<std::shared_ptr<const void>> Asset;
+		};
+
+		static std::mutex& GetMutex();
+		static std::unordered_map<std::string, Entry>& GetEntries();
+	};
+}
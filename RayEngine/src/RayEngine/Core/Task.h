@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "FramePool.h"
+
+namespace RayEngine
+{
+	class Scheduler;
+	template<typename T = void> class Task;
+
+	namespace Detail
+	{
+		inline constexpr std::size_t noRoot = std::numeric_limits<std::size_t>::max();
+
+		// Called when a root task (spawned on a Scheduler) reaches its final suspend point.
+		void NotifyRootFinished(Scheduler* scheduler, std::size_t rootIndex) noexcept;
+
+		// State shared by every Task promise.
+		// - Frames are allocated from FramePool instead of the global heap.
+		// - Tasks are lazy: nothing runs until the task is awaited or spawned on a Scheduler.
+		// - m_Scheduler is inherited from the awaiting task so awaitables can find their scheduler.
+		class TaskPromiseBase
+		{
+		public:
+			static void* operator new(std::size_t size) { return FramePool::Get().Allocate(size); }
+			static void operator delete(void* ptr, std::size_t size) noexcept { FramePool::Get().Deallocate(ptr, size); }
+
+			struct FinalAwaiter
+			{
+				[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+				{
+					TaskPromiseBase& promise = handle.promise();
+					if (promise.m_Continuation)
+						return promise.m_Continuation; // symmetric transfer back to the awaiting task
+					if (promise.m_RootIndex != noRoot)
+						NotifyRootFinished(promise.m_Scheduler, promise.m_RootIndex);
+					return std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			[[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+			[[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+			void unhandled_exception() noexcept { m_Exception = std::current_exception(); }
+
+			[[nodiscard]] Scheduler* GetScheduler() const noexcept { return m_Scheduler; }
+			[[nodiscard]] const std::exception_ptr& GetException() const noexcept { return m_Exception; }
+
+		protected:
+			friend class ::RayEngine::Scheduler;
+			template<typename> friend class ::RayEngine::Task;
+
+			Scheduler* m_Scheduler = nullptr;
+			std::coroutine_handle<> m_Continuation;
+			std::exception_ptr m_Exception;
+			std::size_t m_RootIndex = noRoot;
+		};
+
+		template<typename T>
+		class TaskPromise final : public TaskPromiseBase
+		{
+		public:
+			[[nodiscard]] Task<T> get_return_object() noexcept;
+
+			template<typename U>
+			void return_value(U&& value) { m_Value.emplace(std::forward<U>(value)); }
+
+			[[nodiscard]] T TakeResult()
+			{
+				if (m_Exception)
+					std::rethrow_exception(m_Exception);
+				return std::move(*m_Value);
+			}
+
+		private:
+			std::optional<T> m_Value;
+		};
+
+		template<>
+		class TaskPromise<void> final : public TaskPromiseBase
+		{
+		public:
+			[[nodiscard]] Task<void> get_return_object() noexcept;
+
+			void return_void() const noexcept {}
+
+			void TakeResult()
+			{
+				if (m_Exception)
+					std::rethrow_exception(m_Exception);
+			}
+		};
+	}
+
+	// Coroutine task used by layers for multi-step logic.
+	// - Move-only; owns the coroutine frame and destroys it on destruction.
+	// - `co_await task` starts the child and resumes the awaiting task when it finishes,
+	//   returning its value (or rethrowing its exception).
+	// - Top-level tasks are handed to Application::Spawn / Scheduler::Spawn, which resume them
+	//   on the main thread once per frame from Run().
+	template<typename T>
+	class [[nodiscard]] Task
+	{
+	public:
+		using promise_type = Detail::TaskPromise<T>;
+		using Handle = std::coroutine_handle<promise_type>;
+
+		Task() noexcept = default;
+		explicit Task(Handle handle) noexcept
+			: m_Handle(handle)
+		{
+		}
+		~Task()
+		{
+			if (m_Handle)
+				m_Handle.destroy();
+		}
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+		Task(Task&& other) noexcept
+			: m_Handle(std::exchange(other.m_Handle, nullptr))
+		{
+		}
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (m_Handle)
+					m_Handle.destroy();
+				m_Handle = std::exchange(other.m_Handle, nullptr);
+			}
+			return *this;
+		}
+
+		[[nodiscard]] bool IsValid() const noexcept { return static_cast<bool>(m_Handle); }
+		[[nodiscard]] bool IsDone() const noexcept { return !m_Handle || m_Handle.done(); }
+
+		// Give up ownership of the frame (used by Scheduler::Spawn).
+		[[nodiscard]] Handle Release() noexcept { return std::exchange(m_Handle, nullptr); }
+
+		// Awaiting a Task: start it and continue the awaiting coroutine when it completes.
+		// The Task must own a frame; awaiting a default-constructed or moved-from Task is an error.
+		[[nodiscard]] bool await_ready() const noexcept
+		{
+			assert(m_Handle && "co_await on an empty Task");
+			return m_Handle.done();
+		}
+
+		template<typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+		{
+			promise_type& promise = m_Handle.promise();
+			promise.m_Continuation = awaiting;
+			promise.m_Scheduler = awaiting.promise().GetScheduler();
+			return m_Handle;
+		}
+
+		T await_resume()
+		{
+			assert(m_Handle && "co_await on an empty Task");
+			return m_Handle.promise().TakeResult();
+		}
+
+	private:
+		Handle m_Handle;
+	};
+
+	namespace Detail
+	{
+		template<typename T>
+		Task<T> TaskPromise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+	}
+}
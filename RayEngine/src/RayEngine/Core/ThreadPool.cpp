@@ -0,0 +1,221 @@
+#include "ThreadPool.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <exception>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constinit thread_local const ThreadPool* t_Pool = nullptr;
+		constinit thread_local std::size_t t_WorkerIndex = ThreadPool::notAWorker;
+	}
+
+	ThreadPool::ThreadPool(std::size_t workerCount, const ThreadPlacement& placement)
+		: m_Policy(placement.Policy)
+	{
+		if (workerCount == 0)
+		{
+			const unsigned hw = std::thread::hardware_concurrency();
+			workerCount = std::max<std::size_t>(1, hw > 1 ? hw - 1 : 1);
+		}
+
+		const CpuTopology detected = placement.Topology ? CpuTopology{} : CpuTopology::Detect();
+		const CpuTopology& topology = placement.Topology ? *placement.Topology : detected;
+		m_NodeCount = std::max<std::size_t>(1, topology.GetNodeCount());
+		m_Placements = topology.PlaceWorkers(workerCount, m_Policy);
+		for (const NumaNode& node : topology.GetNodes())
+			m_NodeCpus.push_back(node.Cpus);
+		m_Counters = std::make_unique<WorkerCounters[]>(workerCount);
+
+		m_Workers.reserve(workerCount);
+		for (std::size_t i = 0; i < workerCount; ++i)
+			m_Workers.emplace_back([this, i]() { WorkerLoop(i); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		Shutdown();
+	}
+
+	bool ThreadPool::Submit(Job job)
+	{
+		if (!job)
+			return false;
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_Stopping)
+				return false;
+			m_Jobs.emplace_back(std::move(job));
+		}
+		m_Condition.notify_one();
+		return true;
+	}
+
+	bool ThreadPool::RunOnEachWorker(const std::function<void(std::size_t)>& fn)
+	{
+		assert(GetCurrentWorkerIndex() == notAWorker && "RunOnEachWorker called from one of the pool's workers");
+
+		struct State
+		{
+			std::mutex Mutex;
+			std::condition_variable Changed;
+			std::size_t Arrived = 0;
+			std::size_t Finished = 0;
+			std::exception_ptr Exception;
+		};
+
+		const std::size_t workers = GetWorkerCount();
+		State state;
+		std::size_t submitted = 0;
+		for (; submitted < workers; ++submitted)
+		{
+			const bool queued = Submit([this, &state, &fn, workers]() {
+				{
+					std::unique_lock lock(state.Mutex);
+					if (++state.Arrived == workers)
+						state.Changed.notify_all();
+					state.Changed.wait(lock, [&]() { return state.Arrived == workers; });
+				}
+
+				try
+				{
+					fn(GetCurrentWorkerIndex());
+				}
+				catch (...)
+				{
+					std::lock_guard lock(state.Mutex);
+					if (!state.Exception)
+						state.Exception = std::current_exception();
+				}
+
+				std::lock_guard lock(state.Mutex);
+				if (++state.Finished == workers)
+					state.Changed.notify_all();
+			});
+			if (!queued)
+				break;
+		}
+
+		if (submitted != workers)
+		{
+			// Shutting down: release the jobs that did get queued.
+			std::unique_lock lock(state.Mutex);
+			state.Arrived += workers - submitted;
+			state.Finished += workers - submitted;
+			state.Changed.notify_all();
+			state.Changed.wait(lock, [&]() { return state.Finished == workers; });
+			return false;
+		}
+
+		{
+			std::unique_lock lock(state.Mutex);
+			state.Changed.wait(lock, [&]() { return state.Finished == workers; });
+		}
+		if (state.Exception)
+			std::rethrow_exception(state.Exception);
+		return true;
+	}
+
+	void ThreadPool::Shutdown() noexcept
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+	}
+
+	std::size_t ThreadPool::GetCurrentWorkerIndex() const noexcept
+	{
+		return t_Pool == this ? t_WorkerIndex : notAWorker;
+	}
+
+	std::vector<ThreadPoolNodeStats> ThreadPool::GetNodeStats() const
+	{
+		std::vector<ThreadPoolNodeStats> stats(m_NodeCount);
+		for (std::size_t node = 0; node < m_NodeCount; ++node)
+			stats[node].Node = static_cast<std::uint32_t>(node);
+
+		for (std::size_t i = 0; i < m_Placements.size(); ++i)
+		{
+			ThreadPoolNodeStats& node = stats[std::min<std::size_t>(m_Placements[i].Node, m_NodeCount - 1)];
+			node.Workers++;
+			node.Jobs += m_Counters[i].Jobs.load(std::memory_order_relaxed);
+			node.BusyNanoseconds += m_Counters[i].BusyNanoseconds.load(std::memory_order_relaxed);
+			node.RemoteJobs += m_Counters[i].RemoteJobs.load(std::memory_order_relaxed);
+		}
+		return stats;
+	}
+
+	void ThreadPool::ResetStats() noexcept
+	{
+		for (std::size_t i = 0; i < m_Placements.size(); ++i)
+		{
+			m_Counters[i].Jobs.store(0, std::memory_order_relaxed);
+			m_Counters[i].BusyNanoseconds.store(0, std::memory_order_relaxed);
+			m_Counters[i].RemoteJobs.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void ThreadPool::WorkerLoop(std::size_t index) noexcept
+	{
+		t_Pool = this;
+		t_WorkerIndex = index;
+
+		const WorkerPlacement& placement = m_Placements[index];
+		if (!PinCurrentThread(placement.Cpus))
+			RAY_CORE_WARN("[ThreadPool] could not pin worker {} ({} policy)", index, ToString(m_Policy));
+
+		WorkerCounters& counters = m_Counters[index];
+		for (;;)
+		{
+			Job job;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+				// Drain remaining jobs before exiting so completions are never lost.
+				if (m_Jobs.empty())
+					return;
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			try
+			{
+				job();
+			}
+			catch (const std::exception& e)
+			{
+				RAY_CORE_ERROR(std::string("[ThreadPool] job threw: ") + e.what());
+			}
+			catch (...)
+			{
+				RAY_CORE_ERROR("[ThreadPool] job threw unknown exception");
+			}
+
+			const auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			counters.Jobs.fetch_add(1, std::memory_order_relaxed);
+			counters.BusyNanoseconds.fetch_add(static_cast<std::uint64_t>(busy.count()), std::memory_order_relaxed);
+
+			// Simulated nodes may share CPUs, so test membership rather than mapping cpu -> node.
+			const int cpu = GetCurrentCpu();
+			if (cpu >= 0 && placement.Node < m_NodeCpus.size())
+			{
+				const std::vector<std::uint32_t>& cpus = m_NodeCpus[placement.Node];
+				if (!std::binary_search(cpus.begin(), cpus.end(), static_cast<std::uint32_t>(cpu)))
+					counters.RemoteJobs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+}
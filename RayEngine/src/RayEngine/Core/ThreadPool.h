@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Topology.h"
+
+namespace RayEngine
+{
+	// Where ThreadPool workers run. The topology is only read during construction.
+	struct ThreadPlacement
+	{
+		const CpuTopology* Topology = nullptr; // null: detect the real topology
+		AffinityPolicy Policy = AffinityPolicy::None;
+	};
+
+	// Per-node totals over the workers placed on that node.
+	struct ThreadPoolNodeStats
+	{
+		std::uint32_t Node = 0;
+		std::size_t Workers = 0;
+		std::uint64_t Jobs = 0;
+		std::uint64_t BusyNanoseconds = 0;
+		std::uint64_t RemoteJobs = 0; // jobs that finished on a CPU outside the worker's node
+	};
+
+	// Fixed set of background worker threads consuming a FIFO job queue.
+	// Jobs run off the main thread; anything that must touch engine state has to hop back
+	// to the main thread (e.g. via Scheduler::Post or the Application async APIs).
+	// Workers can be pinned according to an AffinityPolicy; each worker is assigned a node of the
+	// topology it was built with, and job counts / busy time are kept per worker.
+	class ThreadPool
+	{
+	public:
+		using Job = std::function<void()>;
+
+		static constexpr std::size_t notAWorker = std::numeric_limits<std::size_t>::max();
+
+		// workerCount == 0 picks hardware_concurrency() - 1 (at least one worker).
+		explicit ThreadPool(std::size_t workerCount = 0, const ThreadPlacement& placement = {});
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		// Returns false if the pool is shutting down and the job was not queued.
+		bool Submit(Job job);
+
+		// Run fn(workerIndex) once on every worker and wait for all of them; used to first-touch
+		// per-worker memory from the thread (and node) that will use it. Each job holds its worker
+		// until all have started, so every index runs on its own worker. Must not be called from a
+		// worker of this pool, and blocks while long-running jobs occupy workers. The first
+		// exception thrown by fn is rethrown. Returns false if the pool is shutting down.
+		bool RunOnEachWorker(const std::function<void(std::size_t)>& fn);
+
+		// Finishes all queued jobs and joins the workers. Safe to call more than once.
+		void Shutdown() noexcept;
+
+		[[nodiscard]] std::size_t GetWorkerCount() const noexcept { return m_Workers.size(); }
+		[[nodiscard]] AffinityPolicy GetAffinityPolicy() const noexcept { return m_Policy; }
+		[[nodiscard]] std::size_t GetNodeCount() const noexcept { return m_NodeCount; }
+		// Topology node the worker was placed on.
+		[[nodiscard]] std::uint32_t GetWorkerNode(std::size_t worker) const noexcept { return m_Placements[worker].Node; }
+		// Index of the calling thread in this pool, or notAWorker.
+		[[nodiscard]] std::size_t GetCurrentWorkerIndex() const noexcept;
+
+		[[nodiscard]] std::vector<ThreadPoolNodeStats> GetNodeStats() const;
+		void ResetStats() noexcept;
+
+	private:
+		struct alignas(64) WorkerCounters
+		{
+			std::atomic<std::uint64_t> Jobs{ 0 };
+			std::atomic<std::uint64_t> BusyNanoseconds{ 0 };
+			std::atomic<std::uint64_t> RemoteJobs{ 0 };
+		};
+
+		void WorkerLoop(std::size_t index) noexcept;
+
+	private:
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::deque<Job> m_Jobs;
+		bool m_Stopping = false;
+
+		AffinityPolicy m_Policy = AffinityPolicy::None;
+		std::size_t m_NodeCount = 1;
+		std::vector<WorkerPlacement> m_Placements;
+		std::vector<std::vector<std::uint32_t>> m_NodeCpus; // sorted CPU ids per node, for RemoteJobs
+		std::unique_ptr<WorkerCounters[]> m_Counters;
+	};
+}
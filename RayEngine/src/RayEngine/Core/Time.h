@@ -23,6 +23,8 @@ namespace RayEngine
 			m_LastTime = m_StartTime;
 			m_DeltaSeconds = 0.0;
 			m_ElapsedSeconds = 0.0;
+			m_IdleSeconds = 0.0;
+			m_PendingIdleSeconds = 0.0;
 		}
 
 		// Advance the internal clock by one frame; call once per frame.
@@ -32,6 +34,16 @@ namespace RayEngine
 			m_DeltaSeconds = std::chrono::duration<double>(now - m_LastTime).count();
 			m_LastTime = now;
 			m_ElapsedSeconds = std::chrono::duration<double>(now - m_StartTime).count();
+			m_IdleSeconds = m_PendingIdleSeconds;
+			m_PendingIdleSeconds = 0.0;
+		}
+
+		// Exclude `idle` (time spent blocked waiting for work) from the next delta, so the first
+		// frame after an idle period does not simulate the whole wait. Elapsed time still counts it.
+		void SkipIdle(Clock::duration idle) noexcept
+		{
+			m_LastTime += idle;
+			m_PendingIdleSeconds += std::chrono::duration<double>(idle).count();
 		}
 
 		// Time since last Tick() in seconds (double)
@@ -41,6 +53,8 @@ namespace RayEngine
 
 		// Total time since Reset() in seconds
 		[[nodiscard]] double GetElapsedSeconds() const noexcept { return m_ElapsedSeconds; }
+		// Idle time excluded from the last delta (see SkipIdle()).
+		[[nodiscard]] double GetIdleSeconds() const noexcept { return m_IdleSeconds; }
 		[[nodiscard]] double ElapsedSeconds() const noexcept { return GetElapsedSeconds(); }
 		[[nodiscard]] double ElapsedMilliseconds() const noexcept
 		{
@@ -52,5 +66,7 @@ namespace RayEngine
 		TimePoint m_LastTime;
 		double m_DeltaSeconds = 0.0;
 		double m_ElapsedSeconds = 0.0;
+		double m_IdleSeconds = 0.0;
+		double m_PendingIdleSeconds = 0.0;
 	};
 }
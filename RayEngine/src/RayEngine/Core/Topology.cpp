@@ -0,0 +1,287 @@
+#include "Topology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace RayEngine
+{
+	namespace
+	{
+		std::string ReadFirstLine(const std::filesystem::path& path)
+		{
+			std::ifstream file(path);
+			std::string line;
+			std::getline(file, line);
+			return line;
+		}
+
+		// CPUs this process may run on; empty if unknown.
+		std::vector<std::uint32_t> GetAllowedCpus()
+		{
+			std::vector<std::uint32_t> cpus;
+#ifdef __linux__
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+			{
+				for (std::uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+				{
+					if (CPU_ISSET(cpu, &set))
+						cpus.push_back(cpu);
+				}
+			}
+#endif
+			return cpus;
+		}
+
+		std::vector<std::uint32_t> GetFallbackCpus()
+		{
+			std::vector<std::uint32_t> cpus = GetAllowedCpus();
+			if (cpus.empty())
+			{
+				const unsigned count = std::max(1u, std::thread::hardware_concurrency());
+				for (std::uint32_t cpu = 0; cpu < count; ++cpu)
+					cpus.push_back(cpu);
+			}
+			return cpus;
+		}
+
+		// "Node 0 MemTotal:       65843660 kB"
+		std::uint64_t ReadNodeMemory(const std::filesystem::path& meminfo)
+		{
+			std::ifstream file(meminfo);
+			std::string line;
+			while (std::getline(file, line))
+			{
+				const std::size_t key = line.find("MemTotal:");
+				if (key == std::string::npos)
+					continue;
+				std::istringstream value(line.substr(key + 9));
+				std::uint64_t kilobytes = 0;
+				value >> kilobytes;
+				return kilobytes * 1024;
+			}
+			return 0;
+		}
+	}
+
+	const char* ToString(AffinityPolicy policy) noexcept
+	{
+		switch (policy)
+		{
+		case AffinityPolicy::None:      return "None";
+		case AffinityPolicy::Compact:   return "Compact";
+		case AffinityPolicy::Scatter:   return "Scatter";
+		case AffinityPolicy::NodeLocal: return "NodeLocal";
+		default:                        return "Unknown";
+		}
+	}
+
+	std::vector<std::uint32_t> CpuTopology::ParseCpuList(std::string_view list)
+	{
+		std::vector<std::uint32_t> cpus;
+		while (!list.empty())
+		{
+			const std::size_t comma = list.find(',');
+			std::string_view range = list.substr(0, comma);
+			list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+			while (!range.empty() && (range.back() == '\n' || range.back() == ' '))
+				range.remove_suffix(1);
+			if (range.empty())
+				continue;
+
+			std::uint32_t first = 0, last = 0;
+			const std::size_t dash = range.find('-');
+			const std::string_view firstText = range.substr(0, dash);
+			if (std::from_chars(firstText.data(), firstText.data() + firstText.size(), first).ec != std::errc{})
+				continue;
+			last = first;
+			if (dash != std::string_view::npos)
+			{
+				const std::string_view lastText = range.substr(dash + 1);
+				if (std::from_chars(lastText.data(), lastText.data() + lastText.size(), last).ec != std::errc{} || last < first)
+					continue;
+			}
+			for (std::uint32_t cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		}
+		std::sort(cpus.begin(), cpus.end());
+		cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+		return cpus;
+	}
+
+	CpuTopology CpuTopology::Detect(const std::filesystem::path& sysfsRoot)
+	{
+		CpuTopology topology;
+		std::vector<std::uint32_t> allowed = GetAllowedCpus();
+
+		std::error_code ec;
+		const std::filesystem::path nodeRoot = sysfsRoot / "node";
+		const std::vector<std::uint32_t> nodeIds = ParseCpuList(ReadFirstLine(nodeRoot / "online"));
+		for (std::uint32_t id : nodeIds)
+		{
+			const std::filesystem::path nodePath = nodeRoot / ("node" + std::to_string(id));
+			NumaNode node;
+			node.Id = id;
+			node.Cpus = ParseCpuList(ReadFirstLine(nodePath / "cpulist"));
+			if (!allowed.empty())
+			{
+				std::erase_if(node.Cpus, [&](std::uint32_t cpu) { return !std::binary_search(allowed.begin(), allowed.end(), cpu); });
+			}
+			node.MemoryBytes = ReadNodeMemory(nodePath / "meminfo");
+			// Memory-only nodes and nodes outside our cpuset cannot host workers.
+			if (!node.Cpus.empty())
+				topology.m_Nodes.push_back(std::move(node));
+		}
+
+		if (topology.m_Nodes.empty())
+		{
+			NumaNode node;
+			node.Cpus = GetFallbackCpus();
+			topology.m_Nodes.push_back(std::move(node));
+		}
+		return topology;
+	}
+
+	CpuTopology CpuTopology::Simulate(std::uint32_t nodeCount, std::uint32_t cpusPerNode)
+	{
+		const std::vector<std::uint32_t> real = GetFallbackCpus();
+		nodeCount = std::max(1u, nodeCount);
+		if (cpusPerNode == 0)
+			cpusPerNode = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(real.size()) / nodeCount);
+
+		CpuTopology topology;
+		topology.m_Simulated = true;
+		std::size_t next = 0;
+		for (std::uint32_t id = 0; id < nodeCount; ++id)
+		{
+			NumaNode node;
+			node.Id = id;
+			for (std::uint32_t i = 0; i < cpusPerNode; ++i)
+				node.Cpus.push_back(real[next++ % real.size()]);
+			std::sort(node.Cpus.begin(), node.Cpus.end());
+			node.Cpus.erase(std::unique(node.Cpus.begin(), node.Cpus.end()), node.Cpus.end());
+			topology.m_Nodes.push_back(std::move(node));
+		}
+		return topology;
+	}
+
+	std::size_t CpuTopology::GetCpuCount() const noexcept
+	{
+		std::size_t count = 0;
+		for (const NumaNode& node : m_Nodes)
+			count += node.Cpus.size();
+		return count;
+	}
+
+	std::uint32_t CpuTopology::GetNodeOfCpu(std::uint32_t cpu) const noexcept
+	{
+		for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+		{
+			if (std::binary_search(m_Nodes[i].Cpus.begin(), m_Nodes[i].Cpus.end(), cpu))
+				return static_cast<std::uint32_t>(i);
+		}
+		return unknownNode;
+	}
+
+	std::vector<WorkerPlacement> CpuTopology::PlaceWorkers(std::size_t workerCount, AffinityPolicy policy) const
+	{
+		std::vector<WorkerPlacement> placements(workerCount);
+		if (m_Nodes.empty())
+			return placements;
+
+		const std::size_t nodeCount = m_Nodes.size();
+		for (std::size_t worker = 0; worker < workerCount; ++worker)
+		{
+			WorkerPlacement& placement = placements[worker];
+			switch (policy)
+			{
+			case AffinityPolicy::Compact:
+			{
+				// Walk CPUs node-major; wrap around when there are more workers than CPUs.
+				std::size_t cpuIndex = worker % GetCpuCount();
+				for (std::size_t node = 0; node < nodeCount; ++node)
+				{
+					if (cpuIndex < m_Nodes[node].Cpus.size())
+					{
+						placement.Node = static_cast<std::uint32_t>(node);
+						placement.Cpus = { m_Nodes[node].Cpus[cpuIndex] };
+						break;
+					}
+					cpuIndex -= m_Nodes[node].Cpus.size();
+				}
+				break;
+			}
+			case AffinityPolicy::Scatter:
+			{
+				const NumaNode& node = m_Nodes[worker % nodeCount];
+				placement.Node = static_cast<std::uint32_t>(worker % nodeCount);
+				placement.Cpus = { node.Cpus[(worker / nodeCount) % node.Cpus.size()] };
+				break;
+			}
+			case AffinityPolicy::NodeLocal:
+				placement.Node = static_cast<std::uint32_t>(worker % nodeCount);
+				placement.Cpus = m_Nodes[placement.Node].Cpus;
+				break;
+			case AffinityPolicy::None:
+			default:
+				// Nominal node for statistics; the worker is not pinned.
+				placement.Node = static_cast<std::uint32_t>(worker % nodeCount);
+				break;
+			}
+		}
+		return placements;
+	}
+
+	std::string CpuTopology::Describe() const
+	{
+		std::ostringstream out;
+		for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+		{
+			const NumaNode& node = m_Nodes[i];
+			out << (i ? "\n" : "") << (m_Simulated ? "simulated node " : "node ") << node.Id << ": " << node.Cpus.size() << " cpu(s) [";
+			for (std::size_t c = 0; c < node.Cpus.size(); ++c)
+				out << (c ? "," : "") << node.Cpus[c];
+			out << "]";
+			if (node.MemoryBytes)
+				out << ", " << (node.MemoryBytes >> 20) << " MiB";
+		}
+		return out.str();
+	}
+
+	bool PinCurrentThread(const std::vector<std::uint32_t>& cpus) noexcept
+	{
+		if (cpus.empty())
+			return true;
+#ifdef __linux__
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (std::uint32_t cpu : cpus)
+		{
+			if (cpu < CPU_SETSIZE)
+				CPU_SET(cpu, &set);
+		}
+		return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+		return false;
+#endif
+	}
+
+	int GetCurrentCpu() noexcept
+	{
+#ifdef __linux__
+		return ::sched_getcpu();
+#else
+		return -1;
+#endif
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RayEngine
+{
+	struct NumaNode
+	{
+		std::uint32_t Id = 0;               // sysfs node id (index for simulated nodes)
+		std::vector<std::uint32_t> Cpus;    // OS CPU ids usable by this process
+		std::uint64_t MemoryBytes = 0;      // 0 if unknown
+	};
+
+	// How ThreadPool workers are pinned.
+	enum class AffinityPolicy : std::uint8_t
+	{
+		None,      // not pinned, the OS may migrate workers anywhere
+		Compact,   // one CPU per worker, filling node 0 first, then node 1, ...
+		Scatter,   // one CPU per worker, round-robin over nodes
+		NodeLocal  // round-robin over nodes, each worker free to move within its node's CPUs
+	};
+
+	[[nodiscard]] const char* ToString(AffinityPolicy policy) noexcept;
+
+	struct WorkerPlacement
+	{
+		std::uint32_t Node = 0;             // index into CpuTopology::GetNodes()
+		std::vector<std::uint32_t> Cpus;    // affinity mask; empty = not pinned
+	};
+
+	// CPU / NUMA layout of the machine as seen by this process.
+	// Detect() reads sysfs (Linux) and keeps only CPUs in the process affinity mask; anywhere it
+	// cannot, the result is a single node with hardware_concurrency() CPUs. Simulate() splits the
+	// real CPUs into several fake nodes so multi-node code paths run on single-node machines.
+	class CpuTopology
+	{
+	public:
+		static constexpr std::uint32_t unknownNode = std::numeric_limits<std::uint32_t>::max();
+
+		CpuTopology() = default;
+
+		[[nodiscard]] static CpuTopology Detect(const std::filesystem::path& sysfsRoot = "/sys/devices/system");
+		// nodeCount nodes of cpusPerNode CPUs each (0 = share the real CPUs out evenly). When there
+		// are fewer real CPUs than simulated ones, real CPUs are reused round-robin.
+		[[nodiscard]] static CpuTopology Simulate(std::uint32_t nodeCount, std::uint32_t cpusPerNode = 0);
+
+		// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+		[[nodiscard]] static std::vector<std::uint32_t> ParseCpuList(std::string_view list);
+
+		[[nodiscard]] const std::vector<NumaNode>& GetNodes() const noexcept { return m_Nodes; }
+		[[nodiscard]] std::size_t GetNodeCount() const noexcept { return m_Nodes.size(); }
+		[[nodiscard]] std::size_t GetCpuCount() const noexcept;
+		[[nodiscard]] bool IsSimulated() const noexcept { return m_Simulated; }
+
+		// Node index of an OS CPU id, or unknownNode. Ambiguous for simulated topologies that
+		// reuse CPUs; the first node listing the CPU wins.
+		[[nodiscard]] std::uint32_t GetNodeOfCpu(std::uint32_t cpu) const noexcept;
+
+		[[nodiscard]] std::vector<WorkerPlacement> PlaceWorkers(std::size_t workerCount, AffinityPolicy policy) const;
+
+		// One line per node, for logs.
+		[[nodiscard]] std::string Describe() const;
+
+	private:
+		std::vector<NumaNode> m_Nodes;
+		bool m_Simulated = false;
+	};
+
+	// Restrict the calling thread to `cpus`. Returns false (and changes nothing) if unsupported
+	// or refused by the OS. An empty list is a no-op that succeeds.
+	bool PinCurrentThread(const std::vector<std::uint32_t>& cpus) noexcept;
+
+	// OS CPU the calling thread is running on, or -1 if unknown.
+	[[nodiscard]] int GetCurrentCpu() noexcept;
+}
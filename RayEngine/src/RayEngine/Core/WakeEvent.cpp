@@ -0,0 +1,103 @@
+#include "WakeEvent.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace RayEngine
+{
+#ifdef __linux__
+	WakeEvent::WakeEvent()
+		: m_Fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+	{
+		if (m_Fd < 0)
+			RAY_CORE_WARN("[WakeEvent] eventfd failed: {}; idle waits fall back to 1 ms polling", std::strerror(errno));
+	}
+
+	WakeEvent::~WakeEvent()
+	{
+		if (m_Fd >= 0)
+			::close(m_Fd);
+	}
+
+	void WakeEvent::Signal() noexcept
+	{
+		if (m_Pending.exchange(true, std::memory_order_acq_rel))
+			return;
+		m_Signals.fetch_add(1, std::memory_order_relaxed);
+		if (m_Fd < 0)
+			return;
+		const std::uint64_t one = 1;
+		// EAGAIN means the counter is saturated, which is still signaled.
+		(void)!::write(m_Fd, &one, sizeof(one));
+	}
+
+	bool WakeEvent::Wait(std::optional<Clock::duration> timeout) noexcept
+	{
+		if (m_Fd < 0)
+		{
+			std::this_thread::sleep_for(std::min<Clock::duration>(timeout.value_or(std::chrono::milliseconds(1)), std::chrono::milliseconds(1)));
+			return m_Pending.exchange(false, std::memory_order_acq_rel);
+		}
+
+		pollfd descriptor{ m_Fd, POLLIN, 0 };
+		timespec interval{};
+		if (timeout)
+		{
+			const auto nanoseconds = std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(*timeout).count());
+			interval.tv_sec = static_cast<time_t>(nanoseconds / 1'000'000'000);
+			interval.tv_nsec = static_cast<long>(nanoseconds % 1'000'000'000);
+		}
+		int ready = 0;
+		do
+		{
+			ready = ::ppoll(&descriptor, 1, timeout ? &interval : nullptr, nullptr);
+		} while (ready < 0 && errno == EINTR);
+		if (ready <= 0)
+			return false;
+
+		// Drain the counter first, then re-arm the fast path (see the class comment for the order).
+		std::uint64_t count = 0;
+		(void)!::read(m_Fd, &count, sizeof(count));
+		m_Pending.store(false, std::memory_order_release);
+		return true;
+	}
+#else
+	WakeEvent::WakeEvent() = default;
+	WakeEvent::~WakeEvent() = default;
+
+	void WakeEvent::Signal() noexcept
+	{
+		if (m_Pending.exchange(true, std::memory_order_acq_rel))
+			return;
+		m_Signals.fetch_add(1, std::memory_order_relaxed);
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Signaled = true;
+		}
+		m_Condition.notify_one();
+	}
+
+	bool WakeEvent::Wait(std::optional<Clock::duration> timeout) noexcept
+	{
+		std::unique_lock lock(m_Mutex);
+		if (timeout)
+			m_Condition.wait_for(lock, *timeout, [this] { return m_Signaled; });
+		else
+			m_Condition.wait(lock, [this] { return m_Signaled; });
+		const bool signaled = std::exchange(m_Signaled, false);
+		lock.unlock();
+		if (signaled)
+			m_Pending.store(false, std::memory_order_release);
+		return signaled;
+	}
+#endif
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#ifndef __linux__
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace RayEngine
+{
+	// Wake-up signal for a thread that blocks while it has nothing to do (Application's idle mode).
+	// - Signal() may be called from any thread. Signals coalesce: after the first one, further
+	//   calls are a single atomic exchange until the waiter consumes it.
+	// - Wait() blocks until signaled or the timeout elapses, and consumes the signal. The waiter
+	//   must look for work *after* Wait() returns, so nothing signaled meanwhile is missed.
+	// Linux: an eventfd waited on with ppoll(), which io_uring can also signal directly
+	// (GetNativeHandle()). Elsewhere: mutex and condition variable.
+	class WakeEvent
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		WakeEvent();
+		~WakeEvent();
+
+		WakeEvent(const WakeEvent&) = delete;
+		WakeEvent& operator=(const WakeEvent&) = delete;
+		WakeEvent(WakeEvent&&) = delete;
+		WakeEvent& operator=(WakeEvent&&) = delete;
+
+		void Signal() noexcept;
+		// No timeout: wait until signaled. Returns false if the timeout elapsed unsignaled.
+		bool Wait(std::optional<Clock::duration> timeout = std::nullopt) noexcept;
+
+		// The eventfd on Linux; -1 elsewhere, or if it could not be created (Wait() then polls every
+		// millisecond).
+		[[nodiscard]] int GetNativeHandle() const noexcept { return m_Fd; }
+		// Signal() calls that reached the kernel (or the condition variable).
+		[[nodiscard]] std::uint64_t GetSignalCount() const noexcept { return m_Signals.load(std::memory_order_relaxed); }
+
+	private:
+		int m_Fd = -1;
+		std::atomic_bool m_Pending = false;
+		std::atomic<std::uint64_t> m_Signals = 0;
+#ifndef __linux__
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_Signaled = false;
+#endif
+	};
+}
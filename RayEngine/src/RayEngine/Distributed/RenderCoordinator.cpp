@@ -0,0 +1,403 @@
+#include "RenderCoordinator.h"
+#include "TileProtocol.h"
+#include "RayEngine/Core/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <numeric>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace RayEngine
+{
+	namespace
+	{
+		// Exponential moving average weight of the newest tile cost measurement.
+		constexpr double costSmoothing = 0.5;
+
+		// Numbers the default socket and framebuffer names of the coordinators in this process.
+		constinit std::atomic<std::uint32_t> s_NextInstance{ 0 };
+
+		// True if some process accepts connections at `address`. A socket file left by a crashed
+		// coordinator refuses them (ECONNREFUSED) and may be removed.
+		[[nodiscard]] bool IsListening(const sockaddr_un& address, bool& stale) noexcept
+		{
+			stale = false;
+			const int probe = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+			if (probe < 0)
+				return false;
+			const bool listening = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+			stale = !listening && errno == ECONNREFUSED;
+			::close(probe);
+			return listening;
+		}
+	}
+
+	RenderCoordinator::RenderCoordinator(RenderCoordinatorSpecification specification)
+		: m_Specification(std::move(specification))
+	{
+		const std::string instance = std::to_string(::getpid()) + "-" + std::to_string(s_NextInstance.fetch_add(1, std::memory_order_relaxed));
+		if (m_Specification.SocketPath.empty())
+			m_Specification.SocketPath = "/tmp/rayengine-" + instance + ".sock";
+		if (m_Specification.SharedMemoryName.empty())
+			m_Specification.SharedMemoryName = "/rayengine-fb-" + instance;
+		m_Specification.TilesInFlightPerWorker = std::max<std::uint32_t>(1, m_Specification.TilesInFlightPerWorker);
+
+		m_Tiles = MakeTiles(m_Specification.Width, m_Specification.Height, m_Specification.TileSize);
+		m_TileCost.assign(m_Tiles.size(), 0.0);
+	}
+
+	RenderCoordinator::~RenderCoordinator()
+	{
+		Shutdown();
+	}
+
+	bool RenderCoordinator::Start()
+	{
+		m_Framebuffer = SharedFramebuffer::Create(m_Specification.SharedMemoryName, m_Specification.Width, m_Specification.Height);
+		if (!m_Framebuffer)
+			return false;
+
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (m_Specification.SocketPath.size() >= sizeof(address.sun_path))
+		{
+			RAY_CORE_ERROR("[RenderCoordinator] socket path too long: '{}'", m_Specification.SocketPath);
+			return false;
+		}
+		std::memcpy(address.sun_path, m_Specification.SocketPath.c_str(), m_Specification.SocketPath.size() + 1);
+
+		m_ListenSocket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+		if (m_ListenSocket < 0)
+		{
+			RAY_CORE_ERROR("[RenderCoordinator] socket() failed: {}", std::strerror(errno));
+			return false;
+		}
+
+		// Only a stale socket file is replaced; a live coordinator keeps its path.
+		bool stale = false;
+		if (IsListening(address, stale))
+		{
+			RAY_CORE_ERROR("[RenderCoordinator] another coordinator is listening on '{}'", m_Specification.SocketPath);
+			::close(m_ListenSocket);
+			m_ListenSocket = -1;
+			return false;
+		}
+		if (stale)
+			::unlink(m_Specification.SocketPath.c_str());
+		if (::bind(m_ListenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+			|| ::listen(m_ListenSocket, 64) != 0)
+		{
+			RAY_CORE_ERROR("[RenderCoordinator] bind/listen on '{}' failed: {}", m_Specification.SocketPath, std::strerror(errno));
+			::close(m_ListenSocket);
+			m_ListenSocket = -1;
+			return false;
+		}
+
+		RAY_CORE_INFO("[RenderCoordinator] listening on '{}', framebuffer '{}' ({}x{}, {} tiles)",
+			m_Specification.SocketPath, m_Specification.SharedMemoryName,
+			m_Specification.Width, m_Specification.Height, m_Tiles.size());
+		return true;
+	}
+
+	bool RenderCoordinator::SpawnWorkers(std::size_t count, const std::string& executable)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			std::string flag = "--ray-worker";
+			std::string socketPath = m_Specification.SocketPath;
+			std::string shmName = m_Specification.SharedMemoryName;
+			std::string program = executable;
+			char* argv[] = { program.data(), flag.data(), socketPath.data(), shmName.data(), nullptr };
+
+			pid_t pid = 0;
+			const int result = ::posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv, environ);
+			if (result != 0)
+			{
+				RAY_CORE_ERROR("[RenderCoordinator] posix_spawn('{}') failed: {}", executable, std::strerror(result));
+				return false;
+			}
+			m_SpawnedPids.push_back(pid);
+		}
+		return true;
+	}
+
+	bool RenderCoordinator::WaitForWorkers(std::size_t count, int timeoutMs)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+		for (;;)
+		{
+			const auto ready = static_cast<std::size_t>(std::count_if(m_Workers.begin(), m_Workers.end(),
+				[](const Worker& worker) { return worker.Alive && worker.Pid != 0; }));
+			if (ready >= count)
+				return true;
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+			{
+				RAY_CORE_WARN("[RenderCoordinator] only {} of {} workers connected", ready, count);
+				return false;
+			}
+			Update(static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()));
+		}
+	}
+
+	void RenderCoordinator::BeginFrame(std::uint64_t frameIndex)
+	{
+		m_FrameIndex = frameIndex;
+		m_FrameTimer.Reset();
+
+		// Most expensive first (longest-processing-time order); unknown costs keep scanline order.
+		std::vector<std::uint32_t> order(m_Tiles.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(),
+			[this](std::uint32_t a, std::uint32_t b) { return m_TileCost[a] > m_TileCost[b]; });
+
+		m_Pending.assign(order.begin(), order.end());
+		m_Remaining = m_Tiles.size();
+		for (Worker& worker : m_Workers)
+			worker.Outstanding.clear();
+
+		Dispatch();
+	}
+
+	bool RenderCoordinator::Update(int timeoutMs)
+	{
+		std::vector<pollfd> fds;
+		fds.reserve(m_Workers.size() + 1);
+		if (m_ListenSocket >= 0)
+			fds.push_back(pollfd{ m_ListenSocket, POLLIN, 0 });
+		for (const Worker& worker : m_Workers)
+		{
+			if (worker.Alive)
+				fds.push_back(pollfd{ worker.Socket, POLLIN, 0 });
+		}
+
+		const int ready = ::poll(fds.data(), fds.size(), timeoutMs);
+		if (ready > 0)
+		{
+			for (const pollfd& fd : fds)
+			{
+				if (fd.revents == 0)
+					continue;
+				if (fd.fd == m_ListenSocket)
+				{
+					AcceptWorkers();
+					continue;
+				}
+
+				auto it = std::find_if(m_Workers.begin(), m_Workers.end(),
+					[&fd](const Worker& worker) { return worker.Alive && worker.Socket == fd.fd; });
+				if (it == m_Workers.end())
+					continue;
+				if (fd.revents & POLLIN)
+					HandleMessage(*it);
+				else
+					DropWorker(*it); // POLLHUP / POLLERR without data
+			}
+		}
+
+		Dispatch();
+		ReapChildren();
+		return IsFrameComplete();
+	}
+
+	bool RenderCoordinator::RenderFrame(std::uint64_t frameIndex)
+	{
+		BeginFrame(frameIndex);
+		while (!IsFrameComplete())
+		{
+			if (GetAliveWorkerCount() == 0)
+			{
+				RAY_CORE_ERROR("[RenderCoordinator] frame {} aborted: no workers left ({} tiles missing)", frameIndex, m_Remaining);
+				return false;
+			}
+			Update(100);
+		}
+		return true;
+	}
+
+	std::size_t RenderCoordinator::GetAliveWorkerCount() const noexcept
+	{
+		return static_cast<std::size_t>(std::count_if(m_Workers.begin(), m_Workers.end(),
+			[](const Worker& worker) { return worker.Alive; }));
+	}
+
+	void RenderCoordinator::KillWorker(std::size_t index) noexcept
+	{
+		if (index < m_Workers.size() && m_Workers[index].Alive && m_Workers[index].Pid > 0)
+			::kill(m_Workers[index].Pid, SIGKILL);
+	}
+
+	void RenderCoordinator::Shutdown() noexcept
+	{
+		TileMessage message;
+		message.Type = TileMessageType::Shutdown;
+		for (Worker& worker : m_Workers)
+		{
+			if (worker.Alive)
+				(void)SendTileMessage(worker.Socket, message);
+			if (worker.Socket >= 0)
+				::close(worker.Socket);
+			worker.Socket = -1;
+			worker.Alive = false;
+		}
+		m_Workers.clear();
+
+		// Workers exit when their socket closes; give them a moment before forcing it.
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+		while (!m_SpawnedPids.empty() && std::chrono::steady_clock::now() < deadline)
+		{
+			ReapChildren();
+			if (!m_SpawnedPids.empty())
+				::usleep(1000);
+		}
+		for (int pid : m_SpawnedPids)
+		{
+			::kill(pid, SIGKILL);
+			::waitpid(pid, nullptr, 0);
+		}
+		m_SpawnedPids.clear();
+
+		if (m_ListenSocket >= 0)
+		{
+			::close(m_ListenSocket);
+			m_ListenSocket = -1;
+			::unlink(m_Specification.SocketPath.c_str());
+		}
+		m_Framebuffer.reset();
+	}
+
+	void RenderCoordinator::AcceptWorkers() noexcept
+	{
+		for (;;)
+		{
+			const int socket = ::accept4(m_ListenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+			if (socket < 0)
+				return; // EAGAIN: no more pending connections
+
+			try
+			{
+				Worker worker;
+				worker.Socket = socket;
+				worker.Outstanding.reserve(m_Specification.TilesInFlightPerWorker);
+				m_Workers.push_back(std::move(worker));
+			}
+			catch (...)
+			{
+				::close(socket);
+				return;
+			}
+		}
+	}
+
+	void RenderCoordinator::Dispatch() noexcept
+	{
+		TileMessage message;
+		message.Type = TileMessageType::Assign;
+		message.FrameIndex = m_FrameIndex;
+
+		// Round-robin one tile at a time so expensive tiles spread across workers.
+		bool assigned = true;
+		while (assigned && !m_Pending.empty())
+		{
+			assigned = false;
+			for (Worker& worker : m_Workers)
+			{
+				if (m_Pending.empty())
+					break;
+				if (!worker.Alive || worker.Pid == 0 || worker.Outstanding.size() >= m_Specification.TilesInFlightPerWorker)
+					continue;
+
+				const std::uint32_t tile = m_Pending.front();
+				message.WorkTile = m_Tiles[tile];
+				if (!SendTileMessage(worker.Socket, message))
+				{
+					DropWorker(worker);
+					continue;
+				}
+				m_Pending.pop_front();
+				worker.Outstanding.push_back(tile);
+				assigned = true;
+			}
+		}
+	}
+
+	void RenderCoordinator::HandleMessage(Worker& worker) noexcept
+	{
+		TileMessage message;
+		if (!ReceiveTileMessage(worker.Socket, message))
+		{
+			DropWorker(worker);
+			return;
+		}
+
+		switch (message.Type)
+		{
+		case TileMessageType::Hello:
+			worker.Pid = static_cast<int>(message.WorkerPid);
+			RAY_CORE_INFO("[RenderCoordinator] worker {} connected", worker.Pid);
+			break;
+
+		case TileMessageType::Done:
+		{
+			const std::uint32_t tile = message.WorkTile.Id;
+			auto it = std::find(worker.Outstanding.begin(), worker.Outstanding.end(), tile);
+			if (message.FrameIndex != m_FrameIndex || it == worker.Outstanding.end())
+				break; // stale result from an earlier frame
+
+			worker.Outstanding.erase(it);
+			worker.TilesDone++;
+			m_TileCost[tile] = m_TileCost[tile] == 0.0
+				? static_cast<double>(message.CostNanoseconds)
+				: costSmoothing * static_cast<double>(message.CostNanoseconds) + (1.0 - costSmoothing) * m_TileCost[tile];
+			m_Stats.TilesRendered++;
+
+			if (--m_Remaining == 0)
+			{
+				m_Stats.Frames++;
+				m_Stats.LastFrameSeconds = m_FrameTimer.ElapsedMilliseconds() / 1000.0;
+			}
+			break;
+		}
+
+		default:
+			RAY_CORE_WARN("[RenderCoordinator] unexpected message {} from worker {}", static_cast<std::uint32_t>(message.Type), worker.Pid);
+			break;
+		}
+	}
+
+	void RenderCoordinator::DropWorker(Worker& worker) noexcept
+	{
+		if (!worker.Alive)
+			return;
+
+		worker.Alive = false;
+		::close(worker.Socket);
+		worker.Socket = -1;
+		m_Stats.WorkersLost++;
+
+		// Its tiles go first: they have been waiting the longest.
+		for (auto it = worker.Outstanding.rbegin(); it != worker.Outstanding.rend(); ++it)
+			m_Pending.push_front(*it);
+		m_Stats.TilesReassigned += worker.Outstanding.size();
+		RAY_CORE_WARN("[RenderCoordinator] lost worker {}, reassigning {} tile(s)", worker.Pid, worker.Outstanding.size());
+		worker.Outstanding.clear();
+	}
+
+	void RenderCoordinator::ReapChildren() noexcept
+	{
+		std::erase_if(m_SpawnedPids, [](int pid) { return ::waitpid(pid, nullptr, WNOHANG) == pid; });
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SharedFramebuffer.h"
+#include "Tile.h"
+#include "RayEngine/Core/Time.h"
+
+namespace RayEngine
+{
+	struct RenderCoordinatorSpecification
+	{
+		std::uint32_t Width = 1280;
+		std::uint32_t Height = 720;
+		std::uint32_t TileSize = 64;
+		std::uint32_t TilesInFlightPerWorker = 2; // hides the round trip between two tiles
+		// Defaults are unique per coordinator: several Applications in one process may each run one.
+		std::string SocketPath;                   // default: /tmp/rayengine-<pid>-<n>.sock
+		std::string SharedMemoryName;             // default: /rayengine-fb-<pid>-<n>
+	};
+
+	struct RenderCoordinatorStats
+	{
+		std::uint64_t Frames = 0;
+		std::uint64_t TilesRendered = 0;
+		std::uint64_t TilesReassigned = 0; // tiles handed to another worker after their worker died
+		std::uint64_t WorkersLost = 0;
+		double LastFrameSeconds = 0.0;
+	};
+
+	// Coordinator side of distributed tile rendering on one machine.
+	// - Worker processes connect over a Unix SOCK_SEQPACKET socket and write finished tiles
+	//   directly into a SharedFramebuffer; only small control messages travel over the socket.
+	// - Load balancing is dynamic: each frame the tiles are queued most-expensive-first using the
+	//   cost workers reported for them last frame, and a worker receives a new tile whenever it has
+	//   fewer than TilesInFlightPerWorker outstanding.
+	// - A worker whose socket closes (crash, kill) is dropped and its outstanding tiles are put back
+	//   at the front of the queue for the surviving workers.
+	// All methods are called from one thread (typically the owning Application's main thread).
+	class RenderCoordinator
+	{
+	public:
+		explicit RenderCoordinator(RenderCoordinatorSpecification specification = {});
+		~RenderCoordinator();
+
+		RenderCoordinator(const RenderCoordinator&) = delete;
+		RenderCoordinator& operator=(const RenderCoordinator&) = delete;
+		RenderCoordinator(RenderCoordinator&&) = delete;
+		RenderCoordinator& operator=(RenderCoordinator&&) = delete;
+
+		// Create the listening socket and the shared framebuffer.
+		[[nodiscard]] bool Start();
+
+		// Launch `count` local workers as `executable --ray-worker <socket> <shm>`.
+		[[nodiscard]] bool SpawnWorkers(std::size_t count, const std::string& executable);
+		// Accept connections until `count` workers said Hello or the timeout expires.
+		[[nodiscard]] bool WaitForWorkers(std::size_t count, int timeoutMs);
+
+		// Queue every tile of frame `frameIndex`. Progress is made by Update().
+		void BeginFrame(std::uint64_t frameIndex);
+		// Accept new workers, hand out tiles and collect results, waiting up to `timeoutMs` for
+		// socket activity. Returns true once the current frame is complete.
+		bool Update(int timeoutMs = 0);
+		// BeginFrame + Update until done. Returns false if every worker is gone.
+		[[nodiscard]] bool RenderFrame(std::uint64_t frameIndex);
+
+		[[nodiscard]] bool IsFrameComplete() const noexcept { return m_Remaining == 0; }
+		[[nodiscard]] std::size_t GetAliveWorkerCount() const noexcept;
+		[[nodiscard]] const std::vector<Tile>& GetTiles() const noexcept { return m_Tiles; }
+		[[nodiscard]] SharedFramebuffer& GetFramebuffer() noexcept { return *m_Framebuffer; }
+		[[nodiscard]] const RenderCoordinatorStats& GetStats() const noexcept { return m_Stats; }
+
+		// Fault injection for tests: SIGKILL the worker at `index` (in connection order).
+		void KillWorker(std::size_t index) noexcept;
+
+		// Ask all workers to exit and reap them. Called by the destructor.
+		void Shutdown() noexcept;
+
+	private:
+		struct Worker
+		{
+			int Socket = -1;
+			int Pid = 0;          // 0 until Hello arrives
+			bool Alive = true;
+			std::vector<std::uint32_t> Outstanding;
+			std::uint64_t TilesDone = 0;
+		};
+
+		void AcceptWorkers() noexcept;
+		void Dispatch() noexcept;
+		void HandleMessage(Worker& worker) noexcept;
+		void DropWorker(Worker& worker) noexcept;
+		void ReapChildren() noexcept;
+
+	private:
+		RenderCoordinatorSpecification m_Specification;
+		int m_ListenSocket = -1;
+		std::unique_ptr<SharedFramebuffer> m_Framebuffer;
+
+		std::vector<Tile> m_Tiles;
+		std::vector<double> m_TileCost; // last measured cost per tile (ns), drives dispatch order
+		std::deque<std::uint32_t> m_Pending;
+		std::size_t m_Remaining = 0;
+		std::uint64_t m_FrameIndex = 0;
+		Time m_FrameTimer;
+
+		std::vector<Worker> m_Workers;
+		std::vector<int> m_SpawnedPids;
+		RenderCoordinatorStats m_Stats;
+	};
+}
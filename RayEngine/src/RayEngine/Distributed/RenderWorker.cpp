@@ -0,0 +1,90 @@
+#include "RenderWorker.h"
+#include "TileProtocol.h"
+#include "RayEngine/Core/Log.h"
+
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace RayEngine
+{
+	int RenderWorker::Run(const std::string& socketPath, const std::string& sharedMemoryName, const TileKernel& kernel)
+	{
+		auto framebuffer = SharedFramebuffer::Open(sharedMemoryName);
+		if (!framebuffer)
+			return 1;
+
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (socketPath.size() >= sizeof(address.sun_path))
+			return 1;
+		std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+		const int socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+		if (socket < 0 || ::connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			RAY_CORE_ERROR("[RenderWorker] connect('{}') failed: {}", socketPath, std::strerror(errno));
+			if (socket >= 0)
+				::close(socket);
+			return 1;
+		}
+
+		TileMessage message;
+		message.Type = TileMessageType::Hello;
+		message.WorkerPid = static_cast<std::uint32_t>(::getpid());
+		if (!SendTileMessage(socket, message))
+		{
+			::close(socket);
+			return 1;
+		}
+
+		int exitCode = 0;
+		while (ReceiveTileMessage(socket, message))
+		{
+			if (message.Type == TileMessageType::Shutdown)
+				break;
+			if (message.Type != TileMessageType::Assign)
+				continue;
+
+			const auto start = std::chrono::steady_clock::now();
+			try
+			{
+				kernel(message.WorkTile, message.FrameIndex, *framebuffer);
+			}
+			catch (const std::exception& e)
+			{
+				// Dying makes the coordinator reassign the tile to a healthy worker.
+				RAY_CORE_ERROR(std::string("[RenderWorker] tile kernel threw: ") + e.what());
+				exitCode = 1;
+				break;
+			}
+			const auto cost = std::chrono::steady_clock::now() - start;
+
+			message.Type = TileMessageType::Done;
+			message.WorkerPid = static_cast<std::uint32_t>(::getpid());
+			message.CostNanoseconds = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(cost).count());
+			if (!SendTileMessage(socket, message))
+				break;
+		}
+
+		::close(socket);
+		return exitCode;
+	}
+
+	bool RenderWorker::IsWorkerCommandLine(int argc, char** argv) noexcept
+	{
+		return argc >= 4 && std::string_view(argv[1]) == commandLineFlag;
+	}
+
+	int RenderWorker::RunFromCommandLine(int argc, char** argv, const TileKernel& kernel)
+	{
+		if (!IsWorkerCommandLine(argc, argv))
+			return 1;
+		return Run(argv[2], argv[3], kernel);
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "SharedFramebuffer.h"
+#include "Tile.h"
+
+namespace RayEngine
+{
+	// Renders one tile of frame `frameIndex` directly into the shared framebuffer.
+	using TileKernel = std::function<void(const Tile& tile, std::uint64_t frameIndex, SharedFramebuffer& target)>;
+
+	// Worker side of distributed tile rendering.
+	// Connects to a RenderCoordinator, maps its framebuffer and renders assigned tiles until told to
+	// shut down or the coordinator goes away. Runs on the calling thread; returns a process exit code.
+	class RenderWorker
+	{
+	public:
+		static constexpr const char* commandLineFlag = "--ray-worker";
+
+		[[nodiscard]] static int Run(const std::string& socketPath, const std::string& sharedMemoryName, const TileKernel& kernel);
+
+		// True if argv is `<exe> --ray-worker <socket> <shm>` (as launched by RenderCoordinator::SpawnWorkers).
+		[[nodiscard]] static bool IsWorkerCommandLine(int argc, char** argv) noexcept;
+		// Run() with the socket / shared memory names taken from such a command line.
+		[[nodiscard]] static int RunFromCommandLine(int argc, char** argv, const TileKernel& kernel);
+	};
+}
@@ -0,0 +1,164 @@
+#include "SharedFramebuffer.h"
+#include "RayEngine/Core/Log.h"
+
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RayEngine
+{
+	struct SharedFramebuffer::Header
+	{
+		static constexpr std::uint32_t magic = 0x52464231; // "RFB1"
+
+		std::uint32_t Magic;
+		std::uint32_t Width;
+		std::uint32_t Height;
+		std::uint32_t Channels;
+		std::int32_t OwnerPid; // creating process, to tell live segments from stale ones
+	};
+
+	namespace
+	{
+		// Pixel data starts on its own cache lines, away from the header.
+		constexpr std::size_t headerSize = 128;
+
+		std::size_t MappingSize(std::uint32_t width, std::uint32_t height) noexcept
+		{
+			return headerSize + static_cast<std::size_t>(width) * height * SharedFramebuffer::channels * sizeof(float);
+		}
+	}
+
+	std::unique_ptr<SharedFramebuffer> SharedFramebuffer::Create(const std::string& name, std::uint32_t width, std::uint32_t height)
+	{
+		static_assert(sizeof(Header) <= headerSize);
+
+		int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (fd < 0 && errno == EEXIST && IsStale(name))
+		{
+			::shm_unlink(name.c_str()); // left by a crashed run
+			fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		}
+		if (fd < 0 && errno == EEXIST)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] '{}' is in use by a running process", name);
+			return nullptr;
+		}
+		if (fd < 0)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] shm_open('{}') failed: {}", name, std::strerror(errno));
+			return nullptr;
+		}
+
+		const std::size_t size = MappingSize(width, height);
+		if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] ftruncate('{}') failed: {}", name, std::strerror(errno));
+			::close(fd);
+			::shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] mmap('{}') failed: {}", name, std::strerror(errno));
+			::shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		auto* header = static_cast<Header*>(mapping);
+		header->Width = width;
+		header->Height = height;
+		header->Channels = channels;
+		header->OwnerPid = static_cast<std::int32_t>(::getpid());
+		header->Magic = Header::magic;
+		return std::unique_ptr<SharedFramebuffer>(new SharedFramebuffer(name, mapping, size, true));
+	}
+
+	std::unique_ptr<SharedFramebuffer> SharedFramebuffer::Open(const std::string& name)
+	{
+		const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+		if (fd < 0)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] shm_open('{}') failed: {}", name, std::strerror(errno));
+			return nullptr;
+		}
+
+		struct stat st {};
+		if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < headerSize)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] '{}' is not a framebuffer segment", name);
+			::close(fd);
+			return nullptr;
+		}
+
+		const auto size = static_cast<std::size_t>(st.st_size);
+		void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] mmap('{}') failed: {}", name, std::strerror(errno));
+			return nullptr;
+		}
+
+		const auto* header = static_cast<const Header*>(mapping);
+		if (header->Magic != Header::magic || header->Channels != channels || MappingSize(header->Width, header->Height) != size)
+		{
+			RAY_CORE_ERROR("[SharedFramebuffer] '{}' has an unexpected layout", name);
+			::munmap(mapping, size);
+			return nullptr;
+		}
+		return std::unique_ptr<SharedFramebuffer>(new SharedFramebuffer(name, mapping, size, false));
+	}
+
+	bool SharedFramebuffer::IsStale(const std::string& name) noexcept
+	{
+		const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return errno == ENOENT;
+
+		// A segment without a complete header, or whose owner has exited, belongs to nobody.
+		Header header{};
+		struct stat st {};
+		const bool complete = ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= headerSize
+			&& ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) && header.Magic == Header::magic;
+		::close(fd);
+		if (!complete)
+			return true;
+		return ::kill(header.OwnerPid, 0) != 0 && errno == ESRCH;
+	}
+
+	SharedFramebuffer::SharedFramebuffer(std::string name, void* mapping, std::size_t size, bool owner) noexcept
+		: m_Name(std::move(name))
+		, m_Mapping(mapping)
+		, m_Size(size)
+		, m_Header(static_cast<Header*>(mapping))
+		, m_Pixels(reinterpret_cast<float*>(static_cast<unsigned char*>(mapping) + headerSize))
+		, m_Owner(owner)
+	{
+	}
+
+	SharedFramebuffer::~SharedFramebuffer()
+	{
+		if (m_Mapping)
+			::munmap(m_Mapping, m_Size);
+		if (m_Owner)
+			::shm_unlink(m_Name.c_str());
+	}
+
+	std::uint32_t SharedFramebuffer::GetWidth() const noexcept
+	{
+		return m_Header->Width;
+	}
+
+	std::uint32_t SharedFramebuffer::GetHeight() const noexcept
+	{
+		return m_Header->Height;
+	}
+}
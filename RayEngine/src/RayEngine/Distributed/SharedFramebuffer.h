@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace RayEngine
+{
+	// RGBA32F framebuffer living in POSIX shared memory.
+	// The coordinator creates (and unlinks) it; worker processes open it by name and write their
+	// tiles in place, so finished pixels never travel over the control socket.
+	class SharedFramebuffer
+	{
+	public:
+		static constexpr std::uint32_t channels = 4;
+
+		// `name` must start with '/' (shm_open rules). Returns nullptr and logs on failure, including
+		// when a live process owns a segment of that name; one left by an exited process is replaced.
+		[[nodiscard]] static std::unique_ptr<SharedFramebuffer> Create(const std::string& name, std::uint32_t width, std::uint32_t height);
+		[[nodiscard]] static std::unique_ptr<SharedFramebuffer> Open(const std::string& name);
+		~SharedFramebuffer();
+
+		SharedFramebuffer(const SharedFramebuffer&) = delete;
+		SharedFramebuffer& operator=(const SharedFramebuffer&) = delete;
+		SharedFramebuffer(SharedFramebuffer&&) = delete;
+		SharedFramebuffer& operator=(SharedFramebuffer&&) = delete;
+
+		[[nodiscard]] const std::string& GetName() const noexcept { return m_Name; }
+		[[nodiscard]] std::uint32_t GetWidth() const noexcept;
+		[[nodiscard]] std::uint32_t GetHeight() const noexcept;
+
+		// Pixel (x, y) starts at GetPixels() + (y * GetWidth() + x) * channels.
+		[[nodiscard]] float* GetPixels() noexcept { return m_Pixels; }
+		[[nodiscard]] const float* GetPixels() const noexcept { return m_Pixels; }
+		[[nodiscard]] float* GetPixel(std::uint32_t x, std::uint32_t y) noexcept
+		{
+			return m_Pixels + (static_cast<std::size_t>(y) * GetWidth() + x) * channels;
+		}
+
+	private:
+		struct Header;
+
+		SharedFramebuffer(std::string name, void* mapping, std::size_t size, bool owner) noexcept;
+		[[nodiscard]] static bool IsStale(const std::string& name) noexcept;
+
+	private:
+		std::string m_Name;
+		void* m_Mapping = nullptr;
+		std::size_t m_Size = 0;
+		Header* m_Header = nullptr;
+		float* m_Pixels = nullptr;
+		bool m_Owner = false;
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace RayEngine
+{
+	// Rectangular unit of render work in pixel coordinates.
+	struct Tile
+	{
+		std::uint32_t Id = 0;
+		std::uint32_t X = 0;
+		std::uint32_t Y = 0;
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+
+		[[nodiscard]] std::uint32_t GetPixelCount() const noexcept { return Width * Height; }
+	};
+
+	// Split a width x height image into row-major tiles of at most tileSize x tileSize.
+	[[nodiscard]] inline std::vector<Tile> MakeTiles(std::uint32_t width, std::uint32_t height, std::uint32_t tileSize)
+	{
+		std::vector<Tile> tiles;
+		if (tileSize == 0)
+			return tiles;
+
+		tiles.reserve(((width + tileSize - 1) / tileSize) * ((height + tileSize - 1) / tileSize));
+		for (std::uint32_t y = 0; y < height; y += tileSize)
+		{
+			for (std::uint32_t x = 0; x < width; x += tileSize)
+			{
+				tiles.push_back(Tile{ static_cast<std::uint32_t>(tiles.size()), x, y,
+					std::min(tileSize, width - x), std::min(tileSize, height - y) });
+			}
+		}
+		return tiles;
+	}
+}
@@ -0,0 +1,40 @@
+#include "TileProtocol.h"
+
+#include <atomic>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace RayEngine
+{
+	bool SendTileMessage(int socket, const TileMessage& message) noexcept
+	{
+		// Tile pixels were written to shared memory before this message; publish them first.
+		std::atomic_thread_fence(std::memory_order_release);
+		for (;;)
+		{
+			const ssize_t sent = ::send(socket, &message, sizeof(message), MSG_NOSIGNAL);
+			if (sent == static_cast<ssize_t>(sizeof(message)))
+				return true;
+			if (sent < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+	}
+
+	bool ReceiveTileMessage(int socket, TileMessage& message) noexcept
+	{
+		for (;;)
+		{
+			const ssize_t received = ::recv(socket, &message, sizeof(message), 0);
+			if (received == static_cast<ssize_t>(sizeof(message)))
+			{
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return true;
+			}
+			if (received < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Tile.h"
+
+namespace RayEngine
+{
+	// Control messages exchanged between RenderCoordinator and RenderWorker over a
+	// SOCK_SEQPACKET Unix socket. Every message is one fixed-size datagram; pixel data never
+	// crosses the socket (it is written straight into the SharedFramebuffer).
+	enum class TileMessageType : std::uint32_t
+	{
+		Hello = 1,    // worker -> coordinator, once after connecting
+		Assign,       // coordinator -> worker: render Tile for FrameIndex
+		Done,         // worker -> coordinator: Tile finished, CostNanoseconds spent
+		Shutdown      // coordinator -> worker: exit cleanly
+	};
+
+	struct TileMessage
+	{
+		TileMessageType Type = TileMessageType::Hello;
+		std::uint32_t WorkerPid = 0;
+		std::uint64_t FrameIndex = 0;
+		std::uint64_t CostNanoseconds = 0;
+		Tile WorkTile;
+	};
+
+	// Return false if the peer is gone (or the call failed); never raise SIGPIPE.
+	[[nodiscard]] bool SendTileMessage(int socket, const TileMessage& message) noexcept;
+	// Blocks unless the socket is non-blocking. Returns false on EOF/error or a malformed datagram.
+	[[nodiscard]] bool ReceiveTileMessage(int socket, TileMessage& message) noexcept;
+}
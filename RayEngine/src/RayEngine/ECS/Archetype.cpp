@@ -0,0 +1,127 @@
+#include "Archetype.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace RayEngine
+{
+	ChunkAllocator::~ChunkAllocator()
+	{
+		assert(m_Free.size() == m_Allocated && "chunks still owned by archetypes");
+		for (std::byte* chunk : m_Free)
+			::operator delete(chunk, std::align_val_t{ chunkAlignment });
+	}
+
+	std::byte* ChunkAllocator::Allocate()
+	{
+		if (!m_Free.empty())
+		{
+			std::byte* chunk = m_Free.back();
+			m_Free.pop_back();
+			return chunk;
+		}
+		auto* chunk = static_cast<std::byte*>(::operator new(chunkBytes, std::align_val_t{ chunkAlignment }));
+		m_Allocated++;
+		// Reserve now so Release() never allocates.
+		m_Free.reserve(m_Allocated);
+		return chunk;
+	}
+
+	void ChunkAllocator::Release(std::byte* chunk) noexcept
+	{
+		m_Free.push_back(chunk);
+	}
+
+	Archetype::Archetype(ComponentMask mask)
+		: m_Mask(mask)
+	{
+		AddEdges.fill(notPresent);
+		RemoveEdges.fill(notPresent);
+		m_Offsets.fill(notPresent);
+
+		std::size_t rowBytes = sizeof(Entity);
+		for (ComponentMask bits = mask; bits; bits &= bits - 1)
+		{
+			const auto id = static_cast<ComponentId>(std::countr_zero(bits));
+			m_Components.push_back(id);
+			rowBytes += GetComponentInfo(id).Size;
+		}
+
+		// Largest capacity whose aligned arrays fit in one chunk.
+		for (std::size_t capacity = ChunkAllocator::chunkBytes / rowBytes; capacity > 0; --capacity)
+		{
+			std::size_t offset = sizeof(Entity) * capacity;
+			for (ComponentId id : m_Components)
+			{
+				const ComponentInfo& info = GetComponentInfo(id);
+				offset = (offset + info.Alignment - 1) / info.Alignment * info.Alignment;
+				m_Offsets[id] = static_cast<std::uint32_t>(offset);
+				offset += static_cast<std::size_t>(info.Size) * capacity;
+			}
+			if (offset <= ChunkAllocator::chunkBytes)
+			{
+				m_Capacity = static_cast<std::uint32_t>(capacity);
+				break;
+			}
+		}
+		if (m_Capacity == 0)
+			throw std::length_error("ECS component set too large for one chunk");
+	}
+
+	std::uint32_t Archetype::AddRows(std::span<const Entity> entities, ChunkAllocator& allocator)
+	{
+		const std::uint32_t first = m_Count;
+		std::size_t written = 0;
+		while (written < entities.size())
+		{
+			if (m_Count == m_Chunks.size() * m_Capacity)
+				m_Chunks.push_back(allocator.Allocate());
+
+			const std::uint32_t index = m_Count % m_Capacity;
+			const std::size_t count = std::min<std::size_t>(m_Capacity - index, entities.size() - written);
+			std::memcpy(GetEntities(m_Chunks.size() - 1) + index, entities.data() + written, count * sizeof(Entity));
+			written += count;
+			m_Count += static_cast<std::uint32_t>(count);
+		}
+		return first;
+	}
+
+	Entity Archetype::RemoveRow(std::uint32_t row, ChunkAllocator& allocator) noexcept
+	{
+		assert(row < m_Count);
+		const std::uint32_t last = m_Count - 1;
+		Entity moved;
+		if (row != last)
+		{
+			const std::size_t toChunk = row / m_Capacity, toIndex = row % m_Capacity;
+			const std::size_t fromChunk = last / m_Capacity, fromIndex = last % m_Capacity;
+			for (ComponentId id : m_Components)
+			{
+				const std::size_t size = GetComponentInfo(id).Size;
+				std::memcpy(GetColumn(toChunk, id) + toIndex * size, GetColumn(fromChunk, id) + fromIndex * size, size);
+			}
+			moved = GetEntities(fromChunk)[fromIndex];
+			GetEntities(toChunk)[toIndex] = moved;
+		}
+
+		m_Count--;
+		if (m_Count == (m_Chunks.size() - 1) * m_Capacity)
+		{
+			allocator.Release(m_Chunks.back());
+			m_Chunks.pop_back();
+		}
+		return moved;
+	}
+
+	void Archetype::Clear(ChunkAllocator& allocator) noexcept
+	{
+		for (std::byte* chunk : m_Chunks)
+			allocator.Release(chunk);
+		m_Chunks.clear();
+		m_Count = 0;
+	}
+}
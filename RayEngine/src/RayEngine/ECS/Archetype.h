@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+namespace RayEngine
+{
+	// Recycles fixed-size, cache-line aligned chunk allocations between archetypes.
+	class ChunkAllocator
+	{
+	public:
+		static constexpr std::size_t chunkBytes = componentChunkBytes;
+		static constexpr std::size_t chunkAlignment = componentChunkAlignment;
+
+		ChunkAllocator() = default;
+		~ChunkAllocator();
+
+		ChunkAllocator(const ChunkAllocator&) = delete;
+		ChunkAllocator& operator=(const ChunkAllocator&) = delete;
+		ChunkAllocator(ChunkAllocator&&) = delete;
+		ChunkAllocator& operator=(ChunkAllocator&&) = delete;
+
+		[[nodiscard]] std::byte* Allocate();
+		void Release(std::byte* chunk) noexcept;
+		[[nodiscard]] std::size_t GetAllocatedChunks() const noexcept { return m_Allocated; }
+
+	private:
+		std::vector<std::byte*> m_Free;
+		std::size_t m_Allocated = 0;
+	};
+
+	// All entities with exactly one set of components. Entities live in rows of fixed-size chunks;
+	// within a chunk every component is a contiguous array (structure of arrays) next to the array
+	// of entity handles. Rows are kept dense: removing a row moves the archetype's last row into it.
+	// Row r lives in chunk r / capacity at index r % capacity.
+	class Archetype
+	{
+	public:
+		static constexpr std::uint32_t notPresent = UINT32_MAX;
+
+		// Throws std::length_error when one row of the components does not fit in a chunk.
+		explicit Archetype(ComponentMask mask);
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+		Archetype(Archetype&&) = delete;
+		Archetype& operator=(Archetype&&) = delete;
+
+		[[nodiscard]] ComponentMask GetMask() const noexcept { return m_Mask; }
+		[[nodiscard]] const std::vector<ComponentId>& GetComponents() const noexcept { return m_Components; }
+		[[nodiscard]] bool Has(ComponentId id) const noexcept { return (m_Mask >> id) & 1; }
+
+		[[nodiscard]] std::uint32_t GetChunkCapacity() const noexcept { return m_Capacity; }
+		[[nodiscard]] std::size_t GetChunkCount() const noexcept { return m_Chunks.size(); }
+		[[nodiscard]] std::uint32_t GetEntityCount() const noexcept { return m_Count; }
+		[[nodiscard]] std::uint32_t GetChunkEntityCount(std::size_t chunk) const noexcept
+		{
+			return chunk + 1 < m_Chunks.size() ? m_Capacity : m_Count - static_cast<std::uint32_t>(chunk) * m_Capacity;
+		}
+
+		[[nodiscard]] Entity* GetEntities(std::size_t chunk) const noexcept { return reinterpret_cast<Entity*>(m_Chunks[chunk]); }
+		// Start of the component's array in a chunk; the component must be part of the archetype.
+		[[nodiscard]] std::byte* GetColumn(std::size_t chunk, ComponentId id) const noexcept { return m_Chunks[chunk] + m_Offsets[id]; }
+		[[nodiscard]] std::byte* GetComponent(std::uint32_t row, ComponentId id) const noexcept
+		{
+			return GetColumn(row / m_Capacity, id) + static_cast<std::size_t>(row % m_Capacity) * GetComponentInfo(id).Size;
+		}
+		[[nodiscard]] Entity GetEntity(std::uint32_t row) const noexcept { return GetEntities(row / m_Capacity)[row % m_Capacity]; }
+
+		// Appends `count` rows for `entities` with uninitialized components; returns the first row.
+		std::uint32_t AddRows(std::span<const Entity> entities, ChunkAllocator& allocator);
+		// Removes the row, filling it with the last row. Returns the entity that moved into `row`,
+		// or a null entity if `row` was the last one.
+		Entity RemoveRow(std::uint32_t row, ChunkAllocator& allocator) noexcept;
+		// Drops every row and returns all chunks to the allocator.
+		void Clear(ChunkAllocator& allocator) noexcept;
+
+		// Index of the archetype reached by adding / removing a component (cached graph edges).
+		std::array<std::uint32_t, maxComponentTypes> AddEdges;
+		std::array<std::uint32_t, maxComponentTypes> RemoveEdges;
+
+	private:
+		ComponentMask m_Mask = 0;
+		std::vector<ComponentId> m_Components;
+		std::array<std::uint32_t, maxComponentTypes> m_Offsets;
+		std::uint32_t m_Capacity = 0;
+		std::uint32_t m_Count = 0;
+		std::vector<std::byte*> m_Chunks;
+	};
+}
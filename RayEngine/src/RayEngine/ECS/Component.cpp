@@ -0,0 +1,37 @@
+#include "Component.h"
+#include "RayEngine/Core/Log.h"
+
+#include <array>
+#include <cassert>
+#include <mutex>
+#include <stdexcept>
+
+namespace RayEngine
+{
+	namespace
+	{
+		std::mutex s_RegistryMutex;
+		constinit std::array<ComponentInfo, maxComponentTypes> s_Components{};
+		constinit ComponentId s_ComponentCount = 0;
+	}
+
+	ComponentId Detail::RegisterComponent(std::uint32_t size, std::uint32_t alignment)
+	{
+		std::lock_guard lock(s_RegistryMutex);
+		if (s_ComponentCount == maxComponentTypes)
+		{
+			RAY_CORE_ERROR("[ECS] more than {} component types registered", maxComponentTypes);
+			throw std::length_error("too many ECS component types");
+		}
+		s_Components[s_ComponentCount] = ComponentInfo{ size, alignment };
+		return s_ComponentCount++;
+	}
+
+	const ComponentInfo& GetComponentInfo(ComponentId id) noexcept
+	{
+		assert(id < maxComponentTypes && "invalid component id");
+		// Ids are only handed out after their info is written, under the registry lock that
+		// also publishes it to the thread that receives the id.
+		return s_Components[id];
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Entity.h"
+
+namespace RayEngine
+{
+	using ComponentId = std::uint32_t;
+	using ComponentMask = std::uint64_t; // bit i set = component i present
+
+	inline constexpr ComponentId maxComponentTypes = 64;
+
+	// Archetype chunk geometry (see ChunkAllocator); bounds the size of a single component.
+	inline constexpr std::size_t componentChunkBytes = 16 * 1024;
+	inline constexpr std::size_t componentChunkAlignment = 64;
+
+	// Components are plain data: chunks move them with memcpy and never run destructors.
+	// Handles to external resources (indices, ids) are fine; owning pointers are not.
+	// One row of the component and its entity handle must fit in a chunk.
+	template<typename T>
+	concept Component = std::is_object_v<T> && !std::is_const_v<T> && std::is_trivially_copyable_v<T>
+		&& std::is_trivially_destructible_v<T> && sizeof(T) + sizeof(Entity) <= componentChunkBytes
+		&& alignof(T) <= componentChunkAlignment;
+
+	// True if no type appears twice in Ts. An entity holds at most one component of each type,
+	// and packed component values are matched to types by id.
+	template<typename... Ts>
+	inline constexpr bool distinctComponents = true;
+	template<typename T, typename... Rest>
+	inline constexpr bool distinctComponents<T, Rest...> = (!std::is_same_v<T, Rest> && ...) && distinctComponents<Rest...>;
+
+	struct ComponentInfo
+	{
+		std::uint32_t Size = 0;
+		std::uint32_t Alignment = 0;
+	};
+
+	namespace Detail
+	{
+		// Assigns the next free id; throws std::length_error past maxComponentTypes.
+		[[nodiscard]] ComponentId RegisterComponent(std::uint32_t size, std::uint32_t alignment);
+	}
+
+	// Process-wide id of T, assigned on first use. Ids depend on first-use order, so they are
+	// stable within a run but must not be persisted.
+	template<Component T>
+	[[nodiscard]] ComponentId GetComponentId()
+	{
+		static const ComponentId id = Detail::RegisterComponent(sizeof(T), alignof(T));
+		return id;
+	}
+
+	template<Component T>
+	[[nodiscard]] ComponentMask GetComponentMask()
+	{
+		return ComponentMask{ 1 } << GetComponentId<T>();
+	}
+
+	[[nodiscard]] const ComponentInfo& GetComponentInfo(ComponentId id) noexcept;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace RayEngine
+{
+	// Handle to an entity in a World: a slot index plus the slot's generation, so handles to
+	// destroyed entities stay detectably stale after the slot is reused.
+	struct Entity
+	{
+		static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint32_t Index = invalidIndex;
+		std::uint32_t Generation = 0;
+
+		[[nodiscard]] constexpr bool IsNull() const noexcept { return Index == invalidIndex; }
+		[[nodiscard]] constexpr bool operator==(const Entity&) const noexcept = default;
+	};
+}
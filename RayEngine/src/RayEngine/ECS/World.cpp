@@ -0,0 +1,329 @@
+#include "World.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/WakeEvent.h"
+
+#include <bit>
+
+namespace RayEngine
+{
+	World::World()
+	{
+		// The empty archetype always exists so every live entity has a row.
+		GetArchetypeIndex(0);
+	}
+
+	World::~World()
+	{
+		for (const std::unique_ptr<Archetype>& archetype : m_Archetypes)
+			archetype->Clear(m_Chunks);
+	}
+
+	bool World::Destroy(Entity entity)
+	{
+		assert(m_IterationDepth == 0 && "structural change during a query; use DestroyDeferred");
+		if (!IsAlive(entity))
+			return false;
+
+		EntityRecord& record = m_Records[entity.Index];
+		RemoveRow(*m_Archetypes[record.Archetype], record.Row);
+		record.Archetype = Archetype::notPresent;
+		record.Generation++;
+		m_FreeIndices.push_back(entity.Index);
+		m_LiveCount--;
+		return true;
+	}
+
+	void World::DestroyDeferred(Entity entity)
+	{
+		{
+			std::lock_guard lock(m_CommandMutex);
+			m_Commands.push_back(Command{ CommandKind::Destroy, 0, entity, 1, 0, 0 });
+		}
+		SignalQueued();
+	}
+
+	void World::DestroyDeferred(std::span<const Entity> entities)
+	{
+		if (entities.empty())
+			return;
+		{
+			std::lock_guard lock(m_CommandMutex);
+			for (Entity entity : entities)
+				m_Commands.push_back(Command{ CommandKind::Destroy, 0, entity, 1, 0, 0 });
+		}
+		SignalQueued();
+	}
+
+	void World::SignalQueued() noexcept
+	{
+		if (m_WakeEvent)
+			m_WakeEvent->Signal();
+	}
+
+	void World::ApplyPending()
+	{
+		assert(m_IterationDepth == 0 && "ApplyPending during a query");
+		{
+			std::lock_guard lock(m_CommandMutex);
+			m_ExecutingCommands.swap(m_Commands);
+			m_ExecutingPayload.swap(m_Payload);
+		}
+
+		// Whatever happens, the executed buffers must be empty for the next swap.
+		struct ClearOnExit
+		{
+			World& Owner;
+			~ClearOnExit()
+			{
+				Owner.m_ExecutingCommands.clear();
+				Owner.m_ExecutingPayload.clear();
+			}
+		} clearOnExit{ *this };
+
+		// A failing command (e.g. std::length_error for a component set that does not fit in a
+		// chunk) is logged and skipped; the rest still apply.
+		const std::span<const Command> commands(m_ExecutingCommands);
+		for (std::size_t i = 0; i < commands.size();)
+		{
+			const Command& command = commands[i];
+			std::size_t consumed = 1;
+			if (command.Kind == CommandKind::Create)
+			{
+				while (i + consumed < commands.size() && commands[i + consumed].Kind == CommandKind::Create
+					&& commands[i + consumed].Mask == command.Mask)
+					consumed++;
+			}
+
+			try
+			{
+				switch (command.Kind)
+				{
+				case CommandKind::Create:
+					ApplyCreateRun(commands.subspan(i, consumed));
+					break;
+				case CommandKind::Destroy:
+					Destroy(command.Target);
+					break;
+				case CommandKind::Add:
+					AddComponent(command.Target, command.Component, m_ExecutingPayload.data() + command.Payload);
+					break;
+				case CommandKind::Remove:
+					RemoveComponent(command.Target, command.Component);
+					break;
+				}
+			}
+			catch (const std::exception& e)
+			{
+				RAY_CORE_ERROR("[ECS] deferred command {} of {} failed: {}", i, commands.size(), e.what());
+			}
+			i += consumed;
+		}
+	}
+
+	void World::ApplyCreateRun(std::span<const Command> commands)
+	{
+		const ComponentMask mask = commands.front().Mask;
+		std::size_t total = 0;
+		for (const Command& command : commands)
+			total += command.Count;
+
+		const std::uint32_t archetypeIndex = GetArchetypeIndex(mask);
+		std::uint32_t row = AddEntities(archetypeIndex, total, nullptr);
+		Archetype& archetype = *m_Archetypes[archetypeIndex];
+
+		// Every payload holds the components packed in ascending id order.
+		std::array<ComponentValue, maxComponentTypes> values;
+		for (std::size_t c = 0; c < commands.size(); ++c)
+		{
+			std::size_t valueCount = 0;
+			std::uint32_t offset = commands[c].Payload;
+			for (ComponentMask bits = mask; bits; bits &= bits - 1)
+			{
+				const auto id = static_cast<ComponentId>(std::countr_zero(bits));
+				values[valueCount++] = { id, m_ExecutingPayload.data() + offset };
+				offset += GetComponentInfo(id).Size;
+			}
+			FillRows(archetype, row, commands[c].Count, std::span<const ComponentValue>(values.data(), valueCount));
+			row += static_cast<std::uint32_t>(commands[c].Count);
+		}
+	}
+
+	std::size_t World::GetPendingCommandCount() const
+	{
+		std::lock_guard lock(m_CommandMutex);
+		return m_Commands.size();
+	}
+
+	bool World::IsAlive(Entity entity) const noexcept
+	{
+		return entity.Index < m_Records.size() && m_Records[entity.Index].Generation == entity.Generation
+			&& m_Records[entity.Index].Archetype != Archetype::notPresent;
+	}
+
+	std::uint32_t World::AppendPayload(std::span<const ComponentValue> values)
+	{
+		const auto offset = static_cast<std::uint32_t>(m_Payload.size());
+		for (const ComponentValue& value : values)
+		{
+			const auto* bytes = static_cast<const std::byte*>(value.Data);
+			m_Payload.insert(m_Payload.end(), bytes, bytes + GetComponentInfo(value.Id).Size);
+		}
+		return offset;
+	}
+
+	Archetype& World::GetOrCreateArchetype(ComponentMask mask)
+	{
+		return *m_Archetypes[GetArchetypeIndex(mask)];
+	}
+
+	std::uint32_t World::GetArchetypeIndex(ComponentMask mask)
+	{
+		if (const auto it = m_ArchetypeIndex.find(mask); it != m_ArchetypeIndex.end())
+			return it->second;
+
+		// Construct first: Archetype throws for component sets that do not fit in a chunk.
+		auto archetype = std::make_unique<Archetype>(mask);
+		const auto index = static_cast<std::uint32_t>(m_Archetypes.size());
+		m_Archetypes.push_back(std::move(archetype));
+		m_ArchetypeIndex.emplace(mask, index);
+		return index;
+	}
+
+	Entity World::AllocateEntity()
+	{
+		std::uint32_t index;
+		if (!m_FreeIndices.empty())
+		{
+			index = m_FreeIndices.back();
+			m_FreeIndices.pop_back();
+		}
+		else
+		{
+			index = static_cast<std::uint32_t>(m_Records.size());
+			m_Records.emplace_back();
+		}
+		m_LiveCount++;
+		return Entity{ index, m_Records[index].Generation };
+	}
+
+	void World::CreateEntities(ComponentMask mask, std::span<const ComponentValue> values, std::size_t count, Entity* created)
+	{
+		assert(m_IterationDepth == 0 && "structural change during a query; use CreateDeferred");
+		if (count == 0)
+			return;
+
+		const std::uint32_t archetypeIndex = GetArchetypeIndex(mask);
+		const std::uint32_t first = AddEntities(archetypeIndex, count, created);
+		FillRows(*m_Archetypes[archetypeIndex], first, count, values);
+	}
+
+	std::uint32_t World::AddEntities(std::uint32_t archetypeIndex, std::size_t count, Entity* created)
+	{
+		m_EntityScratch.resize(count);
+		for (Entity& entity : m_EntityScratch)
+			entity = AllocateEntity();
+		const std::uint32_t first = m_Archetypes[archetypeIndex]->AddRows(m_EntityScratch, m_Chunks);
+		for (std::size_t i = 0; i < count; ++i)
+			m_Records[m_EntityScratch[i].Index] = EntityRecord{ archetypeIndex, first + static_cast<std::uint32_t>(i), m_EntityScratch[i].Generation };
+		if (created)
+			std::copy(m_EntityScratch.begin(), m_EntityScratch.end(), created);
+		return first;
+	}
+
+	void World::FillRows(Archetype& archetype, std::uint32_t first, std::size_t count, std::span<const ComponentValue> values) noexcept
+	{
+		// Column by column, one chunk at a time.
+		const std::uint32_t capacity = archetype.GetChunkCapacity();
+		const auto end = first + static_cast<std::uint32_t>(count);
+		for (const ComponentValue& value : values)
+		{
+			const std::size_t size = GetComponentInfo(value.Id).Size;
+			for (std::uint32_t row = first; row < end;)
+			{
+				const std::size_t chunk = row / capacity;
+				const std::uint32_t chunkEnd = std::min(static_cast<std::uint32_t>(chunk + 1) * capacity, end);
+				std::byte* column = archetype.GetColumn(chunk, value.Id);
+				for (std::uint32_t r = row; r < chunkEnd; ++r)
+					std::memcpy(column + static_cast<std::size_t>(r % capacity) * size, value.Data, size);
+				row = chunkEnd;
+			}
+		}
+	}
+
+	bool World::AddComponent(Entity entity, ComponentId id, const void* data)
+	{
+		assert(m_IterationDepth == 0 && "structural change during a query; use AddDeferred");
+		if (!IsAlive(entity))
+			return false;
+
+		EntityRecord& record = m_Records[entity.Index];
+		Archetype& current = *m_Archetypes[record.Archetype];
+		if (!current.Has(id))
+		{
+			std::uint32_t target = current.AddEdges[id];
+			if (target == Archetype::notPresent)
+			{
+				target = GetArchetypeIndex(current.GetMask() | (ComponentMask{ 1 } << id));
+				// `current` is still valid: archetypes are heap-allocated and never removed.
+				current.AddEdges[id] = target;
+				m_Archetypes[target]->RemoveEdges[id] = record.Archetype;
+			}
+			MoveEntity(entity, record, target);
+		}
+		std::memcpy(m_Archetypes[record.Archetype]->GetComponent(record.Row, id), data, GetComponentInfo(id).Size);
+		return true;
+	}
+
+	bool World::RemoveComponent(Entity entity, ComponentId id)
+	{
+		assert(m_IterationDepth == 0 && "structural change during a query; use RemoveDeferred");
+		if (!IsAlive(entity))
+			return false;
+
+		EntityRecord& record = m_Records[entity.Index];
+		Archetype& current = *m_Archetypes[record.Archetype];
+		if (!current.Has(id))
+			return false;
+
+		std::uint32_t target = current.RemoveEdges[id];
+		if (target == Archetype::notPresent)
+		{
+			target = GetArchetypeIndex(current.GetMask() & ~(ComponentMask{ 1 } << id));
+			current.RemoveEdges[id] = target;
+			m_Archetypes[target]->AddEdges[id] = record.Archetype;
+		}
+		MoveEntity(entity, record, target);
+		return true;
+	}
+
+	std::byte* World::GetComponent(Entity entity, ComponentId id) const noexcept
+	{
+		if (!IsAlive(entity))
+			return nullptr;
+		const EntityRecord& record = m_Records[entity.Index];
+		const Archetype& archetype = *m_Archetypes[record.Archetype];
+		return archetype.Has(id) ? archetype.GetComponent(record.Row, id) : nullptr;
+	}
+
+	void World::MoveEntity(Entity entity, EntityRecord& record, std::uint32_t target)
+	{
+		Archetype& from = *m_Archetypes[record.Archetype];
+		Archetype& to = *m_Archetypes[target];
+		const std::uint32_t row = to.AddRows(std::span<const Entity>(&entity, 1), m_Chunks);
+		for (ComponentId id : to.GetComponents())
+		{
+			if (from.Has(id))
+				std::memcpy(to.GetComponent(row, id), from.GetComponent(record.Row, id), GetComponentInfo(id).Size);
+		}
+		RemoveRow(from, record.Row);
+		record.Archetype = target;
+		record.Row = row;
+	}
+
+	void World::RemoveRow(Archetype& archetype, std::uint32_t row) noexcept
+	{
+		const Entity moved = archetype.RemoveRow(row, m_Chunks);
+		if (!moved.IsNull())
+			m_Records[moved.Index].Row = row;
+	}
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Archetype.h"
+#include "Component.h"
+#include "Entity.h"
+#include "RayEngine/Core/ParallelFor.h"
+
+namespace RayEngine
+{
+	class WakeEvent;
+
+	class ThreadPool;
+
+	// Archetype-based entity-component store.
+	//
+	// Threading model (mirrors the Application layer API):
+	// - Immediate structural changes (Create, Destroy, Add, Remove) are main-thread only and not
+	//   allowed while a query is running. Creating an entity whose component set does not fit in
+	//   one chunk throws std::length_error before anything is changed.
+	// - The *Deferred variants may be called from any thread, including from inside parallel
+	//   queries. They are applied in call order by ApplyPending(), which the owning Application
+	//   runs at the top of each frame right after its own pending layer operations.
+	// - Queries call fn once per matching entity or chunk; the Parallel variants spread chunks over
+	//   a ThreadPool (plus the calling thread), so fn must only write the components it is given.
+	//   Query component types may be const to document read-only access.
+	//
+	//   world.Create(Position{}, Velocity{ 1, 0, 0 });
+	//   world.ParallelForEach<Position, const Velocity>(&pool, [dt](Position& p, const Velocity& v) { ... });
+	//   world.ForEach<const Health>([&](Entity e, const Health& h) { if (h.Value <= 0) world.DestroyDeferred(e); });
+	class World
+	{
+	public:
+		World();
+		~World();
+
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+		World(World&&) = delete;
+		World& operator=(World&&) = delete;
+
+		// --- immediate structural changes (main thread, outside queries) ---
+		template<Component... Ts>
+		Entity Create(const Ts&... components)
+		{
+			const std::array<ComponentValue, sizeof...(Ts)> values{ ComponentValue{ GetComponentId<Ts>(), &components }... };
+			Entity entity;
+			CreateEntities(MaskOf<Ts...>(), values, 1, &entity);
+			return entity;
+		}
+
+		// `count` entities initialized from the same component values.
+		template<Component... Ts>
+		void CreateMany(std::size_t count, const Ts&... components)
+		{
+			const std::array<ComponentValue, sizeof...(Ts)> values{ ComponentValue{ GetComponentId<Ts>(), &components }... };
+			CreateEntities(MaskOf<Ts...>(), values, count, nullptr);
+		}
+
+		// As above, returning the new handles in `created`.
+		template<Component... Ts>
+		void CreateMany(std::vector<Entity>& created, std::size_t count, const Ts&... components)
+		{
+			const std::array<ComponentValue, sizeof...(Ts)> values{ ComponentValue{ GetComponentId<Ts>(), &components }... };
+			created.resize(count);
+			CreateEntities(MaskOf<Ts...>(), values, count, created.data());
+		}
+
+		bool Destroy(Entity entity);
+
+		// Adds the component, or overwrites it if the entity already has one.
+		template<Component T>
+		bool Add(Entity entity, const T& component) { return AddComponent(entity, GetComponentId<T>(), &component); }
+
+		template<Component T>
+		bool Remove(Entity entity) { return RemoveComponent(entity, GetComponentId<T>()); }
+
+		// --- deferred structural changes (any thread) ---
+		template<Component... Ts>
+		void CreateDeferred(const Ts&... components) { CreateManyDeferred<Ts...>(1, components...); }
+
+		template<Component... Ts>
+		void CreateManyDeferred(std::size_t count, const Ts&... components)
+		{
+			std::array<ComponentValue, sizeof...(Ts)> values{ ComponentValue{ GetComponentId<Ts>(), &components }... };
+			std::sort(values.begin(), values.end(), [](const ComponentValue& a, const ComponentValue& b) { return a.Id < b.Id; });
+			{
+				std::lock_guard lock(m_CommandMutex);
+				const std::uint32_t payload = AppendPayload(values);
+				m_Commands.push_back(Command{ CommandKind::Create, MaskOf<Ts...>(), {}, count, payload, 0 });
+			}
+			SignalQueued();
+		}
+
+		void DestroyDeferred(Entity entity);
+		void DestroyDeferred(std::span<const Entity> entities);
+
+		template<Component T>
+		void AddDeferred(Entity entity, const T& component)
+		{
+			const std::array<ComponentValue, 1> value{ ComponentValue{ GetComponentId<T>(), &component } };
+			{
+				std::lock_guard lock(m_CommandMutex);
+				const std::uint32_t payload = AppendPayload(value);
+				m_Commands.push_back(Command{ CommandKind::Add, 0, entity, 1, payload, GetComponentId<T>() });
+			}
+			SignalQueued();
+		}
+
+		template<Component T>
+		void RemoveDeferred(Entity entity)
+		{
+			{
+				std::lock_guard lock(m_CommandMutex);
+				m_Commands.push_back(Command{ CommandKind::Remove, 0, entity, 1, 0, GetComponentId<T>() });
+			}
+			SignalQueued();
+		}
+
+		// Applies all deferred commands in submission order. Main thread, outside queries.
+		// A command that throws is logged and skipped; later commands still apply.
+		void ApplyPending();
+		[[nodiscard]] std::size_t GetPendingCommandCount() const;
+		// Optional event signaled by every *Deferred call, so an idle main thread wakes to apply it.
+		// Set before other threads may queue commands; the event must outlive the world's use of it.
+		void SetWakeEvent(WakeEvent* event) noexcept { m_WakeEvent = event; }
+
+		// --- access ---
+		[[nodiscard]] bool IsAlive(Entity entity) const noexcept;
+
+		// Null if the entity is dead or lacks the component. Valid until the next structural change.
+		template<Component T>
+		[[nodiscard]] T* Get(Entity entity) const noexcept { return reinterpret_cast<T*>(GetComponent(entity, GetComponentId<T>())); }
+
+		template<Component T>
+		[[nodiscard]] bool Has(Entity entity) const noexcept { return GetComponent(entity, GetComponentId<T>()) != nullptr; }
+
+		[[nodiscard]] std::size_t GetEntityCount() const noexcept { return m_LiveCount; }
+		[[nodiscard]] std::size_t GetArchetypeCount() const noexcept { return m_Archetypes.size(); }
+		[[nodiscard]] std::size_t GetChunkMemoryBytes() const noexcept { return m_Chunks.GetAllocatedChunks() * ChunkAllocator::chunkBytes; }
+
+		// --- queries ---
+		// fn(std::span<const Entity>, std::span<Ts>...) once per non-empty chunk of every archetype
+		// containing all Ts.
+		template<typename... Ts, typename Fn>
+		void ForEachChunk(Fn&& fn)
+		{
+			const ComponentMask mask = MaskOf<std::remove_const_t<Ts>...>();
+			IterationScope scope(*this);
+			for (const std::unique_ptr<Archetype>& archetype : m_Archetypes)
+			{
+				if ((archetype->GetMask() & mask) != mask)
+					continue;
+				for (std::size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+					InvokeChunk<Ts...>(*archetype, chunk, fn);
+			}
+		}
+
+		// fn(Ts&...) or fn(Entity, Ts&...) for every entity containing all Ts.
+		template<typename... Ts, typename Fn>
+		void ForEach(Fn&& fn)
+		{
+			ForEachChunk<Ts...>([&fn](std::span<const Entity> entities, std::span<Ts>... columns) {
+				ForEachRow<Ts...>(fn, entities, columns...);
+			});
+		}
+
+		// As ForEachChunk / ForEach, with chunks processed concurrently on `pool` and the caller.
+		template<typename... Ts, typename Fn>
+		void ParallelForEachChunk(ThreadPool* pool, Fn&& fn)
+		{
+			const ComponentMask mask = MaskOf<std::remove_const_t<Ts>...>();
+			IterationScope scope(*this);
+			std::vector<std::pair<Archetype*, std::size_t>> chunks;
+			for (const std::unique_ptr<Archetype>& archetype : m_Archetypes)
+			{
+				if ((archetype->GetMask() & mask) != mask)
+					continue;
+				for (std::size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+					chunks.push_back({ archetype.get(), chunk });
+			}
+			ParallelFor(pool, chunks.size(), [&chunks, &fn](std::size_t i) {
+				InvokeChunk<Ts...>(*chunks[i].first, chunks[i].second, fn);
+			});
+		}
+
+		template<typename... Ts, typename Fn>
+		void ParallelForEach(ThreadPool* pool, Fn&& fn)
+		{
+			ParallelForEachChunk<Ts...>(pool, [&fn](std::span<const Entity> entities, std::span<Ts>... columns) {
+				ForEachRow<Ts...>(fn, entities, columns...);
+			});
+		}
+
+	private:
+		struct ComponentValue
+		{
+			ComponentId Id;
+			const void* Data;
+		};
+
+		enum class CommandKind : std::uint8_t
+		{
+			Create,
+			Destroy,
+			Add,
+			Remove
+		};
+
+		struct Command
+		{
+			CommandKind Kind;
+			ComponentMask Mask;   // Create
+			Entity Target;        // Destroy, Add, Remove
+			std::size_t Count;    // Create
+			std::uint32_t Payload;  // offset of the packed component values in m_Payload
+			ComponentId Component;  // Add, Remove
+		};
+
+		struct EntityRecord
+		{
+			std::uint32_t Archetype = Archetype::notPresent;
+			std::uint32_t Row = 0;
+			std::uint32_t Generation = 0;
+		};
+
+		class IterationScope
+		{
+		public:
+			explicit IterationScope(World& world) noexcept : m_World(world) { ++m_World.m_IterationDepth; }
+			~IterationScope() { --m_World.m_IterationDepth; }
+
+			IterationScope(const IterationScope&) = delete;
+			IterationScope& operator=(const IterationScope&) = delete;
+
+		private:
+			World& m_World;
+		};
+
+		// Shared by every Create*, *Deferred and query template.
+		template<Component... Ts>
+		[[nodiscard]] static ComponentMask MaskOf()
+		{
+			static_assert(distinctComponents<Ts...>, "a component type may appear only once");
+			return (ComponentMask{ 0 } | ... | GetComponentMask<Ts>());
+		}
+
+		template<typename... Ts, typename Fn>
+		static void InvokeChunk(const Archetype& archetype, std::size_t chunk, Fn& fn)
+		{
+			const std::size_t count = archetype.GetChunkEntityCount(chunk);
+			fn(std::span<const Entity>(archetype.GetEntities(chunk), count),
+				std::span<Ts>(reinterpret_cast<Ts*>(archetype.GetColumn(chunk, GetComponentId<std::remove_const_t<Ts>>())), count)...);
+		}
+
+		template<typename... Ts, typename Fn>
+		static void ForEachRow(Fn& fn, std::span<const Entity> entities, std::span<Ts>... columns)
+		{
+			for (std::size_t i = 0; i < entities.size(); ++i)
+			{
+				if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>)
+					fn(entities[i], columns[i]...);
+				else
+					fn(columns[i]...);
+			}
+		}
+
+		// Called after a command is queued, without m_CommandMutex.
+		void SignalQueued() noexcept;
+		// Caller holds m_CommandMutex. Packs values (sorted by id) and returns their offset.
+		std::uint32_t AppendPayload(std::span<const ComponentValue> values);
+
+		Archetype& GetOrCreateArchetype(ComponentMask mask);
+		std::uint32_t GetArchetypeIndex(ComponentMask mask);
+		Entity AllocateEntity();
+		void CreateEntities(ComponentMask mask, std::span<const ComponentValue> values, std::size_t count, Entity* created);
+		// Appends `count` new entities to the archetype; returns the first row. Components are left
+		// uninitialized for FillRows.
+		std::uint32_t AddEntities(std::uint32_t archetypeIndex, std::size_t count, Entity* created);
+		void FillRows(Archetype& archetype, std::uint32_t first, std::size_t count, std::span<const ComponentValue> values) noexcept;
+		// Applies consecutive Create commands of one mask as a single batch.
+		void ApplyCreateRun(std::span<const Command> commands);
+		bool AddComponent(Entity entity, ComponentId id, const void* data);
+		bool RemoveComponent(Entity entity, ComponentId id);
+		[[nodiscard]] std::byte* GetComponent(Entity entity, ComponentId id) const noexcept;
+		// Moves the entity's row to `target`, copying the components both archetypes share.
+		void MoveEntity(Entity entity, EntityRecord& record, std::uint32_t target);
+		void RemoveRow(Archetype& archetype, std::uint32_t row) noexcept;
+
+	private:
+		ChunkAllocator m_Chunks;
+		std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+		std::unordered_map<ComponentMask, std::uint32_t> m_ArchetypeIndex;
+
+		std::vector<EntityRecord> m_Records;
+		std::vector<std::uint32_t> m_FreeIndices;
+		std::size_t m_LiveCount = 0;
+		std::vector<Entity> m_EntityScratch;
+		std::uint32_t m_IterationDepth = 0;
+
+		WakeEvent* m_WakeEvent = nullptr;
+		mutable std::mutex m_CommandMutex;
+		std::vector<Command> m_Commands;
+		std::vector<std::byte> m_Payload;
+		// Swapped with the pending buffers by ApplyPending() so neither loses its capacity.
+		std::vector<Command> m_ExecutingCommands;
+		std::vector<std::byte> m_ExecutingPayload;
+	};
+}
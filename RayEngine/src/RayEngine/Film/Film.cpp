@@ -0,0 +1,319 @@
+#include "Film.h"
+#include "Half.h"
+#include "RayEngine/Core/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAY_FILM_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define RAY_FILM_F16C 1 // hardware half loads, selected at runtime
+#include <immintrin.h>
+#endif
+#endif
+
+namespace RayEngine
+{
+	namespace
+	{
+		struct DevelopParams
+		{
+			float Scale;
+			float InverseGamma;
+		};
+
+		using RowKernel = void (*)(const void* source, std::size_t pixels, std::uint8_t* output, const DevelopParams& params);
+
+		template<Tonemap Curve>
+		inline float ApplyCurve(float c) noexcept
+		{
+			if constexpr (Curve == Tonemap::Reinhard)
+				return c / (1.0f + c);
+			else if constexpr (Curve == Tonemap::ACES)
+				return (c * (2.51f * c + 0.03f)) / (c * (2.43f * c + 0.59f) + 0.14f);
+			else
+				return c;
+		}
+
+		// --- Scalar reference ---
+		template<Tonemap Curve>
+		inline std::uint8_t DevelopChannel(float c, const DevelopParams& params) noexcept
+		{
+			c = ApplyCurve<Curve>(c * params.Scale);
+			// NaN (e.g. from infinite input) goes to 0, as _mm_max_ps does in the SIMD kernels.
+			c = std::clamp(c > 0.0f ? c : 0.0f, 0.0f, 1.0f);
+			return static_cast<std::uint8_t>(std::pow(c, params.InverseGamma) * 255.0f + 0.5f);
+		}
+
+		template<Tonemap Curve, bool Half>
+		void DevelopRowScalar(const void* source, std::size_t pixels, std::uint8_t* output, const DevelopParams& params)
+		{
+			for (std::size_t i = 0; i < pixels; ++i)
+			{
+				for (std::size_t channel = 0; channel < 3; ++channel)
+				{
+					float c;
+					if constexpr (Half)
+						c = HalfToFloat(static_cast<const std::uint16_t*>(source)[i * 4 + channel]);
+					else
+						c = static_cast<const float*>(source)[i * 4 + channel];
+					output[i * 4 + channel] = DevelopChannel<Curve>(c, params);
+				}
+				output[i * 4 + 3] = 255;
+			}
+		}
+
+#ifdef RAY_FILM_SSE2
+		// --- SSE2: one RGBA pixel per register ---
+		// log2/exp2 polynomial approximations (relative error ~1e-5), far below 8-bit resolution.
+		inline __m128 Log2(__m128 x) noexcept
+		{
+			const __m128i bits = _mm_castps_si128(x);
+			const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+			const __m128 mantissa = _mm_or_ps(_mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff))), _mm_set1_ps(1.0f));
+
+			__m128 p = _mm_set1_ps(0.0596515482674574969533f);
+			p = _mm_add_ps(_mm_mul_ps(p, mantissa), _mm_set1_ps(-0.465725644288844778798f));
+			p = _mm_add_ps(_mm_mul_ps(p, mantissa), _mm_set1_ps(1.48116647521213171641f));
+			p = _mm_add_ps(_mm_mul_ps(p, mantissa), _mm_set1_ps(-2.52074962577807006663f));
+			p = _mm_add_ps(_mm_mul_ps(p, mantissa), _mm_set1_ps(2.8882704548164776201f));
+			return _mm_add_ps(_mm_mul_ps(p, _mm_sub_ps(mantissa, _mm_set1_ps(1.0f))), exponent);
+		}
+
+		inline __m128 Exp2(__m128 x) noexcept
+		{
+			x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.99f)), _mm_set1_ps(126.99f));
+			__m128i whole = _mm_cvttps_epi32(x);
+			// Truncation rounds negative values up; step back one where that happened (floor).
+			whole = _mm_add_epi32(whole, _mm_castps_si128(_mm_cmplt_ps(x, _mm_cvtepi32_ps(whole))));
+			const __m128 fraction = _mm_sub_ps(x, _mm_cvtepi32_ps(whole));
+
+			__m128 p = _mm_set1_ps(1.8775767e-3f);
+			p = _mm_add_ps(_mm_mul_ps(p, fraction), _mm_set1_ps(8.9893397e-3f));
+			p = _mm_add_ps(_mm_mul_ps(p, fraction), _mm_set1_ps(5.5826318e-2f));
+			p = _mm_add_ps(_mm_mul_ps(p, fraction), _mm_set1_ps(2.4015361e-1f));
+			p = _mm_add_ps(_mm_mul_ps(p, fraction), _mm_set1_ps(6.9315308e-1f));
+			p = _mm_add_ps(_mm_mul_ps(p, fraction), _mm_set1_ps(9.9999994e-1f));
+			return _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23)), p);
+		}
+
+		template<Tonemap Curve>
+		inline __m128 ApplyCurve(__m128 c) noexcept
+		{
+			if constexpr (Curve == Tonemap::Reinhard)
+			{
+				return _mm_div_ps(c, _mm_add_ps(_mm_set1_ps(1.0f), c));
+			}
+			else if constexpr (Curve == Tonemap::ACES)
+			{
+				const __m128 numerator = _mm_mul_ps(c, _mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(2.51f)), _mm_set1_ps(0.03f)));
+				const __m128 denominator = _mm_add_ps(_mm_mul_ps(c, _mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(2.43f)), _mm_set1_ps(0.59f))), _mm_set1_ps(0.14f));
+				return _mm_div_ps(numerator, denominator);
+			}
+			else
+			{
+				return c;
+			}
+		}
+
+		template<Tonemap Curve>
+		inline std::uint32_t DevelopPixel(__m128 c, const DevelopParams& params) noexcept
+		{
+			c = ApplyCurve<Curve>(_mm_mul_ps(c, _mm_set1_ps(params.Scale)));
+			c = _mm_min_ps(_mm_max_ps(c, _mm_set1_ps(1e-10f)), _mm_set1_ps(1.0f));
+			c = Exp2(_mm_mul_ps(Log2(c), _mm_set1_ps(params.InverseGamma)));
+			const __m128i quantized = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+			const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(quantized, quantized), _mm_setzero_si128());
+			return static_cast<std::uint32_t>(_mm_cvtsi128_si32(packed)) | 0xff000000u; // alpha = 255 (little endian RGBA)
+		}
+
+		// Four halves -> four floats with SSE2 integer ops (magic multiply, as in HalfToFloat).
+		inline __m128 LoadHalf4(const std::uint16_t* source) noexcept
+		{
+			const __m128i halves = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)), _mm_setzero_si128());
+			const __m128i exponentMantissa = _mm_and_si128(halves, _mm_set1_epi32(0x7fff));
+			const __m128i sign = _mm_slli_epi32(_mm_xor_si128(halves, exponentMantissa), 16);
+			const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), _mm_set1_ps(0x1p112f));
+			const __m128i infNan = _mm_and_si128(_mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7bff)), _mm_set1_epi32(255 << 23));
+			return _mm_or_ps(_mm_or_ps(scaled, _mm_castsi128_ps(infNan)), _mm_castsi128_ps(sign));
+		}
+
+		template<Tonemap Curve>
+		void DevelopRowFloatSSE2(const void* source, std::size_t pixels, std::uint8_t* output, const DevelopParams& params)
+		{
+			const auto* in = static_cast<const float*>(source);
+			auto* out = reinterpret_cast<std::uint32_t*>(output);
+			for (std::size_t i = 0; i < pixels; ++i)
+				out[i] = DevelopPixel<Curve>(_mm_loadu_ps(in + i * 4), params);
+		}
+
+		template<Tonemap Curve>
+		void DevelopRowHalfSSE2(const void* source, std::size_t pixels, std::uint8_t* output, const DevelopParams& params)
+		{
+			const auto* in = static_cast<const std::uint16_t*>(source);
+			auto* out = reinterpret_cast<std::uint32_t*>(output);
+			for (std::size_t i = 0; i < pixels; ++i)
+				out[i] = DevelopPixel<Curve>(LoadHalf4(in + i * 4), params);
+		}
+
+#ifdef RAY_FILM_F16C
+		template<Tonemap Curve>
+		__attribute__((target("f16c"))) void DevelopRowHalfF16C(const void* source, std::size_t pixels, std::uint8_t* output, const DevelopParams& params)
+		{
+			const auto* in = static_cast<const std::uint16_t*>(source);
+			auto* out = reinterpret_cast<std::uint32_t*>(output);
+			for (std::size_t i = 0; i < pixels; ++i)
+				out[i] = DevelopPixel<Curve>(_mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i * 4))), params);
+		}
+
+		bool HasF16C() noexcept
+		{
+			static const bool s_HasF16C = __builtin_cpu_supports("f16c");
+			return s_HasF16C;
+		}
+#endif
+#endif
+
+		template<Tonemap Curve>
+		RowKernel SelectKernel(FilmFormat format, bool simd) noexcept
+		{
+#ifdef RAY_FILM_SSE2
+			if (simd)
+			{
+				if (format == FilmFormat::RGBA32F)
+					return &DevelopRowFloatSSE2<Curve>;
+#ifdef RAY_FILM_F16C
+				if (HasF16C())
+					return &DevelopRowHalfF16C<Curve>;
+#endif
+				return &DevelopRowHalfSSE2<Curve>;
+			}
+#endif
+			(void)simd;
+			return format == FilmFormat::RGBA32F ? &DevelopRowScalar<Curve, false> : &DevelopRowScalar<Curve, true>;
+		}
+	}
+
+	const char* ToString(FilmFormat format) noexcept
+	{
+		switch (format)
+		{
+		case FilmFormat::RGBA32F: return "RGBA32F";
+		case FilmFormat::RGBA16F: return "RGBA16F";
+		default:                  return "Unknown";
+		}
+	}
+
+	const char* ToString(Tonemap tonemap) noexcept
+	{
+		switch (tonemap)
+		{
+		case Tonemap::Clamp:    return "Clamp";
+		case Tonemap::Reinhard: return "Reinhard";
+		case Tonemap::ACES:     return "ACES";
+		default:                return "Unknown";
+		}
+	}
+
+	Film::Film(std::uint32_t width, std::uint32_t height, FilmFormat format)
+		: m_Width(width), m_Height(height), m_Format(format)
+	{
+		const std::size_t values = static_cast<std::size_t>(width) * height * 4;
+		if (format == FilmFormat::RGBA32F)
+			m_Float.assign(values, 0.0f);
+		else
+			m_Half.assign(values, 0);
+	}
+
+	void Film::Clear() noexcept
+	{
+		std::fill(m_Float.begin(), m_Float.end(), 0.0f);
+		std::fill(m_Half.begin(), m_Half.end(), std::uint16_t{ 0 });
+	}
+
+	void Film::AddSample(std::uint32_t x, std::uint32_t y, const Vec3& radiance) noexcept
+	{
+		const std::size_t index = GetPixelIndex(x, y);
+		if (m_Format == FilmFormat::RGBA32F)
+		{
+			float* pixel = m_Float.data() + index;
+			const float count = pixel[3] + 1.0f;
+			const float weight = 1.0f / count;
+			for (int channel = 0; channel < 3; ++channel)
+				pixel[channel] += (radiance[channel] - pixel[channel]) * weight;
+			pixel[3] = count;
+			return;
+		}
+
+		std::uint16_t* pixel = m_Half.data() + index;
+		const float count = HalfToFloat(pixel[3]) + 1.0f;
+		const float weight = 1.0f / count;
+		for (int channel = 0; channel < 3; ++channel)
+		{
+			const float mean = HalfToFloat(pixel[channel]);
+			pixel[channel] = FloatToHalf(mean + (radiance[channel] - mean) * weight);
+		}
+		pixel[3] = FloatToHalf(count);
+	}
+
+	Vec3 Film::GetPixel(std::uint32_t x, std::uint32_t y) const noexcept
+	{
+		const std::size_t index = GetPixelIndex(x, y);
+		if (m_Format == FilmFormat::RGBA32F)
+			return { m_Float[index], m_Float[index + 1], m_Float[index + 2] };
+		return { HalfToFloat(m_Half[index]), HalfToFloat(m_Half[index + 1]), HalfToFloat(m_Half[index + 2]) };
+	}
+
+	float Film::GetSampleCount(std::uint32_t x, std::uint32_t y) const noexcept
+	{
+		const std::size_t index = GetPixelIndex(x, y) + 3;
+		return m_Format == FilmFormat::RGBA32F ? m_Float[index] : HalfToFloat(m_Half[index]);
+	}
+
+	bool Film::Develop(const FilmDevelopSettings& settings, std::span<std::uint8_t> output, ThreadPool* pool) const
+	{
+		const std::size_t pixelCount = static_cast<std::size_t>(m_Width) * m_Height;
+		if (output.size() < pixelCount * 4)
+			return false;
+
+		const DevelopParams params{ std::exp2(settings.ExposureEV), 1.0f / settings.Gamma };
+		const bool simd = settings.Kernel != FilmKernel::Scalar;
+		RowKernel kernel = nullptr;
+		switch (settings.Curve)
+		{
+		case Tonemap::Clamp:    kernel = SelectKernel<Tonemap::Clamp>(m_Format, simd); break;
+		case Tonemap::Reinhard: kernel = SelectKernel<Tonemap::Reinhard>(m_Format, simd); break;
+		case Tonemap::ACES:
+		default:                kernel = SelectKernel<Tonemap::ACES>(m_Format, simd); break;
+		}
+
+		const std::size_t valueSize = m_Format == FilmFormat::RGBA32F ? sizeof(float) : sizeof(std::uint16_t);
+		const auto* source = m_Format == FilmFormat::RGBA32F ? static_cast<const void*>(m_Float.data()) : static_cast<const void*>(m_Half.data());
+		const std::size_t bands = (m_Height + rowsPerBand - 1) / rowsPerBand;
+		ParallelFor(pool, bands, [&](std::size_t band) {
+			const std::size_t firstRow = band * rowsPerBand;
+			const std::size_t rows = std::min<std::size_t>(rowsPerBand, m_Height - firstRow);
+			const std::size_t firstPixel = firstRow * m_Width;
+			kernel(static_cast<const std::byte*>(source) + firstPixel * 4 * valueSize, rows * m_Width, output.data() + firstPixel * 4, params);
+		});
+		return true;
+	}
+
+	std::size_t Film::GetMemoryBytes() const noexcept
+	{
+		return m_Float.size() * sizeof(float) + m_Half.size() * sizeof(std::uint16_t);
+	}
+
+	const char* Film::GetSIMDKernelName() noexcept
+	{
+#if defined(RAY_FILM_F16C)
+		return HasF16C() ? "sse2+f16c" : "sse2";
+#elif defined(RAY_FILM_SSE2)
+		return "sse2";
+#else
+		return "scalar";
+#endif
+	}
+}
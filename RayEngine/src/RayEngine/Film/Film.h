@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "RayEngine/Geometry/Math.h"
+
+namespace RayEngine
+{
+	class ThreadPool;
+
+	enum class FilmFormat : std::uint8_t
+	{
+		RGBA32F, // 16 bytes per pixel
+		RGBA16F  // 8 bytes per pixel: half the memory, ~3 significant digits per channel
+	};
+
+	enum class Tonemap : std::uint8_t
+	{
+		Clamp,
+		Reinhard,
+		ACES // Narkowicz's fit of the ACES filmic curve
+	};
+
+	enum class FilmKernel : std::uint8_t
+	{
+		Auto,   // best available: SIMD where supported
+		Scalar, // exact std::pow reference path
+		SIMD
+	};
+
+	[[nodiscard]] const char* ToString(FilmFormat format) noexcept;
+	[[nodiscard]] const char* ToString(Tonemap tonemap) noexcept;
+
+	struct FilmDevelopSettings
+	{
+		float ExposureEV = 0.0f; // linear scale 2^ExposureEV
+		Tonemap Curve = Tonemap::ACES;
+		float Gamma = 2.2f;
+		FilmKernel Kernel = FilmKernel::Auto;
+	};
+
+	// Accumulation framebuffer. Every pixel keeps the running mean of its samples in RGB and
+	// the sample count in A, so both formats develop the same way.
+	// - AddSample is not synchronized: render threads must own disjoint pixels (e.g. tiles).
+	// - With RGBA16F the count is exact up to 2048 samples; beyond that the mean turns into a
+	//   1/2048 moving average, which is fine for display but not for reference renders.
+	// - Develop (exposure, tonemap, gamma, 8-bit quantization) runs over row bands on the given
+	//   ThreadPool plus the calling thread.
+	class Film
+	{
+	public:
+		static constexpr std::uint32_t rowsPerBand = 16;
+
+		Film(std::uint32_t width, std::uint32_t height, FilmFormat format = FilmFormat::RGBA32F);
+
+		void Clear() noexcept;
+		void AddSample(std::uint32_t x, std::uint32_t y, const Vec3& radiance) noexcept;
+		[[nodiscard]] Vec3 GetPixel(std::uint32_t x, std::uint32_t y) const noexcept;
+		[[nodiscard]] float GetSampleCount(std::uint32_t x, std::uint32_t y) const noexcept;
+
+		// Writes width * height RGBA8 pixels (alpha 255) into `output`, which must be large enough.
+		// Returns false if it is not.
+		bool Develop(const FilmDevelopSettings& settings, std::span<std::uint8_t> output, ThreadPool* pool = nullptr) const;
+
+		[[nodiscard]] std::uint32_t GetWidth() const noexcept { return m_Width; }
+		[[nodiscard]] std::uint32_t GetHeight() const noexcept { return m_Height; }
+		[[nodiscard]] FilmFormat GetFormat() const noexcept { return m_Format; }
+		[[nodiscard]] std::size_t GetMemoryBytes() const noexcept;
+
+		// Name of the kernel FilmKernel::Auto resolves to on this CPU ("sse2+f16c", "sse2", "scalar").
+		[[nodiscard]] static const char* GetSIMDKernelName() noexcept;
+
+	private:
+		[[nodiscard]] std::size_t GetPixelIndex(std::uint32_t x, std::uint32_t y) const noexcept
+		{
+			return (static_cast<std::size_t>(y) * m_Width + x) * 4;
+		}
+
+	private:
+		std::uint32_t m_Width;
+		std::uint32_t m_Height;
+		FilmFormat m_Format;
+		std::vector<float> m_Float;
+		std::vector<std::uint16_t> m_Half;
+	};
+}
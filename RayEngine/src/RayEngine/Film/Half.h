@@ -0,0 +1,49 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace RayEngine
+{
+	// IEEE 754 binary16 conversions in portable integer code (after Fabian Giesen's
+	// float_to_half_fast3_rtne / magic-multiply half_to_float). Round to nearest even,
+	// overflow to infinity, NaN preserved, subnormals handled.
+	[[nodiscard]] inline std::uint16_t FloatToHalf(float value) noexcept
+	{
+		constexpr std::uint32_t infinityBits = 255u << 23;
+		constexpr std::uint32_t halfOverflowBits = (127u + 16u) << 23;              // 65536.0f
+		constexpr std::uint32_t denormMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+		std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+		const std::uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		std::uint32_t result;
+		if (bits >= halfOverflowBits)
+		{
+			result = bits > infinityBits ? 0x7e00u : 0x7c00u;
+		}
+		else if (bits < (113u << 23)) // half subnormal or zero
+		{
+			const float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagicBits);
+			result = std::bit_cast<std::uint32_t>(aligned) - denormMagicBits;
+		}
+		else
+		{
+			const std::uint32_t mantissaOdd = (bits >> 13) & 1u;
+			bits += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xfffu + mantissaOdd;
+			result = bits >> 13;
+		}
+		return static_cast<std::uint16_t>(result | (sign >> 16));
+	}
+
+	[[nodiscard]] inline float HalfToFloat(std::uint16_t half) noexcept
+	{
+		constexpr float magic = 0x1p112f; // 2^(127 - 15): rebias exponent, renormalize subnormals
+		const std::uint32_t exponentMantissa = half & 0x7fffu;
+		std::uint32_t bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(exponentMantissa << 13) * magic);
+		if (exponentMantissa > 0x7bffu)
+			bits |= 255u << 23; // infinity / NaN
+		return std::bit_cast<float>(bits | (static_cast<std::uint32_t>(half & 0x8000u) << 16));
+	}
+}
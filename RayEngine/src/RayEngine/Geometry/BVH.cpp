@@ -0,0 +1,186 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <numeric>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr float traversalCost = 1.0f;
+	}
+
+	BVH::BVH(const TriangleMesh& mesh)
+		: m_Mesh(&mesh)
+	{
+		Build();
+	}
+
+	void BVH::Build()
+	{
+		const std::size_t triangleCount = m_Mesh->GetTriangleCount();
+		m_Nodes.clear();
+		m_TriangleOrder.resize(triangleCount);
+		std::iota(m_TriangleOrder.begin(), m_TriangleOrder.end(), 0u);
+		if (triangleCount == 0)
+			return;
+
+		std::vector<AABB> triangleBounds(triangleCount);
+		std::vector<Vec3> centroids(triangleCount);
+		for (std::size_t i = 0; i < triangleCount; ++i)
+		{
+			triangleBounds[i] = m_Mesh->GetTriangleBounds(i);
+			centroids[i] = triangleBounds[i].GetCentroid();
+		}
+
+		m_Nodes.reserve(2 * triangleCount / maxLeafSize + 1);
+		m_Nodes.push_back(BVHNode{ {}, 0, static_cast<std::uint32_t>(triangleCount) });
+
+		struct Pending
+		{
+			std::uint32_t Node;
+			std::uint32_t Depth;
+		};
+		std::vector<Pending> pending{ { 0, 0 } };
+		while (!pending.empty())
+		{
+			const auto [nodeIndex, depth] = pending.back();
+			pending.pop_back();
+
+			BVHNode& node = m_Nodes[nodeIndex];
+			for (std::uint32_t i = node.First; i < node.First + node.Count; ++i)
+				node.Bounds.Grow(triangleBounds[m_TriangleOrder[i]]);
+
+			const std::uint32_t left = Split(nodeIndex, depth, triangleBounds, centroids);
+			if (left != 0)
+			{
+				assert(depth + 1 <= maxDepth);
+				pending.push_back({ left, depth + 1 });
+				pending.push_back({ left + 1, depth + 1 });
+			}
+		}
+	}
+
+	// Partition a leaf with binned SAH (object median past sahDepthLimit); returns the index of the
+	// new left child, or 0 if it stays a leaf.
+	std::uint32_t BVH::Split(std::uint32_t nodeIndex, std::uint32_t depth, const std::vector<AABB>& triangleBounds, const std::vector<Vec3>& centroids)
+	{
+		const std::uint32_t first = m_Nodes[nodeIndex].First;
+		const std::uint32_t count = m_Nodes[nodeIndex].Count;
+		if (count <= 1)
+			return 0;
+
+		AABB centroidBounds;
+		for (std::uint32_t i = first; i < first + count; ++i)
+			centroidBounds.Grow(centroids[m_TriangleOrder[i]]);
+
+		const int axis = centroidBounds.GetLargestAxis();
+		const float axisMin = centroidBounds.Min[axis];
+		const float axisExtent = centroidBounds.Max[axis] - axisMin;
+
+		std::uint32_t* begin = m_TriangleOrder.data() + first;
+		std::uint32_t* end = begin + count;
+		std::uint32_t* middle = nullptr;
+
+		if (axisExtent > 0.0f && depth < sahDepthLimit)
+		{
+			struct Bin
+			{
+				AABB Bounds;
+				std::uint32_t Count = 0;
+			};
+			std::array<Bin, binCount> bins{};
+			const float binScale = binCount / axisExtent;
+			const auto binOf = [&](std::uint32_t triangle) {
+				return std::min(binCount - 1, static_cast<std::uint32_t>((centroids[triangle][axis] - axisMin) * binScale));
+			};
+			for (std::uint32_t* it = begin; it != end; ++it)
+			{
+				Bin& bin = bins[binOf(*it)];
+				bin.Bounds.Grow(triangleBounds[*it]);
+				bin.Count++;
+			}
+
+			// Sweep from the right to get the area/count of every right-hand side, then from the left.
+			std::array<float, binCount> rightArea{};
+			std::array<std::uint32_t, binCount> rightCount{};
+			AABB accumulated;
+			std::uint32_t accumulatedCount = 0;
+			for (std::uint32_t i = binCount - 1; i > 0; --i)
+			{
+				accumulated.Grow(bins[i].Bounds);
+				accumulatedCount += bins[i].Count;
+				rightArea[i] = accumulated.GetSurfaceArea();
+				rightCount[i] = accumulatedCount;
+			}
+
+			float bestCost = std::numeric_limits<float>::infinity();
+			std::uint32_t bestSplit = 0;
+			accumulated = {};
+			accumulatedCount = 0;
+			for (std::uint32_t i = 1; i < binCount; ++i)
+			{
+				accumulated.Grow(bins[i - 1].Bounds);
+				accumulatedCount += bins[i - 1].Count;
+				if (accumulatedCount == 0 || rightCount[i] == 0)
+					continue;
+				const float cost = accumulated.GetSurfaceArea() * accumulatedCount + rightArea[i] * rightCount[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			// SAH with unit intersection cost: splitting pays one traversal step on top of its children.
+			const float parentArea = m_Nodes[nodeIndex].Bounds.GetSurfaceArea();
+			const float splitCost = traversalCost + (parentArea > 0.0f ? bestCost / parentArea : 0.0f);
+			if (bestSplit != 0 && (splitCost < static_cast<float>(count) || count > maxLeafSize))
+				middle = std::partition(begin, end, [&](std::uint32_t triangle) { return binOf(triangle) < bestSplit; });
+		}
+
+		if (!middle)
+		{
+			if (count <= maxLeafSize)
+				return 0;
+			// Coincident centroids, or too deep for SAH: fall back to an object median.
+			middle = begin + count / 2;
+			std::nth_element(begin, middle, end, [&](std::uint32_t a, std::uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+		}
+
+		const auto leftCount = static_cast<std::uint32_t>(middle - begin);
+		const auto left = static_cast<std::uint32_t>(m_Nodes.size());
+		m_Nodes.push_back(BVHNode{ {}, first, leftCount });
+		m_Nodes.push_back(BVHNode{ {}, first + leftCount, count - leftCount });
+		m_Nodes[nodeIndex].First = left;
+		m_Nodes[nodeIndex].Count = 0;
+		return left;
+	}
+
+	Hit BVH::Intersect(const Ray& ray) const noexcept
+	{
+		Hit hit;
+		hit.T = ray.TMax;
+		const std::vector<Vec3>& positions = m_Mesh->Positions;
+		const std::vector<std::uint32_t>& indices = m_Mesh->Indices;
+		TraverseBVH(m_Nodes, ray, hit, [&](const BVHNode& leaf) {
+			for (std::uint32_t i = leaf.First; i < leaf.First + leaf.Count; ++i)
+			{
+				const std::uint32_t triangle = m_TriangleOrder[i];
+				const std::uint32_t* corner = indices.data() + 3 * static_cast<std::size_t>(triangle);
+				IntersectTriangle(ray, positions[corner[0]], positions[corner[1]], positions[corner[2]], triangle, hit);
+			}
+		});
+
+		if (!hit.IsHit())
+			hit.T = std::numeric_limits<float>::infinity();
+		return hit;
+	}
+
+	std::size_t BVH::GetMemoryBytes() const noexcept
+	{
+		return m_Nodes.size() * sizeof(BVHNode) + m_TriangleOrder.size() * sizeof(std::uint32_t) + m_Mesh->GetMemoryBytes();
+	}
+}
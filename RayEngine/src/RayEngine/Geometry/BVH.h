@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Ray.h"
+#include "TriangleMesh.h"
+
+namespace RayEngine
+{
+	// Full-precision binary BVH node (32 bytes). Count == 0: internal node whose children are
+	// First and First + 1. Count > 0: leaf over GetTriangleOrder()[First .. First + Count).
+	struct BVHNode
+	{
+		AABB Bounds;
+		std::uint32_t First = 0;
+		std::uint32_t Count = 0;
+
+		[[nodiscard]] bool IsLeaf() const noexcept { return Count != 0; }
+	};
+
+	// Binary BVH over a TriangleMesh with float32 bounds, built with binned SAH.
+	// This is the reference layout; CompressedWideBVH is built from it. The mesh is referenced,
+	// not copied, and must outlive the BVH.
+	class BVH
+	{
+	public:
+		static constexpr std::uint32_t maxLeafSize = 4;
+		static constexpr std::uint32_t binCount = 16;
+		// SAH splits stop at this depth; deeper ranges take object medians, which halve a range of
+		// at most 2^32 triangles, so no leaf is deeper than maxDepth. Traversal stacks are sized by it.
+		static constexpr std::uint32_t sahDepthLimit = 32;
+		static constexpr std::uint32_t maxDepth = sahDepthLimit + 32;
+
+		explicit BVH(const TriangleMesh& mesh);
+
+		[[nodiscard]] Hit Intersect(const Ray& ray) const noexcept;
+
+		[[nodiscard]] const TriangleMesh& GetMesh() const noexcept { return *m_Mesh; }
+		[[nodiscard]] const std::vector<BVHNode>& GetNodes() const noexcept { return m_Nodes; }
+		[[nodiscard]] const std::vector<std::uint32_t>& GetTriangleOrder() const noexcept { return m_TriangleOrder; }
+		[[nodiscard]] AABB GetBounds() const noexcept { return m_Nodes.empty() ? AABB{} : m_Nodes.front().Bounds; }
+
+		// Nodes + triangle order + the mesh's positions and 32-bit indices.
+		[[nodiscard]] std::size_t GetMemoryBytes() const noexcept;
+
+	private:
+		void Build();
+		[[nodiscard]] std::uint32_t Split(std::uint32_t nodeIndex, std::uint32_t depth, const std::vector<AABB>& triangleBounds, const std::vector<Vec3>& centroids);
+
+	private:
+		const TriangleMesh* m_Mesh;
+		std::vector<BVHNode> m_Nodes;
+		std::vector<std::uint32_t> m_TriangleOrder;
+	};
+
+	// Front-to-back walk over a binary BVH in the BVHNode layout, shared by BVH, ClusterView and
+	// the StreamingGeometry top level. Calls visitLeaf(node) for every leaf whose box the ray
+	// enters in (ray.TMin, hit.T); the visitor updates `hit`, and later boxes are culled against
+	// the new hit.T. The tree must be no deeper than BVH::maxDepth, which every tree built by
+	// BVH (or by object medians over at most 2^32 items) satisfies.
+	template<typename LeafVisitor>
+	void TraverseBVH(std::span<const BVHNode> nodes, const Ray& ray, Hit& hit, LeafVisitor&& visitLeaf) noexcept
+	{
+		if (nodes.empty())
+			return;
+
+		constexpr float miss = std::numeric_limits<float>::infinity();
+		const Vec3 inverseDirection{ 1.0f / ray.Direction.X, 1.0f / ray.Direction.Y, 1.0f / ray.Direction.Z };
+		if (IntersectBox(ray.Origin, inverseDirection, nodes[0].Bounds.Min, nodes[0].Bounds.Max, ray.TMin, hit.T) == miss)
+			return;
+
+		// Each internal node on the path to a leaf pushes at most one entry.
+		std::array<std::uint32_t, BVH::maxDepth> stack;
+		std::size_t stackSize = 0;
+		std::uint32_t nodeIndex = 0;
+		for (;;)
+		{
+			const BVHNode& node = nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				visitLeaf(node);
+			}
+			else
+			{
+				const BVHNode& left = nodes[node.First];
+				const BVHNode& right = nodes[node.First + 1];
+				float tLeft = IntersectBox(ray.Origin, inverseDirection, left.Bounds.Min, left.Bounds.Max, ray.TMin, hit.T);
+				float tRight = IntersectBox(ray.Origin, inverseDirection, right.Bounds.Min, right.Bounds.Max, ray.TMin, hit.T);
+				std::uint32_t nearChild = node.First;
+				std::uint32_t farChild = node.First + 1;
+				if (tRight < tLeft)
+				{
+					std::swap(tLeft, tRight);
+					std::swap(nearChild, farChild);
+				}
+
+				if (tLeft != miss)
+				{
+					if (tRight != miss)
+					{
+						assert(stackSize < stack.size() && "BVH traversal stack overflow");
+						stack[stackSize++] = farChild;
+					}
+					nodeIndex = nearChild;
+					continue;
+				}
+			}
+
+			if (stackSize == 0)
+				break;
+			nodeIndex = stack[--stackSize];
+		}
+	}
+}
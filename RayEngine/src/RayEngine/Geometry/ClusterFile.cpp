@@ -0,0 +1,185 @@
+#include "ClusterFile.h"
+#include "RayEngine/Core/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <fstream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::uint32_t unmapped = std::numeric_limits<std::uint32_t>::max();
+
+		template<typename T>
+		[[nodiscard]] std::span<const T> TakeSpan(std::span<const std::byte>& blob, std::size_t count) noexcept
+		{
+			const auto* data = reinterpret_cast<const T*>(blob.data());
+			blob = blob.subspan(count * sizeof(T));
+			return { data, count };
+		}
+	}
+
+	bool WriteClusterFile(const TriangleMesh& mesh, const std::filesystem::path& path, std::uint32_t trianglesPerCluster)
+	{
+		const std::size_t triangleCount = mesh.GetTriangleCount();
+		if (trianglesPerCluster == 0 || triangleCount == 0 || triangleCount > unmapped)
+		{
+			RAY_CORE_ERROR("[ClusterFile] cannot cluster {} triangles into groups of {}", triangleCount, trianglesPerCluster);
+			return false;
+		}
+
+		// Object-median splits keep clusters compact and about equally sized.
+		std::vector<Vec3> centroids(triangleCount);
+		for (std::size_t i = 0; i < triangleCount; ++i)
+			centroids[i] = mesh.GetTriangleBounds(i).GetCentroid();
+		std::vector<std::uint32_t> order(triangleCount);
+		std::iota(order.begin(), order.end(), 0u);
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> ranges;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pending{ { 0u, static_cast<std::uint32_t>(triangleCount) } };
+		while (!pending.empty())
+		{
+			const auto [begin, end] = pending.back();
+			pending.pop_back();
+			if (end - begin <= trianglesPerCluster)
+			{
+				ranges.emplace_back(begin, end);
+				continue;
+			}
+
+			AABB centroidBounds;
+			for (std::uint32_t i = begin; i < end; ++i)
+				centroidBounds.Grow(centroids[order[i]]);
+			const int axis = centroidBounds.GetLargestAxis();
+			const std::uint32_t middle = begin + (end - begin) / 2;
+			std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+				[&](std::uint32_t a, std::uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+			// Right first, so clusters are written in left-to-right spatial order.
+			pending.emplace_back(middle, end);
+			pending.emplace_back(begin, middle);
+		}
+
+		// Write to a temporary name and rename, so readers never see a partial file.
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+		std::vector<ClusterRecord> records;
+		records.reserve(ranges.size());
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			std::uint64_t offset = 0;
+			const auto write = [&](const void* data, std::size_t bytes) {
+				file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+				offset += bytes;
+			};
+			const auto pad = [&] {
+				static constexpr std::array<char, clusterFileAlignment> zeros{};
+				write(zeros.data(), (clusterFileAlignment - offset % clusterFileAlignment) % clusterFileAlignment);
+			};
+
+			ClusterFileHeader header;
+			write(&header, sizeof(header));
+
+			std::vector<std::uint32_t> remap(mesh.Positions.size(), unmapped);
+			TriangleMesh local;
+			std::vector<std::uint32_t> sourceTriangles;
+			for (const auto& [begin, end] : ranges)
+			{
+				local.Positions.clear();
+				local.Indices.clear();
+				sourceTriangles.assign(order.begin() + begin, order.begin() + end);
+				for (const std::uint32_t triangle : sourceTriangles)
+				{
+					for (int corner = 0; corner < 3; ++corner)
+					{
+						const std::uint32_t vertex = mesh.Indices[3 * static_cast<std::size_t>(triangle) + corner];
+						if (remap[vertex] == unmapped)
+						{
+							remap[vertex] = static_cast<std::uint32_t>(local.Positions.size());
+							local.Positions.push_back(mesh.Positions[vertex]);
+						}
+						local.Indices.push_back(remap[vertex]);
+					}
+				}
+				for (const std::uint32_t triangle : sourceTriangles)
+				{
+					for (int corner = 0; corner < 3; ++corner)
+						remap[mesh.Indices[3 * static_cast<std::size_t>(triangle) + corner]] = unmapped;
+				}
+
+				const BVH bvh(local);
+				pad();
+				ClusterRecord record;
+				record.Bounds = bvh.GetBounds();
+				record.VertexCount = static_cast<std::uint32_t>(local.Positions.size());
+				record.TriangleCount = static_cast<std::uint32_t>(sourceTriangles.size());
+				record.NodeCount = static_cast<std::uint32_t>(bvh.GetNodes().size());
+				record.Offset = offset;
+				write(local.Positions.data(), local.Positions.size() * sizeof(Vec3));
+				write(local.Indices.data(), local.Indices.size() * sizeof(std::uint32_t));
+				write(bvh.GetNodes().data(), bvh.GetNodes().size() * sizeof(BVHNode));
+				write(bvh.GetTriangleOrder().data(), bvh.GetTriangleOrder().size() * sizeof(std::uint32_t));
+				write(sourceTriangles.data(), sourceTriangles.size() * sizeof(std::uint32_t));
+				record.Bytes = offset - record.Offset;
+				assert(record.Bytes == record.GetExpectedBytes());
+				records.push_back(record);
+			}
+
+			pad();
+			header.ClusterCount = static_cast<std::uint32_t>(records.size());
+			header.DirectoryOffset = offset;
+			header.TriangleCount = triangleCount;
+			write(records.data(), records.size() * sizeof(ClusterRecord));
+			file.seekp(0);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			if (!file)
+			{
+				RAY_CORE_ERROR("[ClusterFile] failed to write '{}'", temporary.string());
+				file.close();
+				std::error_code ec;
+				std::filesystem::remove(temporary, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temporary, path, ec);
+		if (ec)
+		{
+			RAY_CORE_ERROR("[ClusterFile] failed to publish '{}': {}", path.string(), ec.message());
+			std::filesystem::remove(temporary, ec);
+			return false;
+		}
+		return true;
+	}
+
+	ClusterView ClusterView::FromBlob(const ClusterRecord& record, std::span<const std::byte> blob) noexcept
+	{
+		assert(blob.size() >= record.GetExpectedBytes());
+		ClusterView view;
+		view.Positions = TakeSpan<Vec3>(blob, record.VertexCount);
+		view.Indices = TakeSpan<std::uint32_t>(blob, 3ull * record.TriangleCount);
+		view.Nodes = TakeSpan<BVHNode>(blob, record.NodeCount);
+		view.TriangleOrder = TakeSpan<std::uint32_t>(blob, record.TriangleCount);
+		view.SourceTriangles = TakeSpan<std::uint32_t>(blob, record.TriangleCount);
+		return view;
+	}
+
+	bool ClusterView::Intersect(const Ray& ray, Hit& hit) const noexcept
+	{
+		bool found = false;
+		TraverseBVH(Nodes, ray, hit, [&](const BVHNode& leaf) {
+			for (std::uint32_t i = leaf.First; i < leaf.First + leaf.Count; ++i)
+			{
+				const std::uint32_t triangle = TriangleOrder[i];
+				const std::uint32_t* corner = Indices.data() + 3 * static_cast<std::size_t>(triangle);
+				found |= IntersectTriangle(ray, Positions[corner[0]], Positions[corner[1]], Positions[corner[2]], SourceTriangles[triangle], hit);
+			}
+		});
+		return found;
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "BVH.h"
+
+namespace RayEngine
+{
+	// On-disk layout of a clustered mesh, for scenes that do not fit in memory:
+	//   ClusterFileHeader | cluster blobs (each starting on a clusterFileAlignment boundary) | ClusterRecord[ClusterCount]
+	// A blob is self-contained: positions, local indices, a BVH over the cluster, the BVH's
+	// triangle order and the source mesh index of every triangle, all in native byte order.
+	inline constexpr std::uint32_t clusterFileMagic = 0x314c4352; // "RCL1"
+	inline constexpr std::uint32_t clusterFileVersion = 1;
+	inline constexpr std::uint64_t clusterFileAlignment = 4096;
+
+	struct ClusterFileHeader
+	{
+		std::uint32_t Magic = clusterFileMagic;
+		std::uint32_t Version = clusterFileVersion;
+		std::uint32_t ClusterCount = 0;
+		std::uint32_t Reserved = 0;
+		std::uint64_t DirectoryOffset = 0;
+		std::uint64_t TriangleCount = 0;
+	};
+	static_assert(sizeof(ClusterFileHeader) == 32);
+
+	struct ClusterRecord
+	{
+		AABB Bounds;
+		std::uint32_t VertexCount = 0;
+		std::uint32_t TriangleCount = 0;
+		std::uint32_t NodeCount = 0;
+		std::uint32_t Reserved = 0;
+		std::uint64_t Offset = 0;
+		std::uint64_t Bytes = 0;
+
+		[[nodiscard]] std::uint64_t GetExpectedBytes() const noexcept
+		{
+			return VertexCount * sizeof(Vec3) + 3ull * TriangleCount * sizeof(std::uint32_t) + NodeCount * sizeof(BVHNode)
+				+ 2ull * TriangleCount * sizeof(std::uint32_t);
+		}
+	};
+	static_assert(sizeof(ClusterRecord) == 56);
+
+	// Splits `mesh` into spatially coherent clusters of at most `trianglesPerCluster` triangles
+	// (object-median splits along the largest centroid axis), builds a BVH per cluster and writes
+	// the file. Returns false and logs on failure.
+	bool WriteClusterFile(const TriangleMesh& mesh, const std::filesystem::path& path, std::uint32_t trianglesPerCluster = 8192);
+
+	// A loaded cluster blob, viewed in place.
+	struct ClusterView
+	{
+		std::span<const Vec3> Positions;
+		std::span<const std::uint32_t> Indices;
+		std::span<const BVHNode> Nodes;
+		std::span<const std::uint32_t> TriangleOrder;
+		std::span<const std::uint32_t> SourceTriangles;
+
+		// `blob` must hold record.Bytes bytes, aligned for float and uint32 access.
+		[[nodiscard]] static ClusterView FromBlob(const ClusterRecord& record, std::span<const std::byte> blob) noexcept;
+
+		// Updates `hit` if a triangle is hit in (ray.TMin, hit.T); Hit::Triangle is the source mesh index.
+		bool Intersect(const Ray& ray, Hit& hit) const noexcept;
+	};
+}
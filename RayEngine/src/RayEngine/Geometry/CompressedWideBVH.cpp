@@ -0,0 +1,276 @@
+#include "CompressedWideBVH.h"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace RayEngine
+{
+	namespace
+	{
+		static_assert(BVH::maxLeafSize <= std::numeric_limits<std::uint8_t>::max(), "leaf counts are stored in 8 bits");
+
+		constexpr std::uint32_t noVertex = std::numeric_limits<std::uint32_t>::max();
+		// Every wide node collapses at least one binary level, so the wide tree is no deeper than
+		// the binary one; each level leaves at most Width - 1 siblings on the stack.
+		constexpr std::size_t traversalStackDepth = BVH::maxDepth;
+
+		// 2^exponent, built directly from the exponent bits (exponent in [-126, 127]).
+		[[nodiscard]] inline float ExponentScale(std::int8_t exponent) noexcept
+		{
+			return std::bit_cast<float>(static_cast<std::uint32_t>(exponent + 127) << 23);
+		}
+
+		[[nodiscard]] inline float Dequantize(float origin, std::uint8_t q, float scale) noexcept
+		{
+			return origin + static_cast<float>(q) * scale;
+		}
+
+		// Smallest power-of-two step such that 255 steps from `origin` reach `max`.
+		std::int8_t ChooseExponent(float origin, float max) noexcept
+		{
+			const float extent = max - origin;
+			int exponent = extent > 0.0f ? static_cast<int>(std::ceil(std::log2(extent / 255.0f))) : -126;
+			exponent = std::clamp(exponent, -126, 127);
+			while (exponent < 127 && Dequantize(origin, 255, ExponentScale(static_cast<std::int8_t>(exponent))) < max)
+				exponent++;
+			return static_cast<std::int8_t>(exponent);
+		}
+
+		// Outward rounding: the decoded interval always contains [min, max].
+		void Quantize(float origin, float scale, float min, float max, std::uint8_t& lo, std::uint8_t& hi) noexcept
+		{
+			int qLo = std::clamp(static_cast<int>(std::floor((min - origin) / scale)), 0, 255);
+			while (qLo > 0 && Dequantize(origin, static_cast<std::uint8_t>(qLo), scale) > min)
+				qLo--;
+			int qHi = std::clamp(static_cast<int>(std::ceil((max - origin) / scale)), 0, 255);
+			while (qHi < 255 && Dequantize(origin, static_cast<std::uint8_t>(qHi), scale) < max)
+				qHi++;
+			lo = static_cast<std::uint8_t>(qLo);
+			hi = static_cast<std::uint8_t>(qHi);
+		}
+	}
+
+	template<std::uint32_t Width>
+	CompressedWideBVH<Width>::CompressedWideBVH(const BVH& bvh)
+	{
+		const std::vector<BVHNode>& nodes = bvh.GetNodes();
+		const std::vector<std::uint32_t>& order = bvh.GetTriangleOrder();
+		const TriangleMesh& mesh = bvh.GetMesh();
+		if (nodes.empty())
+			return;
+
+		m_Nodes.reserve(nodes.size() / (Width - 1) + 1);
+		m_Positions.reserve(mesh.Positions.size());
+		m_Indices.reserve(order.size());
+		m_TriangleIds.reserve(order.size());
+		std::vector<std::uint32_t> remap(mesh.Positions.size(), noVertex);
+
+		// Internal children of a node get consecutive indices when the node is emitted, but nodes
+		// are processed depth-first so triangles (and the vertices they pull in) come out in
+		// spatial order, which keeps most index offsets inside 16 bits.
+		struct Pending
+		{
+			std::uint32_t Wide;
+			std::uint32_t Binary;
+		};
+		std::vector<Pending> pendingNodes{ { 0, 0 } };
+		m_Nodes.emplace_back();
+
+		while (!pendingNodes.empty())
+		{
+			const Pending pending = pendingNodes.back();
+			pendingNodes.pop_back();
+
+			// Collapse: keep opening the internal child with the largest surface area.
+			std::array<std::uint32_t, Width> children{};
+			std::uint32_t childCount = 0;
+			const BVHNode& binary = nodes[pending.Binary];
+			if (binary.IsLeaf())
+			{
+				children[childCount++] = pending.Binary;
+			}
+			else
+			{
+				children[childCount++] = binary.First;
+				children[childCount++] = binary.First + 1;
+				while (childCount < Width)
+				{
+					std::uint32_t best = Width;
+					float bestArea = -1.0f;
+					for (std::uint32_t i = 0; i < childCount; ++i)
+					{
+						const BVHNode& child = nodes[children[i]];
+						if (!child.IsLeaf() && child.Bounds.GetSurfaceArea() > bestArea)
+						{
+							best = i;
+							bestArea = child.Bounds.GetSurfaceArea();
+						}
+					}
+					if (best == Width)
+						break;
+					const std::uint32_t opened = children[best];
+					children[best] = nodes[opened].First;
+					children[childCount++] = nodes[opened].First + 1;
+				}
+			}
+
+			AABB bounds;
+			for (std::uint32_t i = 0; i < childCount; ++i)
+				bounds.Grow(nodes[children[i]].Bounds);
+
+			Node node{};
+			node.ChildBase = static_cast<std::uint32_t>(m_Nodes.size());
+			node.TriangleBase = static_cast<std::uint32_t>(m_Indices.size());
+			node.VertexBase = static_cast<std::uint32_t>(m_Positions.size());
+			float scale[3];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				node.Origin[axis] = bounds.Min[axis];
+				node.Exponent[axis] = ChooseExponent(bounds.Min[axis], bounds.Max[axis]);
+				scale[axis] = ExponentScale(node.Exponent[axis]);
+			}
+
+			std::array<std::uint32_t, Width> internalChildren{};
+			std::uint32_t internalCount = 0;
+			for (std::uint32_t i = 0; i < childCount; ++i)
+			{
+				const BVHNode& child = nodes[children[i]];
+				for (int axis = 0; axis < 3; ++axis)
+					Quantize(node.Origin[axis], scale[axis], child.Bounds.Min[axis], child.Bounds.Max[axis], node.Lo[axis][i], node.Hi[axis][i]);
+
+				if (!child.IsLeaf())
+				{
+					node.InternalMask |= static_cast<std::uint8_t>(1u << i);
+					internalChildren[internalCount++] = children[i];
+					continue;
+				}
+
+				node.Counts[i] = static_cast<std::uint8_t>(child.Count);
+				for (std::uint32_t t = child.First; t < child.First + child.Count; ++t)
+				{
+					const std::uint32_t triangle = order[t];
+					std::array<std::int16_t, 3> compressed{};
+					for (int corner = 0; corner < 3; ++corner)
+					{
+						const std::uint32_t source = mesh.Indices[3 * static_cast<std::size_t>(triangle) + corner];
+						std::int64_t offset = static_cast<std::int64_t>(remap[source]) - node.VertexBase;
+						if (remap[source] == noVertex || offset < std::numeric_limits<std::int16_t>::min() || offset > std::numeric_limits<std::int16_t>::max())
+						{
+							m_DuplicatedVertices += remap[source] != noVertex;
+							remap[source] = static_cast<std::uint32_t>(m_Positions.size());
+							m_Positions.push_back(mesh.Positions[source]);
+							offset = static_cast<std::int64_t>(remap[source]) - node.VertexBase;
+						}
+						compressed[corner] = static_cast<std::int16_t>(offset);
+					}
+					m_Indices.push_back(compressed);
+					m_TriangleIds.push_back(triangle);
+				}
+			}
+
+			m_Nodes.resize(m_Nodes.size() + internalCount);
+			m_Nodes[pending.Wide] = node;
+			for (std::uint32_t i = internalCount; i-- > 0;)
+				pendingNodes.push_back({ node.ChildBase + i, internalChildren[i] });
+		}
+
+		m_Nodes.shrink_to_fit();
+		m_Positions.shrink_to_fit();
+	}
+
+	template<std::uint32_t Width>
+	Hit CompressedWideBVH<Width>::Intersect(const Ray& ray) const noexcept
+	{
+		Hit hit;
+		hit.T = ray.TMax;
+		if (m_Nodes.empty())
+			return hit;
+
+		const Vec3 inverseDirection{ 1.0f / ray.Direction.X, 1.0f / ray.Direction.Y, 1.0f / ray.Direction.Z };
+
+		struct Entry
+		{
+			float T;
+			std::uint32_t Node;
+		};
+		std::array<Entry, traversalStackDepth * Width> stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = { ray.TMin, 0 };
+
+		while (stackSize != 0)
+		{
+			const Entry entry = stack[--stackSize];
+			if (entry.T > hit.T)
+				continue;
+
+			const Node& node = m_Nodes[entry.Node];
+			const float scale[3] = { ExponentScale(node.Exponent[0]), ExponentScale(node.Exponent[1]), ExponentScale(node.Exponent[2]) };
+
+			std::array<Entry, Width> hitChildren;
+			std::uint32_t hitCount = 0;
+			std::uint32_t internalIndex = 0;
+			std::uint32_t triangle = node.TriangleBase;
+			for (std::uint32_t i = 0; i < Width; ++i)
+			{
+				const bool internal = (node.InternalMask >> i) & 1u;
+				if (!internal && node.Counts[i] == 0)
+					continue;
+
+				// Decode the child box on the fly.
+				const Vec3 boxMin{ Dequantize(node.Origin[0], node.Lo[0][i], scale[0]), Dequantize(node.Origin[1], node.Lo[1][i], scale[1]),
+					Dequantize(node.Origin[2], node.Lo[2][i], scale[2]) };
+				const Vec3 boxMax{ Dequantize(node.Origin[0], node.Hi[0][i], scale[0]), Dequantize(node.Origin[1], node.Hi[1][i], scale[1]),
+					Dequantize(node.Origin[2], node.Hi[2][i], scale[2]) };
+				const float tNear = IntersectBox(ray.Origin, inverseDirection, boxMin, boxMax, ray.TMin, hit.T);
+
+				if (internal)
+				{
+					const std::uint32_t child = node.ChildBase + internalIndex++;
+					if (tNear == std::numeric_limits<float>::infinity())
+						continue;
+					// Insertion sort, farthest first, so the nearest child ends on top of the stack.
+					std::uint32_t slot = hitCount++;
+					while (slot > 0 && hitChildren[slot - 1].T < tNear)
+					{
+						hitChildren[slot] = hitChildren[slot - 1];
+						slot--;
+					}
+					hitChildren[slot] = { tNear, child };
+					continue;
+				}
+
+				const std::uint32_t end = triangle + node.Counts[i];
+				if (tNear != std::numeric_limits<float>::infinity())
+				{
+					for (std::uint32_t t = triangle; t < end; ++t)
+					{
+						const std::array<std::int16_t, 3>& corner = m_Indices[t];
+						IntersectTriangle(ray, m_Positions[node.VertexBase + corner[0]], m_Positions[node.VertexBase + corner[1]],
+							m_Positions[node.VertexBase + corner[2]], m_TriangleIds[t], hit);
+					}
+				}
+				triangle = end;
+			}
+
+			assert(stackSize + hitCount <= stack.size() && "CompressedWideBVH traversal stack overflow");
+			for (std::uint32_t i = 0; i < hitCount; ++i)
+				stack[stackSize++] = hitChildren[i];
+		}
+
+		if (!hit.IsHit())
+			hit.T = std::numeric_limits<float>::infinity();
+		return hit;
+	}
+
+	template<std::uint32_t Width>
+	std::size_t CompressedWideBVH<Width>::GetMemoryBytes() const noexcept
+	{
+		return m_Nodes.size() * sizeof(Node) + m_Positions.size() * sizeof(Vec3)
+			+ m_Indices.size() * sizeof(std::array<std::int16_t, 3>) + m_TriangleIds.size() * sizeof(std::uint32_t);
+	}
+
+	template class CompressedWideBVH<4>;
+	template class CompressedWideBVH<8>;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BVH.h"
+
+namespace RayEngine
+{
+	// Compact BVH for very large meshes: Width-ary nodes (4 or 8) with child bounds quantized
+	// to 8 bits per plane relative to the node, plus 16-bit triangle indices.
+	// - Child boxes are stored as Lo/Hi grid steps from Origin with a power-of-two step per axis,
+	//   rounded outwards, so decoded boxes always contain the true ones (traversal stays exact,
+	//   it just visits a few more nodes).
+	// - Vertices are reordered by first use in leaf order and every triangle stores int16 offsets
+	//   from its node's VertexBase; a vertex too far away is duplicated next to its user.
+	// - Positions stay float32 so hits (T, U, V) are bit-identical to the full-precision BVH.
+	// Hit::Triangle reports the source mesh triangle. The source mesh is not referenced after
+	// construction and can be freed.
+	template<std::uint32_t Width>
+	class CompressedWideBVH
+	{
+		static_assert(Width == 4 || Width == 8, "CompressedWideBVH supports 4- and 8-wide nodes");
+
+	public:
+		struct Node
+		{
+			float Origin[3];
+			std::int8_t Exponent[3];      // grid step of axis a is 2^Exponent[a]
+			std::uint8_t InternalMask;    // bit i: child i is a node (ChildBase + internal children before i)
+			std::uint32_t ChildBase;
+			std::uint32_t TriangleBase;   // leaf child i: Counts[i] triangles after those of children < i
+			std::uint32_t VertexBase;
+			std::uint8_t Counts[Width];   // triangles in leaf child i; 0 for nodes and empty slots
+			std::uint8_t Lo[3][Width];
+			std::uint8_t Hi[3][Width];
+		};
+
+		explicit CompressedWideBVH(const BVH& bvh);
+
+		[[nodiscard]] Hit Intersect(const Ray& ray) const noexcept;
+
+		[[nodiscard]] std::size_t GetNodeCount() const noexcept { return m_Nodes.size(); }
+		[[nodiscard]] std::size_t GetVertexCount() const noexcept { return m_Positions.size(); }
+		[[nodiscard]] std::size_t GetTriangleCount() const noexcept { return m_Indices.size(); }
+		// Vertices copied because their offset did not fit in 16 bits.
+		[[nodiscard]] std::size_t GetDuplicatedVertexCount() const noexcept { return m_DuplicatedVertices; }
+
+		// Nodes + positions + compressed indices + source triangle ids.
+		[[nodiscard]] std::size_t GetMemoryBytes() const noexcept;
+
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<Vec3> m_Positions;
+		std::vector<std::array<std::int16_t, 3>> m_Indices;
+		std::vector<std::uint32_t> m_TriangleIds;
+		std::size_t m_DuplicatedVertices = 0;
+	};
+
+	extern template class CompressedWideBVH<4>;
+	extern template class CompressedWideBVH<8>;
+
+	using CompressedBVH4 = CompressedWideBVH<4>;
+	using CompressedBVH8 = CompressedWideBVH<8>;
+}
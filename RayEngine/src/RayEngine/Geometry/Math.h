@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace RayEngine
+{
+	struct Vec2
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+	};
+
+	struct Vec3
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+		float Z = 0.0f;
+
+		[[nodiscard]] constexpr float operator[](int axis) const noexcept { return axis == 0 ? X : (axis == 1 ? Y : Z); }
+		[[nodiscard]] constexpr float& operator[](int axis) noexcept { return axis == 0 ? X : (axis == 1 ? Y : Z); }
+
+		constexpr Vec3& operator+=(const Vec3& other) noexcept { X += other.X; Y += other.Y; Z += other.Z; return *this; }
+		constexpr Vec3& operator-=(const Vec3& other) noexcept { X -= other.X; Y -= other.Y; Z -= other.Z; return *this; }
+		constexpr Vec3& operator*=(float s) noexcept { X *= s; Y *= s; Z *= s; return *this; }
+	};
+
+	[[nodiscard]] constexpr Vec3 operator+(Vec3 a, const Vec3& b) noexcept { return a += b; }
+	[[nodiscard]] constexpr Vec3 operator-(Vec3 a, const Vec3& b) noexcept { return a -= b; }
+	[[nodiscard]] constexpr Vec3 operator-(const Vec3& a) noexcept { return { -a.X, -a.Y, -a.Z }; }
+	[[nodiscard]] constexpr Vec3 operator*(Vec3 a, float s) noexcept { return a *= s; }
+	[[nodiscard]] constexpr Vec3 operator*(float s, Vec3 a) noexcept { return a *= s; }
+	[[nodiscard]] constexpr Vec3 operator*(const Vec3& a, const Vec3& b) noexcept { return { a.X * b.X, a.Y * b.Y, a.Z * b.Z }; }
+
+	[[nodiscard]] constexpr float Dot(const Vec3& a, const Vec3& b) noexcept { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+	[[nodiscard]] constexpr Vec3 Cross(const Vec3& a, const Vec3& b) noexcept
+	{
+		return { a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+	}
+	[[nodiscard]] inline float Length(const Vec3& v) noexcept { return std::sqrt(Dot(v, v)); }
+	[[nodiscard]] inline Vec3 Normalize(const Vec3& v) noexcept { return v * (1.0f / Length(v)); }
+	[[nodiscard]] constexpr Vec3 Min(const Vec3& a, const Vec3& b) noexcept { return { std::min(a.X, b.X), std::min(a.Y, b.Y), std::min(a.Z, b.Z) }; }
+	[[nodiscard]] constexpr Vec3 Max(const Vec3& a, const Vec3& b) noexcept { return { std::max(a.X, b.X), std::max(a.Y, b.Y), std::max(a.Z, b.Z) }; }
+
+	// Axis-aligned bounding box. Default constructed boxes are empty (Min > Max) and grow from there.
+	struct AABB
+	{
+		Vec3 Min{ std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+		Vec3 Max{ -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+		constexpr void Grow(const Vec3& point) noexcept { Min = RayEngine::Min(Min, point); Max = RayEngine::Max(Max, point); }
+		constexpr void Grow(const AABB& box) noexcept { Min = RayEngine::Min(Min, box.Min); Max = RayEngine::Max(Max, box.Max); }
+
+		[[nodiscard]] constexpr bool IsEmpty() const noexcept { return Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z; }
+		[[nodiscard]] constexpr Vec3 GetExtent() const noexcept { return Max - Min; }
+		[[nodiscard]] constexpr Vec3 GetCentroid() const noexcept { return (Min + Max) * 0.5f; }
+		[[nodiscard]] constexpr float GetSurfaceArea() const noexcept
+		{
+			if (IsEmpty())
+				return 0.0f;
+			const Vec3 e = GetExtent();
+			return 2.0f * (e.X * e.Y + e.Y * e.Z + e.Z * e.X);
+		}
+		[[nodiscard]] constexpr int GetLargestAxis() const noexcept
+		{
+			const Vec3 e = GetExtent();
+			return e.X >= e.Y && e.X >= e.Z ? 0 : (e.Y >= e.Z ? 1 : 2);
+		}
+	};
+}
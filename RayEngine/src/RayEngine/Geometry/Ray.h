@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "Math.h"
+
+namespace RayEngine
+{
+	struct Ray
+	{
+		Vec3 Origin;
+		Vec3 Direction;
+		float TMin = 0.0f;
+		float TMax = std::numeric_limits<float>::infinity();
+	};
+
+	struct Hit
+	{
+		static constexpr std::uint32_t invalidTriangle = std::numeric_limits<std::uint32_t>::max();
+
+		float T = std::numeric_limits<float>::infinity();
+		float U = 0.0f;
+		float V = 0.0f;
+		std::uint32_t Triangle = invalidTriangle; // index into the source mesh
+
+		[[nodiscard]] bool IsHit() const noexcept { return Triangle != invalidTriangle; }
+	};
+
+	// Moller-Trumbore. Updates `hit` and returns true if the triangle is hit in (ray.TMin, hit.T).
+	inline bool IntersectTriangle(const Ray& ray, const Vec3& v0, const Vec3& v1, const Vec3& v2, std::uint32_t triangle, Hit& hit) noexcept
+	{
+		constexpr float epsilon = 1e-9f;
+		const Vec3 e1 = v1 - v0;
+		const Vec3 e2 = v2 - v0;
+		const Vec3 p = Cross(ray.Direction, e2);
+		const float det = Dot(e1, p);
+		if (det > -epsilon && det < epsilon)
+			return false;
+
+		const float invDet = 1.0f / det;
+		const Vec3 s = ray.Origin - v0;
+		const float u = Dot(s, p) * invDet;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		const Vec3 q = Cross(s, e1);
+		const float v = Dot(ray.Direction, q) * invDet;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		const float t = Dot(e2, q) * invDet;
+		if (t <= ray.TMin || t >= hit.T)
+			return false;
+
+		hit.T = t;
+		hit.U = u;
+		hit.V = v;
+		hit.Triangle = triangle;
+		return true;
+	}
+
+	// Slab test against [boxMin, boxMax]; returns the entry distance, or +inf on a miss.
+	[[nodiscard]] inline float IntersectBox(const Vec3& origin, const Vec3& inverseDirection, const Vec3& boxMin, const Vec3& boxMax,
+		float tMin, float tMax) noexcept
+	{
+		const float tx0 = (boxMin.X - origin.X) * inverseDirection.X, tx1 = (boxMax.X - origin.X) * inverseDirection.X;
+		const float ty0 = (boxMin.Y - origin.Y) * inverseDirection.Y, ty1 = (boxMax.Y - origin.Y) * inverseDirection.Y;
+		const float tz0 = (boxMin.Z - origin.Z) * inverseDirection.Z, tz1 = (boxMax.Z - origin.Z) * inverseDirection.Z;
+		const float tNear = std::max({ std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), tMin });
+		const float tFar = std::min({ std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), tMax });
+		return tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+	}
+}
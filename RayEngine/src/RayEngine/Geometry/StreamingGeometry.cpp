@@ -0,0 +1,445 @@
+#include "StreamingGeometry.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::size_t rayChunk = 256;
+		constexpr auto loadPollInterval = std::chrono::microseconds(50);
+
+		[[nodiscard]] bool Overlaps(const AABB& a, const AABB& b) noexcept
+		{
+			return a.Min.X <= b.Max.X && b.Min.X <= a.Max.X && a.Min.Y <= b.Max.Y && b.Min.Y <= a.Max.Y && a.Min.Z <= b.Max.Z && b.Min.Z <= a.Max.Z;
+		}
+	}
+
+	std::unique_ptr<StreamingGeometry> StreamingGeometry::Open(const std::filesystem::path& path, IOService& io, StreamingGeometrySpec spec)
+	{
+		std::error_code ec;
+		const std::uint64_t fileBytes = std::filesystem::file_size(path, ec);
+		std::ifstream file(path, std::ios::binary);
+		ClusterFileHeader header;
+		if (ec || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		{
+			RAY_CORE_ERROR("[StreamingGeometry] cannot read '{}'", path.string());
+			return nullptr;
+		}
+		if (header.Magic != clusterFileMagic || header.Version != clusterFileVersion
+			|| header.DirectoryOffset + header.ClusterCount * sizeof(ClusterRecord) > fileBytes)
+		{
+			RAY_CORE_ERROR("[StreamingGeometry] '{}' is not a version {} cluster file", path.string(), clusterFileVersion);
+			return nullptr;
+		}
+
+		std::vector<ClusterRecord> records(header.ClusterCount);
+		file.seekg(static_cast<std::streamoff>(header.DirectoryOffset));
+		if (!file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(ClusterRecord))))
+		{
+			RAY_CORE_ERROR("[StreamingGeometry] cannot read the cluster directory of '{}'", path.string());
+			return nullptr;
+		}
+
+		std::uint64_t largest = 0;
+		for (const ClusterRecord& record : records)
+		{
+			if (record.Bytes != record.GetExpectedBytes() || record.Offset + record.Bytes > header.DirectoryOffset)
+			{
+				RAY_CORE_ERROR("[StreamingGeometry] '{}' has a corrupt cluster record", path.string());
+				return nullptr;
+			}
+			largest = std::max(largest, record.Bytes);
+		}
+		if (largest > spec.MemoryBudgetBytes)
+		{
+			RAY_CORE_ERROR("[StreamingGeometry] budget of {} bytes cannot hold the largest cluster ({} bytes)", spec.MemoryBudgetBytes, largest);
+			return nullptr;
+		}
+
+		FileHandle handle = FileHandle::OpenRead(path);
+		if (!handle.IsOpen())
+			return nullptr;
+
+		spec.MaxLoadsInFlight = std::max(1u, spec.MaxLoadsInFlight);
+		std::unique_ptr<StreamingGeometry> geometry(new StreamingGeometry(io, std::move(handle), spec, std::move(records)));
+		geometry->m_FileBytes = fileBytes;
+		return geometry;
+	}
+
+	StreamingGeometry::StreamingGeometry(IOService& io, FileHandle file, StreamingGeometrySpec spec, std::vector<ClusterRecord> records)
+		: m_IO(&io), m_File(std::move(file)), m_Spec(spec), m_Records(std::move(records)), m_Clusters(m_Records.size()),
+		m_Waiting(m_Records.size()), m_Needed(m_Records.size(), 0)
+	{
+		BuildTopLevel();
+	}
+
+	StreamingGeometry::~StreamingGeometry()
+	{
+		// Completion callbacks point at this object.
+		WaitForLoads();
+	}
+
+	void StreamingGeometry::BuildTopLevel()
+	{
+		const auto clusterCount = static_cast<std::uint32_t>(m_Records.size());
+		if (clusterCount == 0)
+			return;
+
+		// A few hundred to a few thousand boxes: object-median splits are plenty, and they keep the
+		// tree within BVH::maxDepth for TraverseBVH.
+		std::vector<std::uint32_t> order(clusterCount);
+		std::iota(order.begin(), order.end(), 0u);
+		struct Range
+		{
+			std::uint32_t Node;
+			std::uint32_t Begin;
+			std::uint32_t End;
+		};
+		m_TopNodes.reserve(2 * static_cast<std::size_t>(clusterCount));
+		m_TopNodes.emplace_back();
+		std::vector<Range> pending{ { 0, 0, clusterCount } };
+		while (!pending.empty())
+		{
+			const Range range = pending.back();
+			pending.pop_back();
+
+			AABB bounds, centroidBounds;
+			for (std::uint32_t i = range.Begin; i < range.End; ++i)
+			{
+				bounds.Grow(m_Records[order[i]].Bounds);
+				centroidBounds.Grow(m_Records[order[i]].Bounds.GetCentroid());
+			}
+			m_TopNodes[range.Node].Bounds = bounds;
+			if (range.End - range.Begin == 1)
+			{
+				m_TopNodes[range.Node].First = order[range.Begin];
+				m_TopNodes[range.Node].Count = 1;
+				continue;
+			}
+
+			const int axis = centroidBounds.GetLargestAxis();
+			const std::uint32_t middle = range.Begin + (range.End - range.Begin) / 2;
+			std::nth_element(order.begin() + range.Begin, order.begin() + middle, order.begin() + range.End,
+				[&](std::uint32_t a, std::uint32_t b) { return m_Records[a].Bounds.GetCentroid()[axis] < m_Records[b].Bounds.GetCentroid()[axis]; });
+			const auto left = static_cast<std::uint32_t>(m_TopNodes.size());
+			m_TopNodes.emplace_back();
+			m_TopNodes.emplace_back();
+			m_TopNodes[range.Node].First = left;
+			m_TopNodes[range.Node].Count = 0;
+			pending.push_back({ left, range.Begin, middle });
+			pending.push_back({ left + 1, middle, range.End });
+		}
+	}
+
+	void StreamingGeometry::Trace(std::span<const Ray> rays, std::span<Hit> hits, ThreadPool* pool)
+	{
+		assert(rays.size() == hits.size());
+		Update();
+		m_Batch++;
+		m_Stats.Batches++;
+		m_Stats.Rays += rays.size();
+
+		// 1) Everything that can be answered from resident clusters, in parallel.
+		const std::size_t chunkCount = (rays.size() + rayChunk - 1) / rayChunk;
+		std::vector<std::vector<std::pair<std::uint32_t, Deferral>>> chunkDeferrals(chunkCount);
+		ParallelFor(pool, chunkCount, [&](std::size_t chunk) {
+			const std::size_t end = std::min(rays.size(), (chunk + 1) * rayChunk);
+			for (std::size_t i = chunk * rayChunk; i < end; ++i)
+			{
+				hits[i] = Hit{};
+				hits[i].T = rays[i].TMax;
+				TraceResident(static_cast<std::uint32_t>(i), rays[i], hits[i], chunkDeferrals[chunk]);
+			}
+		});
+
+		// 2) Bucket the deferred rays by cluster.
+		std::vector<std::uint32_t> needed;
+		for (const auto& deferrals : chunkDeferrals)
+		{
+			for (std::size_t i = 0; i < deferrals.size(); ++i)
+			{
+				const auto& [cluster, deferral] = deferrals[i];
+				if (!m_Needed[cluster])
+				{
+					m_Needed[cluster] = 1;
+					needed.push_back(cluster);
+				}
+				m_Waiting[cluster].push_back(deferral);
+				// A ray's deferrals are consecutive.
+				if (i == 0 || deferrals[i - 1].second.Ray != deferral.Ray)
+					m_Stats.DeferredRays++;
+			}
+			m_Stats.Deferrals += deferrals.size();
+		}
+
+		// 3) Nearest clusters first: their hits let farther loads be skipped.
+		std::vector<float> nearest(needed.size());
+		for (std::size_t i = 0; i < needed.size(); ++i)
+		{
+			nearest[i] = std::numeric_limits<float>::infinity();
+			for (const Deferral& deferral : m_Waiting[needed[i]])
+				nearest[i] = std::min(nearest[i], deferral.Entry);
+		}
+		std::vector<std::uint32_t> loadOrder(needed.size());
+		std::iota(loadOrder.begin(), loadOrder.end(), 0u);
+		std::sort(loadOrder.begin(), loadOrder.end(), [&](std::uint32_t a, std::uint32_t b) { return nearest[a] < nearest[b]; });
+
+		std::size_t next = 0;
+		std::size_t remaining = needed.size();
+		while (remaining > 0)
+		{
+			for (; next < loadOrder.size() && m_LoadsInFlight < m_Spec.MaxLoadsInFlight; ++next)
+			{
+				const std::uint32_t cluster = needed[loadOrder[next]];
+				std::vector<Deferral>& waiting = m_Waiting[cluster];
+				std::erase_if(waiting, [&](const Deferral& deferral) { return deferral.Entry >= hits[deferral.Ray].T; });
+				if (waiting.empty())
+				{
+					m_Needed[cluster] = 0;
+					m_Stats.SkippedLoads++;
+					remaining--;
+					continue;
+				}
+				const ClusterStatus status = m_Clusters[cluster].Status;
+				if (status == ClusterStatus::Resident)
+					m_Arrived.push_back(cluster); // prefetched meanwhile
+				else if (status == ClusterStatus::Absent)
+				{
+					if (!MakeRoom(m_Records[cluster].Bytes, std::numeric_limits<std::uint64_t>::max()))
+						break; // retry once loads in flight have been consumed
+					StartLoad(cluster, false);
+				}
+			}
+
+			m_IO->Update();
+			if (m_Arrived.empty())
+			{
+				if (m_LoadsInFlight == 0 && next < loadOrder.size() && m_Clusters[needed[loadOrder[next]]].Status == ClusterStatus::Absent
+					&& !MakeRoom(m_Records[needed[loadOrder[next]]].Bytes, std::numeric_limits<std::uint64_t>::max()))
+				{
+					RAY_CORE_ERROR("[StreamingGeometry] no cluster can be evicted to make room; {} clusters left unintersected", remaining);
+					break;
+				}
+				const auto start = std::chrono::steady_clock::now();
+				std::this_thread::sleep_for(loadPollInterval);
+				m_Stats.IOWaitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				continue;
+			}
+
+			// 4) One pass over the rays waiting for each arrived cluster.
+			for (const std::uint32_t cluster : m_Arrived)
+			{
+				if (!m_Needed[cluster])
+					continue;
+				std::vector<Deferral>& waiting = m_Waiting[cluster];
+				Cluster& state = m_Clusters[cluster];
+				if (state.Status == ClusterStatus::Resident)
+				{
+					state.LastUsed.store(m_Batch, std::memory_order_relaxed);
+					ParallelFor(pool, (waiting.size() + rayChunk - 1) / rayChunk, [&](std::size_t chunk) {
+						const std::size_t end = std::min(waiting.size(), (chunk + 1) * rayChunk);
+						for (std::size_t i = chunk * rayChunk; i < end; ++i)
+						{
+							const Deferral& deferral = waiting[i];
+							if (deferral.Entry < hits[deferral.Ray].T)
+								state.View.Intersect(rays[deferral.Ray], hits[deferral.Ray]);
+						}
+					});
+				}
+				waiting.clear();
+				m_Needed[cluster] = 0;
+				remaining--;
+			}
+			m_Arrived.clear();
+		}
+
+		for (const std::uint32_t cluster : needed)
+		{
+			m_Waiting[cluster].clear();
+			m_Needed[cluster] = 0;
+		}
+		for (Hit& hit : hits)
+		{
+			if (!hit.IsHit())
+				hit.T = std::numeric_limits<float>::infinity();
+		}
+	}
+
+	void StreamingGeometry::TraceResident(std::uint32_t rayIndex, const Ray& ray, Hit& hit, std::vector<std::pair<std::uint32_t, Deferral>>& deferrals) const noexcept
+	{
+		const std::size_t firstDeferral = deferrals.size();
+		const Vec3 inverseDirection{ 1.0f / ray.Direction.X, 1.0f / ray.Direction.Y, 1.0f / ray.Direction.Z };
+		TraverseBVH(m_TopNodes, ray, hit, [&](const BVHNode& leaf) {
+			// Entry distance for the deferred pass; hit.T may also have shrunk since the parent's test.
+			const float entry = IntersectBox(ray.Origin, inverseDirection, leaf.Bounds.Min, leaf.Bounds.Max, ray.TMin, hit.T);
+			if (entry == std::numeric_limits<float>::infinity())
+				return;
+
+			const Cluster& cluster = m_Clusters[leaf.First];
+			if (cluster.Status == ClusterStatus::Resident)
+			{
+				cluster.View.Intersect(ray, hit);
+				if (cluster.LastUsed.load(std::memory_order_relaxed) != m_Batch)
+					cluster.LastUsed.store(m_Batch, std::memory_order_relaxed);
+			}
+			else
+				deferrals.push_back({ leaf.First, Deferral{ rayIndex, entry } });
+		});
+
+		// Clusters entered beyond the closest resident hit cannot matter.
+		const auto kept = std::remove_if(deferrals.begin() + static_cast<std::ptrdiff_t>(firstDeferral), deferrals.end(),
+			[&](const auto& deferral) { return deferral.second.Entry >= hit.T; });
+		deferrals.erase(kept, deferrals.end());
+	}
+
+	void StreamingGeometry::Prefetch(const AABB& region)
+	{
+		Update();
+		const Vec3 centre = region.GetCentroid();
+		std::vector<std::pair<float, std::uint32_t>> candidates;
+		for (std::uint32_t cluster = 0; cluster < m_Records.size(); ++cluster)
+		{
+			if (m_Clusters[cluster].Status == ClusterStatus::Absent && Overlaps(m_Records[cluster].Bounds, region))
+			{
+				const Vec3 offset = m_Records[cluster].Bounds.GetCentroid() - centre;
+				candidates.emplace_back(Dot(offset, offset), cluster);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		for (const auto& [distance, cluster] : candidates)
+		{
+			if (m_LoadsInFlight >= m_Spec.MaxLoadsInFlight || !MakeRoom(m_Records[cluster].Bytes, m_Batch))
+				break;
+			StartLoad(cluster, true);
+		}
+		m_IO->Update();
+	}
+
+	void StreamingGeometry::Update() noexcept
+	{
+		m_IO->Update();
+		m_Arrived.clear();
+	}
+
+	void StreamingGeometry::StartLoad(std::uint32_t cluster, bool prefetch)
+	{
+		const ClusterRecord& record = m_Records[cluster];
+		Cluster& state = m_Clusters[cluster];
+		assert(state.Status == ClusterStatus::Absent);
+		state.Blob = std::make_unique_for_overwrite<std::byte[]>(record.Bytes);
+		state.Status = ClusterStatus::Loading;
+		// Prefetched clusters count as used by the latest batch, so later prefetches keep them.
+		if (prefetch)
+			state.LastUsed.store(m_Batch, std::memory_order_relaxed);
+
+		m_Stats.ResidentBytes += record.Bytes;
+		m_Stats.PeakResidentBytes = std::max(m_Stats.PeakResidentBytes, m_Stats.ResidentBytes);
+		m_Stats.Loads++;
+		if (prefetch)
+			m_Stats.PrefetchLoads++;
+		m_LoadsInFlight++;
+
+		m_IO->ReadAsync(m_File, record.Offset, { state.Blob.get(), record.Bytes }, [this, cluster](const IOResult& result) {
+			const ClusterRecord& record = m_Records[cluster];
+			Cluster& state = m_Clusters[cluster];
+			m_LoadsInFlight--;
+			if (!result.Ok() || result.BytesRead != record.Bytes)
+			{
+				RAY_CORE_ERROR("[StreamingGeometry] reading cluster {} failed (error {}, {} of {} bytes)", cluster, result.Error, result.BytesRead, record.Bytes);
+				m_Stats.FailedLoads++;
+				state.Blob.reset();
+				state.Status = ClusterStatus::Absent;
+				m_Stats.ResidentBytes -= record.Bytes;
+			}
+			else
+			{
+				state.View = ClusterView::FromBlob(record, { state.Blob.get(), record.Bytes });
+				state.Status = ClusterStatus::Resident;
+				m_Stats.BytesRead += record.Bytes;
+				m_Stats.ResidentClusters++;
+			}
+			// Waiting rays are released either way; a failed cluster is treated as empty.
+			m_Arrived.push_back(cluster);
+		});
+	}
+
+	void StreamingGeometry::WaitForLoads() noexcept
+	{
+		while (m_LoadsInFlight > 0)
+		{
+			m_IO->Update();
+			if (m_LoadsInFlight > 0)
+				std::this_thread::sleep_for(loadPollInterval);
+		}
+		m_Arrived.clear();
+	}
+
+	bool StreamingGeometry::MakeRoom(std::size_t bytes, std::uint64_t protectedFrom) noexcept
+	{
+		while (m_Stats.ResidentBytes + bytes > m_Spec.MemoryBudgetBytes)
+		{
+			std::uint32_t victim = std::numeric_limits<std::uint32_t>::max();
+			std::uint64_t oldest = protectedFrom;
+			for (std::uint32_t cluster = 0; cluster < m_Clusters.size(); ++cluster)
+			{
+				const Cluster& state = m_Clusters[cluster];
+				const std::uint64_t lastUsed = state.LastUsed.load(std::memory_order_relaxed);
+				if (state.Status == ClusterStatus::Resident && !m_Needed[cluster] && lastUsed < oldest)
+				{
+					oldest = lastUsed;
+					victim = cluster;
+				}
+			}
+			if (victim == std::numeric_limits<std::uint32_t>::max())
+				return false;
+			Evict(victim);
+			m_Stats.Evictions++;
+		}
+		return true;
+	}
+
+	void StreamingGeometry::Evict(std::uint32_t cluster) noexcept
+	{
+		Cluster& state = m_Clusters[cluster];
+		assert(state.Status == ClusterStatus::Resident);
+		state.Blob.reset();
+		state.View = {};
+		state.Status = ClusterStatus::Absent;
+		m_Stats.ResidentBytes -= m_Records[cluster].Bytes;
+		m_Stats.ResidentClusters--;
+	}
+
+	StreamingGeometryStats StreamingGeometry::GetStats() const noexcept
+	{
+		return m_Stats;
+	}
+
+	void StreamingGeometry::ResetCounters() noexcept
+	{
+		const StreamingGeometryStats current = m_Stats;
+		m_Stats = {};
+		m_Stats.ResidentBytes = current.ResidentBytes;
+		m_Stats.PeakResidentBytes = current.ResidentBytes;
+		m_Stats.ResidentClusters = current.ResidentClusters;
+	}
+
+	void StreamingGeometry::EvictAll() noexcept
+	{
+		WaitForLoads();
+		for (std::uint32_t cluster = 0; cluster < m_Clusters.size(); ++cluster)
+		{
+			if (m_Clusters[cluster].Status == ClusterStatus::Resident)
+				Evict(cluster);
+		}
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ClusterFile.h"
+#include "RayEngine/IO/IOService.h"
+
+namespace RayEngine
+{
+	class ThreadPool;
+
+	struct StreamingGeometrySpec
+	{
+		// Cluster blobs resident or being loaded never exceed this; must hold the largest cluster.
+		std::size_t MemoryBudgetBytes = 256ull * 1024 * 1024;
+		// Cluster reads handed to the IOService at once.
+		std::uint32_t MaxLoadsInFlight = 32;
+	};
+
+	struct StreamingGeometryStats
+	{
+		std::uint64_t Batches = 0;
+		std::uint64_t Rays = 0;
+		std::uint64_t DeferredRays = 0;   // rays that waited for at least one cluster
+		std::uint64_t Deferrals = 0;      // (ray, cluster) pairs queued for a non-resident cluster
+		std::uint64_t Loads = 0;          // cluster reads issued, prefetches included
+		std::uint64_t PrefetchLoads = 0;
+		std::uint64_t SkippedLoads = 0;   // needed clusters dropped because closer hits were found first
+		std::uint64_t FailedLoads = 0;
+		std::uint64_t Evictions = 0;
+		std::uint64_t BytesRead = 0;
+		std::size_t ResidentBytes = 0;    // loaded plus loading
+		std::size_t PeakResidentBytes = 0;
+		std::size_t ResidentClusters = 0;
+		double IOWaitSeconds = 0.0;       // time Trace() spent waiting with nothing to intersect
+	};
+
+	// Ray tracing against a clustered mesh file (see WriteClusterFile) that may be far larger than
+	// memory. The small cluster directory and a top-level BVH over the cluster bounds stay in
+	// memory; the clusters themselves are read through the IOService on demand and evicted
+	// least-recently-used to stay within the memory budget.
+	// Trace() takes whole batches of rays: each ray is intersected with the resident clusters it
+	// reaches, and queued at every non-resident cluster it enters before its current closest hit.
+	// Clusters are then loaded nearest-first, each load followed by one parallel pass over the
+	// rays waiting for it, so a cluster is read at most once per batch however many rays need it,
+	// and loads whose rays already found closer hits are skipped.
+	// Trace() and Prefetch() pump the IOService and must be called on its (main) thread.
+	class StreamingGeometry
+	{
+	public:
+		// Reads the directory; returns nullptr and logs if the file is invalid or the budget
+		// cannot hold its largest cluster.
+		[[nodiscard]] static std::unique_ptr<StreamingGeometry> Open(const std::filesystem::path& path, IOService& io, StreamingGeometrySpec spec = {});
+		~StreamingGeometry();
+
+		StreamingGeometry(const StreamingGeometry&) = delete;
+		StreamingGeometry& operator=(const StreamingGeometry&) = delete;
+		StreamingGeometry(StreamingGeometry&&) = delete;
+		StreamingGeometry& operator=(StreamingGeometry&&) = delete;
+
+		// Closest hit of every ray (hits[i].T == +inf on a miss); `pool` may be null.
+		void Trace(std::span<const Ray> rays, std::span<Hit> hits, ThreadPool* pool = nullptr);
+
+		// Starts loading the clusters overlapping `region`, nearest to its centre first, evicting
+		// only clusters the last batch did not use. Returns without waiting.
+		void Prefetch(const AABB& region);
+		// Completes finished prefetches (Trace() does this too).
+		void Update() noexcept;
+
+		[[nodiscard]] std::size_t GetClusterCount() const noexcept { return m_Records.size(); }
+		[[nodiscard]] const ClusterRecord& GetCluster(std::size_t cluster) const noexcept { return m_Records[cluster]; }
+		[[nodiscard]] bool IsResident(std::size_t cluster) const noexcept { return m_Clusters[cluster].Status == ClusterStatus::Resident; }
+		[[nodiscard]] AABB GetBounds() const noexcept { return m_TopNodes.empty() ? AABB{} : m_TopNodes.front().Bounds; }
+		[[nodiscard]] std::uint64_t GetFileBytes() const noexcept { return m_FileBytes; }
+		[[nodiscard]] const StreamingGeometrySpec& GetSpecification() const noexcept { return m_Spec; }
+
+		[[nodiscard]] StreamingGeometryStats GetStats() const noexcept;
+		void ResetCounters() noexcept;
+		// Drops every resident cluster (waits for loads in flight).
+		void EvictAll() noexcept;
+
+	private:
+		enum class ClusterStatus : std::uint8_t
+		{
+			Absent,
+			Loading,
+			Resident
+		};
+
+		struct Cluster
+		{
+			ClusterStatus Status = ClusterStatus::Absent;
+			std::unique_ptr<std::byte[]> Blob;
+			ClusterView View;
+			mutable std::atomic<std::uint64_t> LastUsed{ 0 }; // batch number; written concurrently by Trace()
+		};
+
+		struct Deferral
+		{
+			std::uint32_t Ray;
+			float Entry; // distance at which the ray enters the cluster's bounds
+		};
+
+		StreamingGeometry(IOService& io, FileHandle file, StreamingGeometrySpec spec, std::vector<ClusterRecord> records);
+
+		void BuildTopLevel();
+		// Closest hit among resident clusters; queues the ray at non-resident ones it may reach.
+		void TraceResident(std::uint32_t rayIndex, const Ray& ray, Hit& hit, std::vector<std::pair<std::uint32_t, Deferral>>& deferrals) const noexcept;
+		void StartLoad(std::uint32_t cluster, bool prefetch);
+		// Runs the IOService until no load of ours is in flight.
+		void WaitForLoads() noexcept;
+		// Frees least-recently-used resident clusters not needed by the current batch until
+		// `bytes` more fit. Clusters used in or after `protectedFrom` are kept.
+		[[nodiscard]] bool MakeRoom(std::size_t bytes, std::uint64_t protectedFrom) noexcept;
+		void Evict(std::uint32_t cluster) noexcept;
+
+	private:
+		IOService* m_IO;
+		FileHandle m_File;
+		StreamingGeometrySpec m_Spec;
+		std::vector<ClusterRecord> m_Records;
+		std::vector<Cluster> m_Clusters;
+		std::vector<BVHNode> m_TopNodes;        // leaves: First = cluster index, Count = 1
+		std::uint64_t m_FileBytes = 0;
+
+		// Main thread only.
+		std::vector<std::vector<Deferral>> m_Waiting; // per cluster, during Trace()
+		std::vector<std::uint8_t> m_Needed;          // per cluster: has waiting rays in this batch
+		std::vector<std::uint32_t> m_Arrived;         // clusters that finished loading since the last check
+		std::uint32_t m_LoadsInFlight = 0;
+		std::uint64_t m_Batch = 0;
+		StreamingGeometryStats m_Stats;
+	};
+}
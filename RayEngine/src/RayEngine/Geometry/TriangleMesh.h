@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Math.h"
+
+namespace RayEngine
+{
+	// Indexed triangle mesh: triangle i uses Positions[Indices[3 * i + 0..2]].
+	struct TriangleMesh
+	{
+		std::vector<Vec3> Positions;
+		std::vector<std::uint32_t> Indices;
+
+		[[nodiscard]] std::size_t GetTriangleCount() const noexcept { return Indices.size() / 3; }
+		[[nodiscard]] std::size_t GetMemoryBytes() const noexcept
+		{
+			return Positions.size() * sizeof(Vec3) + Indices.size() * sizeof(std::uint32_t);
+		}
+
+		[[nodiscard]] AABB GetTriangleBounds(std::size_t triangle) const noexcept
+		{
+			AABB bounds;
+			for (int corner = 0; corner < 3; ++corner)
+				bounds.Grow(Positions[Indices[3 * triangle + corner]]);
+			return bounds;
+		}
+	};
+}
@@ -0,0 +1,107 @@
+#include "FileHandle.h"
+#include "RayEngine/Core/Log.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RayEngine
+{
+	FileHandle::~FileHandle()
+	{
+		Close();
+	}
+
+	FileHandle::FileHandle(FileHandle&& other) noexcept
+		: m_Handle(std::exchange(other.m_Handle, FileHandle().m_Handle))
+	{
+	}
+
+	FileHandle& FileHandle::operator=(FileHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Handle = std::exchange(other.m_Handle, FileHandle().m_Handle);
+		}
+		return *this;
+	}
+
+#ifdef _WIN32
+	FileHandle FileHandle::OpenRead(const std::filesystem::path& path) noexcept
+	{
+		HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (handle == INVALID_HANDLE_VALUE)
+		{
+			RAY_CORE_ERROR("[FileHandle] failed to open '{}' (error {})", path.string(), GetLastError());
+			return FileHandle();
+		}
+		return FileHandle(handle);
+	}
+
+	bool FileHandle::IsOpen() const noexcept
+	{
+		return m_Handle != nullptr;
+	}
+
+	std::uint64_t FileHandle::GetSize() const noexcept
+	{
+		LARGE_INTEGER size{};
+		if (!IsOpen() || !GetFileSizeEx(m_Handle, &size))
+			return 0;
+		return static_cast<std::uint64_t>(size.QuadPart);
+	}
+
+	void FileHandle::Close() noexcept
+	{
+		if (m_Handle)
+		{
+			CloseHandle(m_Handle);
+			m_Handle = nullptr;
+		}
+	}
+#else
+	FileHandle FileHandle::OpenRead(const std::filesystem::path& path) noexcept
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			RAY_CORE_ERROR("[FileHandle] failed to open '{}': {}", path.string(), std::strerror(errno));
+			return FileHandle();
+		}
+		return FileHandle(fd);
+	}
+
+	bool FileHandle::IsOpen() const noexcept
+	{
+		return m_Handle >= 0;
+	}
+
+	std::uint64_t FileHandle::GetSize() const noexcept
+	{
+		struct stat st {};
+		if (!IsOpen() || ::fstat(m_Handle, &st) != 0)
+			return 0;
+		return static_cast<std::uint64_t>(st.st_size);
+	}
+
+	void FileHandle::Close() noexcept
+	{
+		if (m_Handle >= 0)
+		{
+			::close(m_Handle);
+			m_Handle = -1;
+		}
+	}
+#endif
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace RayEngine
+{
+	// RAII read-only file handle used by the IOService.
+	// Move-only; the native handle is closed on destruction.
+	class FileHandle
+	{
+	public:
+#ifdef _WIN32
+		using NativeHandle = void*;
+#else
+		using NativeHandle = int;
+#endif
+
+		FileHandle() noexcept = default;
+		~FileHandle();
+
+		FileHandle(const FileHandle&) = delete;
+		FileHandle& operator=(const FileHandle&) = delete;
+		FileHandle(FileHandle&& other) noexcept;
+		FileHandle& operator=(FileHandle&& other) noexcept;
+
+		// Returns an invalid handle (IsOpen() == false) and logs on failure.
+		[[nodiscard]] static FileHandle OpenRead(const std::filesystem::path& path) noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept;
+		[[nodiscard]] std::uint64_t GetSize() const noexcept;
+		[[nodiscard]] NativeHandle GetNative() const noexcept { return m_Handle; }
+
+		void Close() noexcept;
+
+	private:
+		explicit FileHandle(NativeHandle handle) noexcept
+			: m_Handle(handle)
+		{
+		}
+
+	private:
+#ifdef _WIN32
+		NativeHandle m_Handle = nullptr;
+#else
+		NativeHandle m_Handle = -1;
+#endif
+	};
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FileHandle.h"
+
+namespace RayEngine
+{
+	class WakeEvent;
+
+	// Result of one backend read: >= 0 bytes transferred, < 0 a negated error code.
+	struct IOCompletion
+	{
+		std::uint32_t Id = 0;
+		std::int64_t Result = 0;
+	};
+
+	// Backend interface used by IOService. All methods are called from the main thread.
+	// Backends do not retry short reads; IOService resubmits the remainder.
+	class IOBackend
+	{
+	public:
+		virtual ~IOBackend() = default;
+
+		[[nodiscard]] virtual const char* GetName() const noexcept = 0;
+
+		// Number of additional reads that can be queued right now.
+		[[nodiscard]] virtual std::size_t GetFreeSlots() const noexcept = 0;
+
+		// Queue a read of `size` bytes at `offset` directly into `dst`. Not started until Flush().
+		virtual bool Queue(std::uint32_t id, FileHandle::NativeHandle file, std::uint64_t offset, std::byte* dst, std::size_t size) noexcept = 0;
+
+		// Hand everything queued since the last Flush() to the OS as one batch.
+		virtual void Flush() noexcept = 0;
+
+		// Append finished reads to `out` without blocking.
+		virtual void Reap(std::vector<IOCompletion>& out) noexcept = 0;
+
+		// Signal `event` whenever a read completes (null to stop), so the main thread can block
+		// instead of polling Reap(). Returns false if the backend cannot.
+		virtual bool SetCompletionEvent(WakeEvent* event) noexcept
+		{
+			(void)event;
+			return false;
+		}
+	};
+}
@@ -0,0 +1,210 @@
+#include "IOService.h"
+#include "PreadBackend.h"
+#include "IOUringBackend.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/WakeEvent.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::size_t preadWorkers = 4;
+
+		std::unique_ptr<IOBackend> CreateBackend(IOService::BackendType preferred, std::uint32_t queueDepth)
+		{
+#ifdef __linux__
+			if (preferred != IOService::BackendType::Pread)
+			{
+				if (auto uring = IOUringBackend::Create(queueDepth))
+					return uring;
+				if (preferred == IOService::BackendType::IOUring)
+					RAY_CORE_WARN("[IOService] io_uring requested but unavailable, falling back to pread");
+			}
+#else
+			if (preferred == IOService::BackendType::IOUring)
+				RAY_CORE_WARN("[IOService] io_uring is Linux-only, falling back to pread");
+#endif
+			return std::make_unique<PreadBackend>(preadWorkers, queueDepth);
+		}
+	}
+
+	IOService::IOService(BackendType preferred, std::uint32_t queueDepth)
+		: m_Backend(CreateBackend(preferred, queueDepth))
+	{
+		m_Slots.resize(queueDepth);
+		m_FreeSlots.reserve(queueDepth);
+		for (std::uint32_t i = queueDepth; i > 0; --i)
+			m_FreeSlots.push_back(i - 1);
+		m_Completions.reserve(queueDepth);
+		m_Waiting.reserve(queueDepth);
+		m_Retry.reserve(queueDepth);
+	}
+
+	IOService::~IOService()
+	{
+		Drain();
+		SetWakeEvent(nullptr);
+	}
+
+	void IOService::ReadAsync(const FileHandle& file, std::uint64_t offset, std::span<std::byte> dst, Callback callback)
+	{
+		// Invalid files still complete through Update() so the callback always runs on the main thread.
+		Request request{ file.GetNative(), offset, dst.data(), dst.size(), 0, file.IsOpen() ? 0 : EBADF, std::move(callback) };
+
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			m_Incoming.push_back(std::move(request));
+		}
+		if (m_WakeEvent)
+			m_WakeEvent->Signal();
+	}
+
+	void IOService::Update() noexcept
+	{
+		// 1) Completions first so their slots can be reused by this frame's batch.
+		m_Completions.clear();
+		m_Backend->Reap(m_Completions);
+		for (const IOCompletion& completion : m_Completions)
+			HandleCompletion(completion);
+
+		// 2) Continue short reads that could not be requeued immediately.
+		std::size_t retried = 0;
+		for (; retried < m_Retry.size() && QueueSlot(m_Retry[retried]); ++retried) {}
+		m_Retry.erase(m_Retry.begin(), m_Retry.begin() + static_cast<std::ptrdiff_t>(retried));
+
+		// 3) Accept new requests (including ones issued by the callbacks above).
+		{
+			std::lock_guard lock(m_IncomingMutex);
+			for (auto& request : m_Incoming)
+				m_Waiting.push_back(std::move(request));
+			m_Incoming.clear();
+		}
+
+		// 4) Fill free slots in request order and submit them as one batch.
+		std::size_t accepted = 0;
+		for (; accepted < m_Waiting.size() && !m_FreeSlots.empty() && m_Backend->GetFreeSlots() > 0; ++accepted)
+		{
+			const std::uint32_t slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			m_Slots[slot] = std::move(m_Waiting[accepted]);
+			m_Stats.Requests++;
+
+			const Request& request = m_Slots[slot];
+			if (request.Error != 0 || request.Size == 0)
+				Finish(slot, request.Error);
+			else if (!QueueSlot(slot))
+				m_Retry.push_back(slot);
+		}
+		m_Waiting.erase(m_Waiting.begin(), m_Waiting.begin() + static_cast<std::ptrdiff_t>(accepted));
+
+		if (accepted > 0 || retried > 0)
+			m_Stats.Batches++;
+		m_Backend->Flush();
+
+		m_Stats.InFlight = m_Slots.size() - m_FreeSlots.size();
+		m_Stats.Queued = m_Waiting.size();
+	}
+
+	void IOService::Drain() noexcept
+	{
+		while (HasPendingWork())
+		{
+			Update();
+			if (HasPendingWork())
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+	bool IOService::HasPendingWork() const noexcept
+	{
+		if (HasInFlightWork())
+			return true;
+		std::lock_guard lock(m_IncomingMutex);
+		return !m_Incoming.empty();
+	}
+
+	bool IOService::HasInFlightWork() const noexcept
+	{
+		return m_FreeSlots.size() != m_Slots.size() || !m_Waiting.empty() || !m_Retry.empty();
+	}
+
+	void IOService::SetWakeEvent(WakeEvent* event) noexcept
+	{
+		m_WakeEvent = event;
+		m_SignalsCompletions = m_Backend->SetCompletionEvent(event) && event;
+	}
+
+	void IOService::HandleCompletion(const IOCompletion& completion) noexcept
+	{
+		const std::uint32_t slot = completion.Id;
+		Request& request = m_Slots[slot];
+
+		if (completion.Result < 0)
+		{
+			const int error = static_cast<int>(-completion.Result);
+			if (error == EAGAIN || error == EINTR)
+			{
+				if (!QueueSlot(slot))
+					m_Retry.push_back(slot);
+				return;
+			}
+			Finish(slot, error);
+			return;
+		}
+
+		const auto bytes = static_cast<std::size_t>(completion.Result);
+		request.Done += bytes;
+		m_Stats.BytesRead += bytes;
+
+		// bytes == 0 means end of file: report the short read instead of spinning.
+		if (bytes > 0 && request.Done < request.Size)
+		{
+			m_Stats.Resubmits++;
+			if (!QueueSlot(slot))
+				m_Retry.push_back(slot);
+			return;
+		}
+		Finish(slot, 0);
+	}
+
+	void IOService::Finish(std::uint32_t slot, int error) noexcept
+	{
+		Request& request = m_Slots[slot];
+		const IOResult result{ request.Done, error };
+		Callback callback = std::move(request.OnComplete);
+		request = Request{};
+		m_FreeSlots.push_back(slot);
+
+		m_Stats.Completed++;
+		if (error != 0)
+			m_Stats.Failed++;
+
+		if (!callback)
+			return;
+		try
+		{
+			callback(result);
+		}
+		catch (const std::exception& e)
+		{
+			RAY_CORE_ERROR(std::string("[IOService] completion callback threw: ") + e.what());
+		}
+		catch (...)
+		{
+			RAY_CORE_ERROR("[IOService] completion callback threw unknown exception");
+		}
+	}
+
+	bool IOService::QueueSlot(std::uint32_t slot) noexcept
+	{
+		const Request& request = m_Slots[slot];
+		return m_Backend->Queue(slot, request.File, request.Offset + request.Done,
+			request.Dst + request.Done, request.Size - request.Done);
+	}
+}
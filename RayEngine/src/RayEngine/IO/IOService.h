@@ -0,0 +1,158 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "FileHandle.h"
+#include "IOBackend.h"
+#include "RayEngine/Core/Scheduler.h"
+
+namespace RayEngine
+{
+	struct IOResult
+	{
+		std::size_t BytesRead = 0; // < requested size only at end of file or on error
+		int Error = 0;             // 0 on success, otherwise an errno / GetLastError() value
+
+		[[nodiscard]] bool Ok() const noexcept { return Error == 0; }
+	};
+
+	struct IOStats
+	{
+		std::uint64_t Requests = 0;
+		std::uint64_t Completed = 0;
+		std::uint64_t Failed = 0;
+		std::uint64_t BytesRead = 0;
+		std::uint64_t Batches = 0;    // Flush() calls that handed at least one read to the backend
+		std::uint64_t Resubmits = 0;  // short reads continued with a second request
+		std::size_t InFlight = 0;
+		std::size_t Queued = 0;
+	};
+
+	// Asynchronous file reads with main-thread completions.
+	// - ReadAsync() may be called from any thread. Data is read straight into the caller's buffer,
+	//   which must stay valid (and untouched) until the callback runs.
+	// - Update() is called by Application::Run() at the ApplyPending() safe point: it runs finished
+	//   callbacks on the main thread and submits all queued reads to the backend as one batch.
+	// - Backends: io_uring on Linux when available, otherwise positional reads on an I/O thread pool.
+	class IOService
+	{
+	public:
+		using Callback = std::function<void(const IOResult&)>;
+
+		enum class BackendType
+		{
+			Auto,    // io_uring if supported, else pread
+			IOUring,
+			Pread
+		};
+
+		explicit IOService(BackendType preferred = BackendType::Auto, std::uint32_t queueDepth = 256);
+		~IOService();
+
+		IOService(const IOService&) = delete;
+		IOService& operator=(const IOService&) = delete;
+		IOService(IOService&&) = delete;
+		IOService& operator=(IOService&&) = delete;
+
+		// Any thread: read dst.size() bytes at `offset` into `dst`.
+		void ReadAsync(const FileHandle& file, std::uint64_t offset, std::span<std::byte> dst, Callback callback);
+
+		// Main thread: dispatch completions, then submit queued reads as a single batch.
+		void Update() noexcept;
+		// Main thread: keep updating until every outstanding read has completed (used at shutdown).
+		void Drain() noexcept;
+
+		[[nodiscard]] bool HasPendingWork() const noexcept;
+		// Main thread: reads handed to the backend, or accepted and waiting for a backend slot.
+		[[nodiscard]] bool HasInFlightWork() const noexcept;
+
+		// Signal `event` when a read is requested and, if the backend supports it, when one
+		// completes. Set before other threads may read; null to stop.
+		void SetWakeEvent(WakeEvent* event) noexcept;
+		// True if completions signal the wake event, so an idle thread may block while reads are
+		// in flight; otherwise it has to keep calling Update().
+		[[nodiscard]] bool SignalsCompletions() const noexcept { return m_SignalsCompletions; }
+		[[nodiscard]] const char* GetBackendName() const noexcept { return m_Backend->GetName(); }
+		[[nodiscard]] const IOStats& GetStats() const noexcept { return m_Stats; }
+
+		// co_await io.AwaitRead(file, offset, buffer) inside a Task; resumes with the IOResult
+		// in the frame the read completes.
+		class ReadAwaitable
+		{
+		public:
+			ReadAwaitable(IOService& io, const FileHandle& file, std::uint64_t offset, std::span<std::byte> dst) noexcept
+				: m_IO(&io), m_File(&file), m_Offset(offset), m_Dst(dst)
+			{
+			}
+
+			[[nodiscard]] bool await_ready() const noexcept { return m_Dst.empty(); }
+
+			template<typename Promise>
+			void await_suspend(std::coroutine_handle<Promise> handle)
+			{
+				Scheduler* scheduler = handle.promise().GetScheduler();
+				m_IO->ReadAsync(*m_File, m_Offset, m_Dst, [this, scheduler, handle](const IOResult& result) {
+					m_Result = result;
+					if (scheduler)
+						scheduler->Schedule(handle);
+					else
+						handle.resume();
+				});
+			}
+
+			[[nodiscard]] IOResult await_resume() const noexcept { return m_Result; }
+
+		private:
+			IOService* m_IO;
+			const FileHandle* m_File;
+			std::uint64_t m_Offset;
+			std::span<std::byte> m_Dst;
+			IOResult m_Result;
+		};
+
+		[[nodiscard]] ReadAwaitable AwaitRead(const FileHandle& file, std::uint64_t offset, std::span<std::byte> dst) noexcept
+		{
+			return ReadAwaitable(*this, file, offset, dst);
+		}
+
+	private:
+		struct Request
+		{
+			FileHandle::NativeHandle File{};
+			std::uint64_t Offset = 0;
+			std::byte* Dst = nullptr;
+			std::size_t Size = 0;
+			std::size_t Done = 0;
+			int Error = 0; // set up front for requests that can never be issued (e.g. closed file)
+			Callback OnComplete;
+		};
+
+		void HandleCompletion(const IOCompletion& completion) noexcept;
+		void Finish(std::uint32_t slot, int error) noexcept;
+		[[nodiscard]] bool QueueSlot(std::uint32_t slot) noexcept;
+
+	private:
+		std::unique_ptr<IOBackend> m_Backend;
+
+		mutable std::mutex m_IncomingMutex;
+		std::vector<Request> m_Incoming; // filled by ReadAsync() from any thread
+
+		// Main thread only.
+		std::vector<Request> m_Waiting;   // accepted but no backend slot yet
+		std::vector<Request> m_Slots;     // in flight, indexed by completion id
+		std::vector<std::uint32_t> m_FreeSlots;
+		std::vector<std::uint32_t> m_Retry;   // in-flight slots whose continuation did not fit
+		std::vector<IOCompletion> m_Completions;
+		IOStats m_Stats;
+
+		WakeEvent* m_WakeEvent = nullptr;
+		bool m_SignalsCompletions = false;
+	};
+}
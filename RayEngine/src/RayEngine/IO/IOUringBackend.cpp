@@ -0,0 +1,229 @@
+#include "IOUringBackend.h"
+
+#ifdef __linux__
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/WakeEvent.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace RayEngine
+{
+	namespace
+	{
+		int SysSetup(unsigned entries, io_uring_params* params) noexcept
+		{
+			return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+		}
+
+		int SysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) noexcept
+		{
+			return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+		}
+
+		int SysRegister(int fd, unsigned opcode, void* arg, unsigned count) noexcept
+		{
+			return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+		}
+
+		unsigned LoadAcquire(unsigned* ptr) noexcept
+		{
+			return std::atomic_ref<unsigned>(*ptr).load(std::memory_order_acquire);
+		}
+
+		void StoreRelease(unsigned* ptr, unsigned value) noexcept
+		{
+			std::atomic_ref<unsigned>(*ptr).store(value, std::memory_order_release);
+		}
+	}
+
+	std::unique_ptr<IOUringBackend> IOUringBackend::Create(unsigned entries) noexcept
+	{
+		std::unique_ptr<IOUringBackend> backend(new (std::nothrow) IOUringBackend());
+		if (!backend || !backend->Setup(entries))
+			return nullptr;
+		return backend;
+	}
+
+	IOUringBackend::~IOUringBackend()
+	{
+		if (m_Sqes)
+			::munmap(m_Sqes, m_SqesSize);
+		if (m_CqRing && m_CqRing != m_SqRing)
+			::munmap(m_CqRing, m_CqRingSize);
+		if (m_SqRing)
+			::munmap(m_SqRing, m_SqRingSize);
+		if (m_RingFd >= 0)
+			::close(m_RingFd);
+	}
+
+	bool IOUringBackend::Setup(unsigned entries) noexcept
+	{
+		io_uring_params params{};
+		m_RingFd = SysSetup(entries, &params);
+		if (m_RingFd < 0)
+		{
+			RAY_CORE_WARN("[IOUring] io_uring_setup failed: {}", std::strerror(errno));
+			return false;
+		}
+
+		// IORING_OP_READ needs Linux 5.6; probe instead of trusting the version string.
+		constexpr unsigned probeOps = 256;
+		alignas(io_uring_probe) unsigned char probeStorage[sizeof(io_uring_probe) + probeOps * sizeof(io_uring_probe_op)]{};
+		auto* probe = reinterpret_cast<io_uring_probe*>(probeStorage);
+		if (SysRegister(m_RingFd, IORING_REGISTER_PROBE, probe, probeOps) < 0
+			|| probe->last_op < IORING_OP_READ
+			|| !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED))
+		{
+			RAY_CORE_WARN("[IOUring] IORING_OP_READ not supported by this kernel");
+			return false;
+		}
+
+		m_SqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		m_CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMmap)
+			m_SqRingSize = m_CqRingSize = std::max(m_SqRingSize, m_CqRingSize);
+
+		m_SqRing = ::mmap(nullptr, m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQ_RING);
+		if (m_SqRing == MAP_FAILED)
+		{
+			m_SqRing = nullptr;
+			RAY_CORE_WARN("[IOUring] mmap of SQ ring failed: {}", std::strerror(errno));
+			return false;
+		}
+
+		if (singleMmap)
+		{
+			m_CqRing = m_SqRing;
+		}
+		else
+		{
+			m_CqRing = ::mmap(nullptr, m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_CQ_RING);
+			if (m_CqRing == MAP_FAILED)
+			{
+				m_CqRing = nullptr;
+				RAY_CORE_WARN("[IOUring] mmap of CQ ring failed: {}", std::strerror(errno));
+				return false;
+			}
+		}
+
+		m_SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = ::mmap(nullptr, m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED)
+		{
+			RAY_CORE_WARN("[IOUring] mmap of SQEs failed: {}", std::strerror(errno));
+			return false;
+		}
+		m_Sqes = static_cast<io_uring_sqe*>(sqes);
+
+		auto* sq = static_cast<unsigned char*>(m_SqRing);
+		m_SqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		m_SqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		m_SqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		m_SqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		m_SqEntries = params.sq_entries;
+
+		auto* cq = static_cast<unsigned char*>(m_CqRing);
+		m_CqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		m_CqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		m_CqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		m_Cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+		m_CqEntries = params.cq_entries;
+		return true;
+	}
+
+	std::size_t IOUringBackend::GetFreeSlots() const noexcept
+	{
+		// Never have more in flight than the CQ can hold, so completions are never dropped.
+		const unsigned sqUsed = *m_SqTail - LoadAcquire(m_SqHead);
+		const unsigned sqFree = m_SqEntries - sqUsed;
+		const unsigned cqFree = m_CqEntries - (m_InFlight + m_Unsubmitted);
+		return std::min(sqFree, cqFree);
+	}
+
+	bool IOUringBackend::Queue(std::uint32_t id, FileHandle::NativeHandle file, std::uint64_t offset, std::byte* dst, std::size_t size) noexcept
+	{
+		if (GetFreeSlots() == 0)
+			return false;
+
+		const unsigned tail = *m_SqTail; // only this thread writes the SQ tail
+		const unsigned index = tail & m_SqMask;
+		io_uring_sqe& sqe = m_Sqes[index];
+		std::memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode = IORING_OP_READ;
+		sqe.fd = file;
+		sqe.off = offset;
+		sqe.addr = reinterpret_cast<std::uint64_t>(dst);
+		sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(size, 0x7ffff000u)); // kernel per-call read limit
+		sqe.user_data = id;
+		m_SqArray[index] = index;
+		StoreRelease(m_SqTail, tail + 1);
+		m_Unsubmitted++;
+		return true;
+	}
+
+	void IOUringBackend::Flush() noexcept
+	{
+		while (m_Unsubmitted > 0)
+		{
+			const int submitted = SysEnter(m_RingFd, m_Unsubmitted, 0, 0);
+			if (submitted < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				// EAGAIN/EBUSY: the kernel is short on resources; retry on the next Flush().
+				if (errno != EAGAIN && errno != EBUSY)
+					RAY_CORE_ERROR("[IOUring] io_uring_enter failed: {}", std::strerror(errno));
+				return;
+			}
+			m_Unsubmitted -= static_cast<unsigned>(submitted);
+			m_InFlight += static_cast<unsigned>(submitted);
+			if (submitted == 0)
+				return;
+		}
+	}
+
+	bool IOUringBackend::SetCompletionEvent(WakeEvent* event) noexcept
+	{
+		if (m_EventRegistered)
+		{
+			(void)SysRegister(m_RingFd, IORING_UNREGISTER_EVENTFD, nullptr, 0);
+			m_EventRegistered = false;
+		}
+		if (!event)
+			return true;
+
+		int fd = event->GetNativeHandle();
+		if (fd < 0)
+			return false;
+		if (SysRegister(m_RingFd, IORING_REGISTER_EVENTFD, &fd, 1) < 0)
+		{
+			RAY_CORE_WARN("[IOUring] cannot register completion eventfd: {}", std::strerror(errno));
+			return false;
+		}
+		m_EventRegistered = true;
+		return true;
+	}
+
+	void IOUringBackend::Reap(std::vector<IOCompletion>& out) noexcept
+	{
+		unsigned head = *m_CqHead; // only this thread writes the CQ head
+		const unsigned tail = LoadAcquire(m_CqTail);
+		while (head != tail)
+		{
+			const io_uring_cqe& cqe = m_Cqes[head & m_CqMask];
+			out.push_back(IOCompletion{ static_cast<std::uint32_t>(cqe.user_data), cqe.res });
+			++head;
+			--m_InFlight;
+		}
+		StoreRelease(m_CqHead, head);
+	}
+}
+#endif
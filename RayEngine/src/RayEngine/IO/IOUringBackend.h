@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+
+#include "IOBackend.h"
+
+#ifdef __linux__
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace RayEngine
+{
+	// io_uring backend talking to the kernel through raw syscalls (no liburing dependency).
+	// Reads are written straight into the SQ ring by Queue(), Flush() submits the whole batch with
+	// a single io_uring_enter(), and Reap() walks the CQ ring without any syscall.
+	class IOUringBackend final : public IOBackend
+	{
+	public:
+		// Returns nullptr if io_uring (or IORING_OP_READ) is unavailable on this kernel.
+		[[nodiscard]] static std::unique_ptr<IOUringBackend> Create(unsigned entries) noexcept;
+		~IOUringBackend() override;
+
+		IOUringBackend(const IOUringBackend&) = delete;
+		IOUringBackend& operator=(const IOUringBackend&) = delete;
+		IOUringBackend(IOUringBackend&&) = delete;
+		IOUringBackend& operator=(IOUringBackend&&) = delete;
+
+		[[nodiscard]] const char* GetName() const noexcept override { return "io_uring"; }
+		[[nodiscard]] std::size_t GetFreeSlots() const noexcept override;
+		bool Queue(std::uint32_t id, FileHandle::NativeHandle file, std::uint64_t offset, std::byte* dst, std::size_t size) noexcept override;
+		void Flush() noexcept override;
+		void Reap(std::vector<IOCompletion>& out) noexcept override;
+		// Registers the event's eventfd with the ring: the kernel signals it on every completion.
+		bool SetCompletionEvent(WakeEvent* event) noexcept override;
+
+	private:
+		IOUringBackend() = default;
+		[[nodiscard]] bool Setup(unsigned entries) noexcept;
+
+	private:
+		int m_RingFd = -1;
+		bool m_EventRegistered = false;
+
+		void* m_SqRing = nullptr;
+		std::size_t m_SqRingSize = 0;
+		void* m_CqRing = nullptr;
+		std::size_t m_CqRingSize = 0;
+		io_uring_sqe* m_Sqes = nullptr;
+		std::size_t m_SqesSize = 0;
+
+		unsigned* m_SqHead = nullptr;
+		unsigned* m_SqTail = nullptr;
+		unsigned* m_SqArray = nullptr;
+		unsigned m_SqMask = 0;
+		unsigned m_SqEntries = 0;
+
+		unsigned* m_CqHead = nullptr;
+		unsigned* m_CqTail = nullptr;
+		io_uring_cqe* m_Cqes = nullptr;
+		unsigned m_CqMask = 0;
+		unsigned m_CqEntries = 0;
+
+		unsigned m_Unsubmitted = 0; // queued in the SQ ring but not yet passed to io_uring_enter
+		unsigned m_InFlight = 0;    // submitted and not yet reaped
+	};
+}
+#endif
@@ -0,0 +1,109 @@
+#include "PreadBackend.h"
+#include "RayEngine/Core/WakeEvent.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace RayEngine
+{
+	PreadBackend::PreadBackend(std::size_t workerCount, std::size_t queueDepth)
+		: m_Workers(workerCount)
+		, m_QueueDepth(queueDepth)
+	{
+		m_Batch.reserve(queueDepth);
+		m_Completed.reserve(queueDepth);
+	}
+
+	PreadBackend::~PreadBackend()
+	{
+		m_Workers.Shutdown();
+	}
+
+	std::size_t PreadBackend::GetFreeSlots() const noexcept
+	{
+		const std::size_t used = m_InFlight + m_Batch.size();
+		return used < m_QueueDepth ? m_QueueDepth - used : 0;
+	}
+
+	bool PreadBackend::Queue(std::uint32_t id, FileHandle::NativeHandle file, std::uint64_t offset, std::byte* dst, std::size_t size) noexcept
+	{
+		if (GetFreeSlots() == 0)
+			return false;
+		m_Batch.push_back(Read{ id, file, offset, dst, size });
+		return true;
+	}
+
+	void PreadBackend::Flush() noexcept
+	{
+		for (const Read& read : m_Batch)
+		{
+			const bool queued = m_Workers.Submit([this, read]() {
+				const IOCompletion completion{ read.Id, ReadAt(read) };
+				{
+					std::lock_guard lock(m_CompletedMutex);
+					m_Completed.push_back(completion);
+				}
+				if (WakeEvent* event = m_CompletionEvent.load(std::memory_order_acquire))
+					event->Signal();
+			});
+
+			if (!queued)
+			{
+				std::lock_guard lock(m_CompletedMutex);
+				m_Completed.push_back(IOCompletion{ read.Id, -ECANCELED });
+			}
+			m_InFlight++;
+		}
+		m_Batch.clear();
+	}
+
+	void PreadBackend::Reap(std::vector<IOCompletion>& out) noexcept
+	{
+		std::lock_guard lock(m_CompletedMutex);
+		out.insert(out.end(), m_Completed.begin(), m_Completed.end());
+		m_InFlight -= m_Completed.size();
+		m_Completed.clear();
+	}
+
+	bool PreadBackend::SetCompletionEvent(WakeEvent* event) noexcept
+	{
+		m_CompletionEvent.store(event, std::memory_order_release);
+		return true;
+	}
+
+#ifdef _WIN32
+	std::int64_t PreadBackend::ReadAt(const Read& read) noexcept
+	{
+		OVERLAPPED overlapped{};
+		overlapped.Offset = static_cast<DWORD>(read.Offset & 0xffffffffull);
+		overlapped.OffsetHigh = static_cast<DWORD>(read.Offset >> 32);
+		const DWORD toRead = static_cast<DWORD>(std::min<std::size_t>(read.Size, 0x7ffff000u));
+		DWORD bytesRead = 0;
+		if (!ReadFile(read.File, read.Dst, toRead, &bytesRead, &overlapped))
+		{
+			const DWORD error = GetLastError();
+			return error == ERROR_HANDLE_EOF ? 0 : -static_cast<std::int64_t>(error);
+		}
+		return bytesRead;
+	}
+#else
+	std::int64_t PreadBackend::ReadAt(const Read& read) noexcept
+	{
+		for (;;)
+		{
+			const ssize_t result = ::pread(read.File, read.Dst, read.Size, static_cast<off_t>(read.Offset));
+			if (result >= 0)
+				return result;
+			if (errno != EINTR)
+				return -errno;
+		}
+	}
+#endif
+}
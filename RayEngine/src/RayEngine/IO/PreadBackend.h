@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "IOBackend.h"
+#include "RayEngine/Core/ThreadPool.h"
+
+namespace RayEngine
+{
+	// Portable fallback: each read is a blocking positional read (pread / ReadFile with an offset)
+	// executed on a dedicated I/O thread pool. Blocking I/O never runs on the engine's compute pool.
+	class PreadBackend final : public IOBackend
+	{
+	public:
+		PreadBackend(std::size_t workerCount, std::size_t queueDepth);
+		~PreadBackend() override;
+
+		PreadBackend(const PreadBackend&) = delete;
+		PreadBackend& operator=(const PreadBackend&) = delete;
+		PreadBackend(PreadBackend&&) = delete;
+		PreadBackend& operator=(PreadBackend&&) = delete;
+
+		[[nodiscard]] const char* GetName() const noexcept override { return "pread"; }
+		[[nodiscard]] std::size_t GetFreeSlots() const noexcept override;
+		bool Queue(std::uint32_t id, FileHandle::NativeHandle file, std::uint64_t offset, std::byte* dst, std::size_t size) noexcept override;
+		void Flush() noexcept override;
+		void Reap(std::vector<IOCompletion>& out) noexcept override;
+		bool SetCompletionEvent(WakeEvent* event) noexcept override;
+
+	private:
+		struct Read
+		{
+			std::uint32_t Id;
+			FileHandle::NativeHandle File;
+			std::uint64_t Offset;
+			std::byte* Dst;
+			std::size_t Size;
+		};
+
+		[[nodiscard]] static std::int64_t ReadAt(const Read& read) noexcept;
+
+	private:
+		ThreadPool m_Workers;
+		std::size_t m_QueueDepth;
+		std::size_t m_InFlight = 0; // main thread only
+
+		std::vector<Read> m_Batch; // queued since the last Flush()
+
+		std::mutex m_CompletedMutex;
+		std::vector<IOCompletion> m_Completed;
+		std::atomic<WakeEvent*> m_CompletionEvent = nullptr;
+	};
+}
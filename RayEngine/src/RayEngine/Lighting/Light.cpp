@@ -0,0 +1,137 @@
+#include "Light.h"
+
+namespace RayEngine
+{
+	namespace
+	{
+		[[nodiscard]] float SafeSqrt(float x) noexcept { return std::sqrt(std::max(0.0f, x)); }
+		[[nodiscard]] float SafeAcos(float x) noexcept { return std::acos(std::clamp(x, -1.0f, 1.0f)); }
+
+		// cos(max(0, a - b)) and sin(max(0, a - b)) from the sines and cosines of a and b.
+		[[nodiscard]] float CosSubClamped(float sinA, float cosA, float sinB, float cosB) noexcept
+		{
+			return cosA > cosB ? 1.0f : cosA * cosB + sinA * sinB;
+		}
+
+		[[nodiscard]] float SinSubClamped(float sinA, float cosA, float sinB, float cosB) noexcept
+		{
+			return cosA > cosB ? 0.0f : sinA * cosB - cosA * sinB;
+		}
+
+		// Rotate v by `angle` around the unit axis (Rodrigues).
+		[[nodiscard]] Vec3 Rotate(const Vec3& v, const Vec3& axis, float angle) noexcept
+		{
+			const float s = std::sin(angle), c = std::cos(angle);
+			return v * c + Cross(axis, v) * s + axis * (Dot(axis, v) * (1.0f - c));
+		}
+
+		// Cosine of the half-angle of the cone of directions from `point` that can reach `box`.
+		[[nodiscard]] float BoundSubtendedCos(const AABB& box, const Vec3& point) noexcept
+		{
+			const Vec3 center = box.GetCentroid();
+			const float radius2 = Dot(box.Max - center, box.Max - center);
+			const float distance2 = Dot(point - center, point - center);
+			if (distance2 < radius2)
+				return -1.0f;
+			return SafeSqrt(1.0f - radius2 / distance2);
+		}
+	}
+
+	DirectionCone Union(const DirectionCone& a, const DirectionCone& b) noexcept
+	{
+		const float thetaA = SafeAcos(a.CosTheta);
+		const float thetaB = SafeAcos(b.CosTheta);
+		const float thetaD = SafeAcos(Dot(a.Axis, b.Axis));
+		constexpr float pi = std::numbers::pi_v<float>;
+		if (std::min(thetaD + thetaB, pi) <= thetaA)
+			return a;
+		if (std::min(thetaD + thetaA, pi) <= thetaB)
+			return b;
+
+		const float thetaO = 0.5f * (thetaA + thetaD + thetaB);
+		if (thetaO >= pi)
+			return DirectionCone::EntireSphere();
+
+		const Vec3 rotationAxis = Cross(a.Axis, b.Axis);
+		if (Dot(rotationAxis, rotationAxis) < 1e-12f)
+			return DirectionCone::EntireSphere();
+		return { Normalize(Rotate(a.Axis, Normalize(rotationAxis), thetaO - thetaA)), std::cos(thetaO) };
+	}
+
+	LightBounds LightBounds::Of(const Light& light) noexcept
+	{
+		LightBounds bounds;
+		bounds.Power = light.GetPower();
+		bounds.Bounds.Grow(light.Position);
+		if (light.Type == LightType::Point)
+		{
+			bounds.Normals = DirectionCone::EntireSphere();
+			bounds.CosThetaEmit = 0.0f; // cos(pi / 2)
+			return bounds;
+		}
+
+		bounds.Bounds.Grow(light.Position + light.Edge1);
+		bounds.Bounds.Grow(light.Position + light.Edge2);
+		const Vec3 normal = Cross(light.Edge1, light.Edge2);
+		const float length = Length(normal);
+		bounds.Normals = { length > 0.0f ? normal * (1.0f / length) : Vec3{ 0.0f, 0.0f, 1.0f }, 1.0f };
+		bounds.CosThetaEmit = 0.0f;
+		bounds.TwoSided = light.TwoSided;
+		return bounds;
+	}
+
+	float LightBounds::Importance(const Vec3& point, const Vec3& normal) const noexcept
+	{
+		const Vec3 center = Bounds.GetCentroid();
+		const Vec3 extent = Bounds.GetExtent();
+		// Clamp the distance to the box size so receivers inside or next to the box do not blow up.
+		const float distance2 = std::max(Dot(point - center, point - center), 0.5f * Length(extent));
+		const Vec3 toPoint = point - center;
+		const float toPointLength = Length(toPoint);
+		const Vec3 direction = toPointLength > 0.0f ? toPoint * (1.0f / toPointLength) : Vec3{ 0.0f, 0.0f, 1.0f };
+
+		float cosThetaW = Dot(Normals.Axis, direction);
+		if (TwoSided)
+			cosThetaW = std::abs(cosThetaW);
+		const float sinThetaW = SafeSqrt(1.0f - cosThetaW * cosThetaW);
+
+		const float cosThetaB = BoundSubtendedCos(Bounds, point);
+		const float sinThetaB = SafeSqrt(1.0f - cosThetaB * cosThetaB);
+
+		// theta' = max(0, thetaW - thetaO - thetaB): the smallest emission angle towards the point.
+		const float cosThetaO = Normals.CosTheta;
+		const float sinThetaO = SafeSqrt(1.0f - cosThetaO * cosThetaO);
+		const float cosThetaX = CosSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+		const float sinThetaX = SinSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+		const float cosThetaP = CosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+		if (cosThetaP <= CosThetaEmit)
+			return 0.0f;
+
+		float importance = Power * cosThetaP / distance2;
+		if (Dot(normal, normal) > 0.0f)
+		{
+			// Smallest incidence angle at the receiver over the directions towards the box.
+			const float cosThetaI = -Dot(direction, normal);
+			const float sinThetaI = SafeSqrt(1.0f - cosThetaI * cosThetaI);
+			importance *= std::max(0.0f, CosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB));
+		}
+		return std::max(importance, 0.0f);
+	}
+
+	LightBounds Union(const LightBounds& a, const LightBounds& b) noexcept
+	{
+		if (a.Power == 0.0f)
+			return b;
+		if (b.Power == 0.0f)
+			return a;
+
+		LightBounds result;
+		result.Bounds = a.Bounds;
+		result.Bounds.Grow(b.Bounds);
+		result.Normals = Union(a.Normals, b.Normals);
+		result.CosThetaEmit = std::min(a.CosThetaEmit, b.CosThetaEmit);
+		result.Power = a.Power + b.Power;
+		result.TwoSided = a.TwoSided || b.TwoSided;
+		return result;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+#include "RayEngine/Geometry/Math.h"
+
+namespace RayEngine
+{
+	enum class LightType : std::uint8_t
+	{
+		Point,   // isotropic; Emission is intensity (W/sr per channel)
+		Triangle // diffuse area emitter; Emission is radiance, emitted along the (v1-v0)x(v2-v0) side
+	};
+
+	struct Light
+	{
+		LightType Type = LightType::Point;
+		bool TwoSided = false;      // triangles only
+		Vec3 Position;              // point position, or triangle vertex 0
+		Vec3 Edge1;                 // triangle: v1 - v0
+		Vec3 Edge2;                 // triangle: v2 - v0
+		Vec3 Emission;
+
+		[[nodiscard]] static Light MakePoint(const Vec3& position, const Vec3& intensity) noexcept
+		{
+			Light light;
+			light.Position = position;
+			light.Emission = intensity;
+			return light;
+		}
+
+		[[nodiscard]] static Light MakeTriangle(const Vec3& v0, const Vec3& v1, const Vec3& v2, const Vec3& radiance, bool twoSided = false) noexcept
+		{
+			Light light;
+			light.Type = LightType::Triangle;
+			light.TwoSided = twoSided;
+			light.Position = v0;
+			light.Edge1 = v1 - v0;
+			light.Edge2 = v2 - v0;
+			light.Emission = radiance;
+			return light;
+		}
+
+		[[nodiscard]] float GetArea() const noexcept { return 0.5f * Length(Cross(Edge1, Edge2)); }
+
+		// Scalar emitted power (mean over channels), used as the selection weight.
+		[[nodiscard]] float GetPower() const noexcept
+		{
+			const float emission = (Emission.X + Emission.Y + Emission.Z) / 3.0f;
+			if (Type == LightType::Point)
+				return 4.0f * std::numbers::pi_v<float> * emission;
+			return std::numbers::pi_v<float> * emission * GetArea() * (TwoSided ? 2.0f : 1.0f);
+		}
+	};
+
+	// Set of directions within an angle of an axis. CosTheta == -1 covers the whole sphere.
+	struct DirectionCone
+	{
+		Vec3 Axis{ 0.0f, 0.0f, 1.0f };
+		float CosTheta = 1.0f;
+
+		[[nodiscard]] static DirectionCone EntireSphere() noexcept { return { { 0.0f, 0.0f, 1.0f }, -1.0f }; }
+	};
+
+	[[nodiscard]] DirectionCone Union(const DirectionCone& a, const DirectionCone& b) noexcept;
+
+	// Spatial, directional and power bounds of a set of emitters (Conty Estevez & Kulla, "Importance
+	// Sampling of Many Lights with Adaptive Tree Splitting", in the form used by pbrt-v4): lights
+	// inside Bounds emit Power, with normals within Normals.CosTheta of Normals.Axis, into directions
+	// at most acos(CosThetaEmit) away from those normals.
+	struct LightBounds
+	{
+		AABB Bounds;
+		DirectionCone Normals;
+		float CosThetaEmit = 0.0f;
+		float Power = 0.0f;
+		bool TwoSided = false;
+
+		[[nodiscard]] static LightBounds Of(const Light& light) noexcept;
+
+		// Conservative estimate of the contribution to a receiver at `point` whose surface faces
+		// `normal` (a zero normal skips the receiver cosine, e.g. for volumes).
+		[[nodiscard]] float Importance(const Vec3& point, const Vec3& normal) const noexcept;
+	};
+
+	[[nodiscard]] LightBounds Union(const LightBounds& a, const LightBounds& b) noexcept;
+}
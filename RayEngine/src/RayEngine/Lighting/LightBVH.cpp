@@ -0,0 +1,328 @@
+#include "LightBVH.h"
+#include "RayEngine/Core/ParallelFor.h"
+#include "RayEngine/Core/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::uint32_t noNode = std::numeric_limits<std::uint32_t>::max();
+		constexpr std::size_t parallelChunk = 4096;
+		// Below this depth splits use the SAOH; deeper ranges take object medians so the trail of
+		// child choices always fits in 64 bits.
+		constexpr std::uint32_t heuristicDepthLimit = 32;
+		constexpr float oneMinusEpsilon = 0x1.fffffep-1f;
+
+		// Surface area orientation heuristic (Conty Estevez & Kulla; pbrt-v4 LightBVHAggregate).
+		[[nodiscard]] float EvaluateCost(const LightBounds& bounds, const AABB& parent, int axis) noexcept
+		{
+			constexpr float pi = std::numbers::pi_v<float>;
+			const float thetaO = std::acos(std::clamp(bounds.Normals.CosTheta, -1.0f, 1.0f));
+			const float thetaE = std::acos(std::clamp(bounds.CosThetaEmit, -1.0f, 1.0f));
+			const float thetaW = std::min(thetaO + thetaE, pi);
+			const float sinThetaO = std::sqrt(std::max(0.0f, 1.0f - bounds.Normals.CosTheta * bounds.Normals.CosTheta));
+			const float orientation = 2.0f * pi * (1.0f - bounds.Normals.CosTheta)
+				+ 0.5f * pi * (2.0f * thetaW * sinThetaO - std::cos(thetaO - 2.0f * thetaW) - 2.0f * thetaO * sinThetaO + bounds.Normals.CosTheta);
+			// Penalize thin slabs along the split axis.
+			const Vec3 extent = parent.GetExtent();
+			const float maxExtent = std::max({ extent.X, extent.Y, extent.Z });
+			const float regularity = extent[axis] > 0.0f ? maxExtent / extent[axis] : 1.0f;
+			return bounds.Power * orientation * regularity * bounds.Bounds.GetSurfaceArea();
+		}
+	}
+
+	LightBVH::LightBVH(const std::vector<Light>& lights, ThreadPool* pool)
+		: m_Lights(&lights)
+	{
+		Build(pool);
+	}
+
+	void LightBVH::Rebuild(ThreadPool* pool)
+	{
+		Build(pool);
+	}
+
+	void LightBVH::Build(ThreadPool* pool)
+	{
+		const std::vector<Light>& lights = *m_Lights;
+		m_Nodes.clear();
+		m_Trails.assign(lights.size(), 0);
+		m_LightNodes.assign(lights.size(), noNode);
+		m_Depth = 0;
+
+		std::vector<BuildLight> build(lights.size());
+		ParallelFor(pool, (lights.size() + parallelChunk - 1) / parallelChunk, [&](std::size_t chunk) {
+			const std::size_t end = std::min(lights.size(), (chunk + 1) * parallelChunk);
+			for (std::size_t i = chunk * parallelChunk; i < end; ++i)
+			{
+				const LightBounds bounds = LightBounds::Of(lights[i]);
+				build[i] = BuildLight{ static_cast<std::uint32_t>(i), bounds, bounds.Bounds.GetCentroid() };
+			}
+		});
+		std::erase_if(build, [](const BuildLight& light) { return !(light.Bounds.Power > 0.0f); });
+		if (build.empty())
+			return;
+
+		// Top of the tree: split serially until there are enough subtrees to keep every thread busy.
+		const std::size_t threads = (pool ? pool->GetWorkerCount() : 0) + 1;
+		const std::size_t subtreeSize = threads > 1 ? std::max<std::size_t>(256, build.size() / (8 * threads)) : build.size();
+		m_Nodes.emplace_back();
+		std::vector<BuildTask> subtrees;
+		std::vector<BuildTask> pending{ BuildTask{ 0, 0, static_cast<std::uint32_t>(build.size()), 0, 0 } };
+		while (!pending.empty())
+		{
+			const BuildTask task = pending.back();
+			pending.pop_back();
+			if (task.End - task.Begin <= subtreeSize || task.End - task.Begin == 1)
+			{
+				subtrees.push_back(task);
+				continue;
+			}
+
+			const std::uint32_t split = Partition(build, task.Begin, task.End, task.Depth);
+			const auto left = static_cast<std::uint32_t>(m_Nodes.size());
+			m_Nodes.emplace_back();
+			m_Nodes.emplace_back();
+			m_Nodes[task.Node].First = left;
+			m_Nodes[task.Node].Count = 0;
+			pending.push_back(BuildTask{ left, task.Begin, split, task.Depth + 1, task.Trail });
+			pending.push_back(BuildTask{ left + 1, split, task.End, task.Depth + 1, task.Trail | (std::uint64_t{ 1 } << task.Depth) });
+		}
+
+		// Subtrees build into their own node arrays (local node 0 stands for the task's node)...
+		std::vector<std::vector<LightBVHNode>> subtreeNodes(subtrees.size());
+		std::vector<std::uint32_t> subtreeDepths(subtrees.size(), 0);
+		ParallelFor(pool, subtrees.size(), [&](std::size_t i) {
+			subtreeNodes[i].emplace_back();
+			BuildSubtree(build, subtreeNodes[i], subtrees[i], subtreeDepths[i]);
+		});
+
+		// ...and are appended after the top nodes, so every child still follows its parent.
+		for (std::size_t i = 0; i < subtrees.size(); ++i)
+		{
+			const std::vector<LightBVHNode>& local = subtreeNodes[i];
+			const auto base = static_cast<std::uint32_t>(m_Nodes.size()) - 1;
+			for (std::size_t k = 0; k < local.size(); ++k)
+			{
+				LightBVHNode node = local[k];
+				if (!node.IsLeaf())
+					node.First += base;
+				const std::uint32_t global = k == 0 ? subtrees[i].Node : base + static_cast<std::uint32_t>(k);
+				if (k == 0)
+					m_Nodes[global] = node;
+				else
+					m_Nodes.push_back(node);
+				if (node.IsLeaf())
+					m_LightNodes[node.First] = global;
+			}
+			m_Depth = std::max(m_Depth, subtreeDepths[i]);
+		}
+
+		Refit(pool);
+	}
+
+	void LightBVH::BuildSubtree(std::vector<BuildLight>& build, std::vector<LightBVHNode>& nodes, const BuildTask& task, std::uint32_t& maxDepth)
+	{
+		std::vector<BuildTask> pending{ BuildTask{ 0, task.Begin, task.End, task.Depth, task.Trail } };
+		while (!pending.empty())
+		{
+			const BuildTask current = pending.back();
+			pending.pop_back();
+			maxDepth = std::max(maxDepth, current.Depth);
+
+			if (current.End - current.Begin == 1)
+			{
+				const std::uint32_t light = build[current.Begin].Index;
+				nodes[current.Node].First = light;
+				nodes[current.Node].Count = 1;
+				m_Trails[light] = current.Trail;
+				continue;
+			}
+
+			const std::uint32_t split = Partition(build, current.Begin, current.End, current.Depth);
+			const auto left = static_cast<std::uint32_t>(nodes.size());
+			nodes.emplace_back();
+			nodes.emplace_back();
+			nodes[current.Node].First = left;
+			nodes[current.Node].Count = 0;
+			pending.push_back(BuildTask{ left, current.Begin, split, current.Depth + 1, current.Trail });
+			pending.push_back(BuildTask{ left + 1, split, current.End, current.Depth + 1, current.Trail | (std::uint64_t{ 1 } << current.Depth) });
+		}
+	}
+
+	std::uint32_t LightBVH::Partition(std::vector<BuildLight>& build, std::uint32_t begin, std::uint32_t end, std::uint32_t depth)
+	{
+		assert(end - begin >= 2);
+		AABB parentBounds, centroidBounds;
+		for (std::uint32_t i = begin; i < end; ++i)
+		{
+			parentBounds.Grow(build[i].Bounds.Bounds);
+			centroidBounds.Grow(build[i].Centroid);
+		}
+
+		float bestCost = std::numeric_limits<float>::infinity();
+		int bestAxis = -1;
+		std::uint32_t bestSplit = 0;
+		const auto binOf = [&](const BuildLight& light, int axis) {
+			const float extent = centroidBounds.Max[axis] - centroidBounds.Min[axis];
+			const auto bin = static_cast<std::uint32_t>((light.Centroid[axis] - centroidBounds.Min[axis]) * (binCount / extent));
+			return std::min(binCount - 1, bin);
+		};
+
+		for (int axis = 0; axis < 3 && depth < heuristicDepthLimit; ++axis)
+		{
+			if (!(centroidBounds.Max[axis] > centroidBounds.Min[axis]))
+				continue;
+
+			std::array<LightBounds, binCount> bins{};
+			std::array<std::uint32_t, binCount> counts{};
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				const std::uint32_t bin = binOf(build[i], axis);
+				bins[bin] = Union(bins[bin], build[i].Bounds);
+				counts[bin]++;
+			}
+
+			// Right-hand sides first, then sweep from the left.
+			std::array<float, binCount> rightCost{};
+			std::array<std::uint32_t, binCount> rightCount{};
+			LightBounds accumulated;
+			std::uint32_t accumulatedCount = 0;
+			for (std::uint32_t i = binCount - 1; i > 0; --i)
+			{
+				accumulated = Union(accumulated, bins[i]);
+				accumulatedCount += counts[i];
+				rightCost[i] = EvaluateCost(accumulated, parentBounds, axis);
+				rightCount[i] = accumulatedCount;
+			}
+
+			accumulated = {};
+			accumulatedCount = 0;
+			for (std::uint32_t i = 1; i < binCount; ++i)
+			{
+				accumulated = Union(accumulated, bins[i - 1]);
+				accumulatedCount += counts[i - 1];
+				if (accumulatedCount == 0 || rightCount[i] == 0)
+					continue;
+				const float cost = EvaluateCost(accumulated, parentBounds, axis) + rightCost[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i;
+				}
+			}
+		}
+
+		if (bestAxis >= 0)
+		{
+			const auto middle = std::partition(build.begin() + begin, build.begin() + end,
+				[&](const BuildLight& light) { return binOf(light, bestAxis) < bestSplit; });
+			return static_cast<std::uint32_t>(middle - build.begin());
+		}
+
+		// Coincident centroids (or too deep): object median.
+		const int axis = centroidBounds.GetLargestAxis();
+		const std::uint32_t middle = begin + (end - begin) / 2;
+		std::nth_element(build.begin() + begin, build.begin() + middle, build.begin() + end,
+			[axis](const BuildLight& a, const BuildLight& b) { return a.Centroid[axis] < b.Centroid[axis]; });
+		return middle;
+	}
+
+	void LightBVH::Refit(ThreadPool* pool)
+	{
+		const std::vector<Light>& lights = *m_Lights;
+		ParallelFor(pool, (m_Nodes.size() + parallelChunk - 1) / parallelChunk, [&](std::size_t chunk) {
+			const std::size_t end = std::min(m_Nodes.size(), (chunk + 1) * parallelChunk);
+			for (std::size_t i = chunk * parallelChunk; i < end; ++i)
+			{
+				if (m_Nodes[i].IsLeaf())
+					m_Nodes[i].Bounds = LightBounds::Of(lights[m_Nodes[i].First]);
+			}
+		});
+
+		// Children always follow their parent, so one backwards pass sees children first.
+		for (std::size_t i = m_Nodes.size(); i-- > 0;)
+		{
+			LightBVHNode& node = m_Nodes[i];
+			if (!node.IsLeaf())
+				node.Bounds = Union(m_Nodes[node.First].Bounds, m_Nodes[node.First + 1].Bounds);
+		}
+	}
+
+	SampledLight LightBVH::Sample(const Vec3& point, const Vec3& normal, float u) const noexcept
+	{
+		if (m_Nodes.empty())
+			return {};
+
+		std::uint32_t index = 0;
+		float pmf = 1.0f;
+		for (;;)
+		{
+			const LightBVHNode& node = m_Nodes[index];
+			if (node.IsLeaf())
+			{
+				// Children were only chosen with non-zero importance; only a lone root needs the check.
+				if (index == 0 && !(node.Bounds.Importance(point, normal) > 0.0f))
+					return {};
+				return SampledLight{ node.First, pmf };
+			}
+
+			const float left = m_Nodes[node.First].Bounds.Importance(point, normal);
+			const float right = m_Nodes[node.First + 1].Bounds.Importance(point, normal);
+			if (!(left + right > 0.0f))
+				return {};
+
+			// Reuse u: rescale the chosen sub-interval back to [0, 1).
+			const float pLeft = left / (left + right);
+			if (u < pLeft)
+			{
+				u = std::min(u / pLeft, oneMinusEpsilon);
+				pmf *= pLeft;
+				index = node.First;
+			}
+			else
+			{
+				u = std::min((u - pLeft) / (1.0f - pLeft), oneMinusEpsilon);
+				pmf *= 1.0f - pLeft;
+				index = node.First + 1;
+			}
+		}
+	}
+
+	float LightBVH::Pmf(const Vec3& point, const Vec3& normal, std::uint32_t lightIndex) const noexcept
+	{
+		if (lightIndex >= m_LightNodes.size() || m_LightNodes[lightIndex] == noNode)
+			return 0.0f;
+
+		std::uint64_t trail = m_Trails[lightIndex];
+		std::uint32_t index = 0;
+		float pmf = 1.0f;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const LightBVHNode& node = m_Nodes[index];
+			const float left = m_Nodes[node.First].Bounds.Importance(point, normal);
+			const float right = m_Nodes[node.First + 1].Bounds.Importance(point, normal);
+			if (!(left + right > 0.0f))
+				return 0.0f;
+			const std::uint32_t child = static_cast<std::uint32_t>(trail & 1);
+			pmf *= (child ? right : left) / (left + right);
+			index = node.First + child;
+			trail >>= 1;
+		}
+		if (index == 0 && !(m_Nodes[0].Bounds.Importance(point, normal) > 0.0f))
+			return 0.0f;
+		return pmf;
+	}
+
+	std::size_t LightBVH::GetMemoryBytes() const noexcept
+	{
+		return m_Nodes.size() * sizeof(LightBVHNode) + m_Trails.size() * sizeof(std::uint64_t) + m_LightNodes.size() * sizeof(std::uint32_t);
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Light.h"
+
+namespace RayEngine
+{
+	class ThreadPool;
+
+	// Count == 0: internal node whose children are First and First + 1.
+	// Count == 1: leaf holding light First.
+	struct LightBVHNode
+	{
+		LightBounds Bounds;
+		std::uint32_t First = 0;
+		std::uint32_t Count = 0;
+
+		[[nodiscard]] bool IsLeaf() const noexcept { return Count != 0; }
+	};
+
+	struct SampledLight
+	{
+		static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint32_t Index = invalidIndex;
+		float Pmf = 0.0f;
+
+		[[nodiscard]] bool IsValid() const noexcept { return Index != invalidIndex; }
+	};
+
+	// Light hierarchy for importance-sampled light selection. Every node bounds the position,
+	// emission directions and power of its lights; selection walks from the root, picking each
+	// child with probability proportional to its LightBounds::Importance for the shading point,
+	// so nearby, bright, facing lights are chosen far more often than with uniform or power-only
+	// selection, at O(log n) cost per sample.
+	// One light per leaf; zero-power lights are left out (their pmf is 0). The lights are
+	// referenced, not copied, and must outlive the BVH. Built with a binned surface-area-orientation
+	// heuristic; the top of the tree is split serially and the subtrees are built in parallel.
+	class LightBVH
+	{
+	public:
+		static constexpr std::uint32_t binCount = 12;
+
+		// `pool` may be null (serial build).
+		LightBVH(const std::vector<Light>& lights, ThreadPool* pool = nullptr);
+
+		// Pick a light for a receiver at `point` with surface normal `normal` (zero: no receiver
+		// cosine). `u` in [0, 1). Returns an invalid SampledLight if no light can contribute.
+		[[nodiscard]] SampledLight Sample(const Vec3& point, const Vec3& normal, float u) const noexcept;
+		// Probability that Sample() picks `lightIndex` at this receiver (for MIS).
+		[[nodiscard]] float Pmf(const Vec3& point, const Vec3& normal, std::uint32_t lightIndex) const noexcept;
+
+		// Lights moved or changed power but the set is the same: recompute every node's bounds
+		// bottom-up, keeping the topology. Cheap, but selection quality degrades as lights drift
+		// far from where they were built; Rebuild() restores it.
+		void Refit(ThreadPool* pool = nullptr);
+		void Rebuild(ThreadPool* pool = nullptr);
+
+		[[nodiscard]] const std::vector<Light>& GetLights() const noexcept { return *m_Lights; }
+		[[nodiscard]] const std::vector<LightBVHNode>& GetNodes() const noexcept { return m_Nodes; }
+		[[nodiscard]] std::uint32_t GetDepth() const noexcept { return m_Depth; }
+		[[nodiscard]] std::size_t GetMemoryBytes() const noexcept;
+
+	private:
+		struct BuildLight
+		{
+			std::uint32_t Index;
+			LightBounds Bounds;
+			Vec3 Centroid;
+		};
+
+		struct BuildTask
+		{
+			std::uint32_t Node;  // placeholder node to fill
+			std::uint32_t Begin; // range in the build array
+			std::uint32_t End;
+			std::uint32_t Depth;
+			std::uint64_t Trail;
+		};
+
+		void Build(ThreadPool* pool);
+		// Builds build[task.Begin, task.End) under `nodes[task.Node]`, appending children to `nodes`.
+		void BuildSubtree(std::vector<BuildLight>& build, std::vector<LightBVHNode>& nodes, const BuildTask& task, std::uint32_t& maxDepth);
+		// Partitions a range of at least two lights; returns the split position, strictly inside it.
+		[[nodiscard]] static std::uint32_t Partition(std::vector<BuildLight>& build, std::uint32_t begin, std::uint32_t end, std::uint32_t depth);
+
+	private:
+		const std::vector<Light>* m_Lights;
+		std::vector<LightBVHNode> m_Nodes;
+		// Per light: child choices from the root (bit d set = right child at depth d), for Pmf().
+		std::vector<std::uint64_t> m_Trails;
+		std::vector<std::uint32_t> m_LightNodes; // per light: its leaf, or UINT32_MAX if excluded
+		std::uint32_t m_Depth = 0;
+	};
+}
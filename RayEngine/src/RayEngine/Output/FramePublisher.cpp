@@ -0,0 +1,152 @@
+#include "FramePublisher.h"
+#include "RayEngine/Core/Log.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace RayEngine
+{
+	std::unique_ptr<FramePublisher> FramePublisher::Create(const FramePublisherSpecification& specification)
+	{
+		if (specification.Width == 0 || specification.Height == 0 || specification.SlotCount < 2)
+		{
+			RAY_CORE_ERROR("[FramePublisher] invalid ring {}x{} with {} slots", specification.Width, specification.Height, specification.SlotCount);
+			return nullptr;
+		}
+
+		const std::string& name = specification.Name;
+		::shm_unlink(name.c_str()); // stale segment from a crashed run
+		const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (fd < 0)
+		{
+			RAY_CORE_ERROR("[FramePublisher] shm_open('{}') failed: {}", name, std::strerror(errno));
+			return nullptr;
+		}
+
+		const std::size_t size = FrameRing::TotalBytes(specification.Width, specification.Height, specification.Format, specification.SlotCount);
+		if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+		{
+			RAY_CORE_ERROR("[FramePublisher] ftruncate('{}') failed: {}", name, std::strerror(errno));
+			::close(fd);
+			::shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		// MAP_POPULATE: fault the whole ring in now rather than during the first frames.
+		void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED)
+		{
+			RAY_CORE_ERROR("[FramePublisher] mmap('{}') failed: {}", name, std::strerror(errno));
+			::shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		// The segment is zero-filled, so every slot starts unlocked with sequence 0.
+		auto* header = new (mapping) FrameRing::RingHeader{};
+		header->Version = FrameRing::version;
+		header->SlotCount = specification.SlotCount;
+		header->Width = specification.Width;
+		header->Height = specification.Height;
+		header->Format = specification.Format;
+		header->SlotStride = FrameRing::SlotStride(specification.Width, specification.Height, specification.Format);
+		header->PixelOffset = FrameRing::PixelOffset();
+		for (std::uint32_t i = 0; i < specification.SlotCount; ++i)
+			new (static_cast<unsigned char*>(mapping) + FrameRing::HeaderBytes() + header->SlotStride * i) FrameRing::SlotHeader{};
+
+		// Magic last: readers treat a segment without it as not yet initialized.
+		std::atomic_thread_fence(std::memory_order_release);
+		header->Magic = FrameRing::magic;
+
+		RAY_CORE_INFO("[FramePublisher] '{}': {} slots of {}x{}, {} KiB", name, specification.SlotCount,
+			specification.Width, specification.Height, size / 1024);
+		return std::unique_ptr<FramePublisher>(new FramePublisher(specification, mapping, size));
+	}
+
+	FramePublisher::FramePublisher(FramePublisherSpecification specification, void* mapping, std::size_t size) noexcept
+		: m_Specification(std::move(specification))
+		, m_Mapping(mapping)
+		, m_Size(size)
+		, m_FrameBytes(static_cast<std::size_t>(m_Specification.Width) * m_Specification.Height * FrameRing::BytesPerPixel(m_Specification.Format))
+		, m_Header(static_cast<FrameRing::RingHeader*>(mapping))
+	{
+	}
+
+	FramePublisher::~FramePublisher()
+	{
+		if (m_Mapping)
+			::munmap(m_Mapping, m_Size);
+		::shm_unlink(m_Specification.Name.c_str());
+	}
+
+	FrameRing::SlotHeader& FramePublisher::GetSlot(std::uint64_t sequence) noexcept
+	{
+		const std::size_t slot = (sequence - 1) % m_Specification.SlotCount;
+		return *reinterpret_cast<FrameRing::SlotHeader*>(static_cast<unsigned char*>(m_Mapping) + FrameRing::HeaderBytes() + m_Header->SlotStride * slot);
+	}
+
+	std::span<std::byte> FramePublisher::BeginFrame() noexcept
+	{
+		assert(!m_Writing && "FramePublisher::BeginFrame called twice without Commit");
+		m_Writing = true;
+
+		// Seqlock write side: make the slot odd before touching its pixels. Whatever frame the
+		// slot held (the oldest one) is overwritten; readers still on it will see the lock move.
+		FrameRing::SlotHeader& slot = GetSlot(m_NextSequence);
+		slot.Lock.store(slot.Lock.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		auto* pixels = reinterpret_cast<std::byte*>(&slot) + m_Header->PixelOffset;
+		return { pixels, m_FrameBytes };
+	}
+
+	void FramePublisher::Commit(std::uint64_t frameIndex) noexcept
+	{
+		assert(m_Writing && "FramePublisher::Commit without BeginFrame");
+		m_Writing = false;
+
+		const std::uint64_t sequence = m_NextSequence++;
+		FrameRing::SlotHeader& slot = GetSlot(sequence);
+		slot.Sequence.store(sequence, std::memory_order_relaxed);
+		slot.FrameIndex.store(frameIndex, std::memory_order_relaxed);
+		slot.PublishNanoseconds.store(FrameRing::NowNanoseconds(), std::memory_order_relaxed);
+		slot.Lock.store(slot.Lock.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		m_Header->LatestSequence.store(sequence, std::memory_order_release);
+		m_Stats.Published++;
+
+		// Pairs with FrameReader::WaitForFrame: either the reader sees the new Wake value when it
+		// enters the futex, or we see its Waiters increment here. No waiters, no syscall.
+		m_Header->Wake.fetch_add(1, std::memory_order_seq_cst);
+		if (m_Header->Waiters.load(std::memory_order_seq_cst) != 0)
+		{
+			::syscall(SYS_futex, &m_Header->Wake, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+			m_Stats.ReaderWakeups++;
+		}
+	}
+
+	bool FramePublisher::Publish(std::span<const std::byte> pixels, std::uint64_t frameIndex) noexcept
+	{
+		if (pixels.size() != m_FrameBytes)
+		{
+			RAY_CORE_ERROR("[FramePublisher] Publish: got {} bytes, frame is {} bytes", pixels.size(), m_FrameBytes);
+			return false;
+		}
+
+		const std::span<std::byte> target = BeginFrame();
+		std::memcpy(target.data(), pixels.data(), m_FrameBytes);
+		Commit(frameIndex);
+		return true;
+	}
+
+	std::uint32_t FramePublisher::GetReaderCount() const noexcept
+	{
+		return m_Header->Readers.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "SharedFrameRing.h"
+
+namespace RayEngine
+{
+	struct FramePublisherSpecification
+	{
+		std::string Name = "/rayengine-frames"; // shm_open name, must start with '/'
+		std::uint32_t Width = 1920;
+		std::uint32_t Height = 1080;
+		FrameRing::PixelFormat Format = FrameRing::PixelFormat::RGBA8;
+		std::uint32_t SlotCount = 4;
+	};
+
+	struct FramePublisherStats
+	{
+		std::uint64_t Published = 0;
+		std::uint64_t ReaderWakeups = 0; // publishes that had to wake a blocked reader (one syscall)
+	};
+
+	// Publishes completed frames into a POSIX shared-memory ring for external viewers/encoders.
+	// - Zero copy: BeginFrame() hands out the next slot's pixel memory, the renderer writes the
+	//   frame there, and Commit() makes it visible. Publish() is a convenience that copies.
+	// - Never blocks: the oldest slot is simply overwritten; readers detect that through the
+	//   slot seqlock. Waking blocked readers costs one futex syscall, and only if a reader waits.
+	// Single producer: use one publisher per ring, from one thread.
+	class FramePublisher
+	{
+	public:
+		// Returns nullptr and logs on failure. The segment is unlinked when the publisher dies.
+		[[nodiscard]] static std::unique_ptr<FramePublisher> Create(const FramePublisherSpecification& specification);
+		~FramePublisher();
+
+		FramePublisher(const FramePublisher&) = delete;
+		FramePublisher& operator=(const FramePublisher&) = delete;
+		FramePublisher(FramePublisher&&) = delete;
+		FramePublisher& operator=(FramePublisher&&) = delete;
+
+		// Start writing the next frame; returns the slot's pixel memory (row-major, tightly packed).
+		[[nodiscard]] std::span<std::byte> BeginFrame() noexcept;
+		// Publish the frame started by BeginFrame().
+		void Commit(std::uint64_t frameIndex) noexcept;
+		// BeginFrame + copy + Commit. `pixels` must be exactly GetFrameBytes() long.
+		bool Publish(std::span<const std::byte> pixels, std::uint64_t frameIndex) noexcept;
+
+		// Readers currently attached to the ring.
+		[[nodiscard]] std::uint32_t GetReaderCount() const noexcept;
+		[[nodiscard]] std::size_t GetFrameBytes() const noexcept { return m_FrameBytes; }
+		[[nodiscard]] const FramePublisherSpecification& GetSpecification() const noexcept { return m_Specification; }
+		[[nodiscard]] const FramePublisherStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		FramePublisher(FramePublisherSpecification specification, void* mapping, std::size_t size) noexcept;
+
+		[[nodiscard]] FrameRing::SlotHeader& GetSlot(std::uint64_t sequence) noexcept;
+
+	private:
+		FramePublisherSpecification m_Specification;
+		void* m_Mapping = nullptr;
+		std::size_t m_Size = 0;
+		std::size_t m_FrameBytes = 0;
+		FrameRing::RingHeader* m_Header = nullptr;
+
+		std::uint64_t m_NextSequence = 1;
+		bool m_Writing = false;
+		FramePublisherStats m_Stats;
+	};
+}
@@ -0,0 +1,185 @@
+#include "FrameReader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace RayEngine
+{
+	namespace
+	{
+		// A reader that keeps getting lapped is too slow for the ring size; give up rather than spin.
+		constexpr int maxAcquireAttempts = 8;
+
+		void SetError(std::string* error, const std::string& message)
+		{
+			if (error)
+				*error = message;
+		}
+	}
+
+	std::unique_ptr<FrameReader> FrameReader::Open(const std::string& name, std::string* error)
+	{
+		// O_RDWR only for the Readers / Waiters counters in the header page; see below.
+		const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+		if (fd < 0)
+		{
+			SetError(error, "shm_open('" + name + "') failed: " + std::strerror(errno));
+			return nullptr;
+		}
+
+		struct stat st {};
+		if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < FrameRing::HeaderBytes())
+		{
+			SetError(error, "'" + name + "' is not a frame ring");
+			::close(fd);
+			return nullptr;
+		}
+
+		const auto size = static_cast<std::size_t>(st.st_size);
+		void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED)
+		{
+			SetError(error, "mmap('" + name + "') failed: " + std::strerror(errno));
+			return nullptr;
+		}
+
+		// Slots stay read-only so a faulty consumer cannot corrupt published frames. Only the header
+		// page is made writable; if the system page is larger than it, the first page would cover
+		// slot 0 too, and the whole segment has to be writable.
+		const long pageSize = ::sysconf(_SC_PAGESIZE);
+		const std::size_t writableBytes = pageSize > 0 && FrameRing::HeaderBytes() % static_cast<std::size_t>(pageSize) == 0 ? FrameRing::HeaderBytes() : size;
+		if (::mprotect(mapping, writableBytes, PROT_READ | PROT_WRITE) != 0)
+		{
+			SetError(error, "mprotect('" + name + "') failed: " + std::strerror(errno));
+			::munmap(mapping, size);
+			return nullptr;
+		}
+
+		const auto* header = static_cast<const FrameRing::RingHeader*>(mapping);
+		const bool valid = header->Magic == FrameRing::magic && header->Version == FrameRing::version && header->SlotCount > 0
+			&& FrameRing::TotalBytes(header->Width, header->Height, header->Format, header->SlotCount) == size;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (!valid)
+		{
+			SetError(error, "'" + name + "' has an unexpected layout");
+			::munmap(mapping, size);
+			return nullptr;
+		}
+		return std::unique_ptr<FrameReader>(new FrameReader(mapping, size));
+	}
+
+	FrameReader::FrameReader(void* mapping, std::size_t size) noexcept
+		: m_Mapping(mapping)
+		, m_Size(size)
+		, m_Header(static_cast<FrameRing::RingHeader*>(mapping))
+	{
+		m_FrameBytes = static_cast<std::size_t>(m_Header->Width) * m_Header->Height * FrameRing::BytesPerPixel(m_Header->Format);
+		m_Header->Readers.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	FrameReader::~FrameReader()
+	{
+		m_Header->Readers.fetch_sub(1, std::memory_order_relaxed);
+		::munmap(m_Mapping, m_Size);
+	}
+
+	const FrameRing::SlotHeader& FrameReader::GetSlot(std::uint32_t slot) const noexcept
+	{
+		return *reinterpret_cast<const FrameRing::SlotHeader*>(static_cast<const unsigned char*>(m_Mapping) + FrameRing::HeaderBytes() + m_Header->SlotStride * slot);
+	}
+
+	std::uint64_t FrameReader::GetLatestSequence() const noexcept
+	{
+		return m_Header->LatestSequence.load(std::memory_order_acquire);
+	}
+
+	bool FrameReader::WaitForFrame(std::uint64_t afterSequence, int timeoutMilliseconds) noexcept
+	{
+		const std::int64_t deadline = FrameRing::NowNanoseconds() + static_cast<std::int64_t>(timeoutMilliseconds) * 1'000'000;
+		for (;;)
+		{
+			const std::uint32_t wake = m_Header->Wake.load(std::memory_order_seq_cst);
+			if (GetLatestSequence() > afterSequence)
+				return true;
+
+			timespec timeout{};
+			timespec* timeoutPtr = nullptr;
+			if (timeoutMilliseconds >= 0)
+			{
+				const std::int64_t remaining = deadline - FrameRing::NowNanoseconds();
+				if (remaining <= 0)
+					return false;
+				timeout.tv_sec = static_cast<time_t>(remaining / 1'000'000'000);
+				timeout.tv_nsec = static_cast<long>(remaining % 1'000'000'000);
+				timeoutPtr = &timeout;
+			}
+
+			// Shared (non-private) futex: the publisher lives in another process.
+			m_Header->Waiters.fetch_add(1, std::memory_order_seq_cst);
+			::syscall(SYS_futex, &m_Header->Wake, FUTEX_WAIT, wake, timeoutPtr, nullptr, 0);
+			m_Header->Waiters.fetch_sub(1, std::memory_order_seq_cst);
+		}
+	}
+
+	std::optional<FrameView> FrameReader::AcquireLatest() const noexcept
+	{
+		for (int attempt = 0; attempt < maxAcquireAttempts; ++attempt)
+		{
+			const std::uint64_t sequence = GetLatestSequence();
+			if (sequence == 0)
+				return std::nullopt;
+
+			const auto slotIndex = static_cast<std::uint32_t>((sequence - 1) % m_Header->SlotCount);
+			const FrameRing::SlotHeader& slot = GetSlot(slotIndex);
+			const std::uint64_t lock = slot.Lock.load(std::memory_order_acquire);
+			// Odd: the publisher already lapped the ring and is rewriting this slot. A different
+			// sequence: it finished doing so. Either way a newer frame exists; go get that one.
+			if ((lock & 1) != 0 || slot.Sequence.load(std::memory_order_relaxed) != sequence)
+				continue;
+
+			FrameView view;
+			view.Pixels = { reinterpret_cast<const std::byte*>(&slot) + m_Header->PixelOffset, m_FrameBytes };
+			view.Width = m_Header->Width;
+			view.Height = m_Header->Height;
+			view.Format = m_Header->Format;
+			view.Sequence = sequence;
+			view.FrameIndex = slot.FrameIndex.load(std::memory_order_relaxed);
+			view.PublishNanoseconds = slot.PublishNanoseconds.load(std::memory_order_relaxed);
+			view.Slot = slotIndex;
+			view.Lock = lock;
+			if (IsStillValid(view))
+				return view;
+		}
+		return std::nullopt;
+	}
+
+	bool FrameReader::IsStillValid(const FrameView& view) const noexcept
+	{
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return GetSlot(view.Slot).Lock.load(std::memory_order_relaxed) == view.Lock;
+	}
+
+	std::optional<FrameView> FrameReader::CopyLatest(std::span<std::byte> destination) const noexcept
+	{
+		if (destination.size() < m_FrameBytes)
+			return std::nullopt;
+
+		for (int attempt = 0; attempt < maxAcquireAttempts; ++attempt)
+		{
+			const std::optional<FrameView> view = AcquireLatest();
+			if (!view)
+				return std::nullopt;
+			std::memcpy(destination.data(), view->Pixels.data(), m_FrameBytes);
+			if (IsStillValid(*view))
+				return view;
+		}
+		return std::nullopt;
+	}
+}
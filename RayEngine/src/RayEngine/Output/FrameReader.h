@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "SharedFrameRing.h"
+
+namespace RayEngine
+{
+	// A frame as it sits in the ring. Pixels point straight into shared memory: consume them in
+	// place, then call FrameReader::IsStillValid() — if it returns false the publisher lapped the
+	// ring while you were reading and whatever you produced from the pixels must be discarded.
+	struct FrameView
+	{
+		std::span<const std::byte> Pixels;
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+		FrameRing::PixelFormat Format = FrameRing::PixelFormat::RGBA8;
+		std::uint64_t Sequence = 0;   // 1-based publish counter; gaps mean frames were skipped
+		std::uint64_t FrameIndex = 0; // application frame index passed to FramePublisher::Commit
+		std::int64_t PublishNanoseconds = 0;
+
+		std::uint32_t Slot = 0;
+		std::uint64_t Lock = 0;
+	};
+
+	// Read side of the FramePublisher ring, for viewers and encoders running in other processes.
+	// Built as the standalone RayFrameReader library (no spdlog, no engine) so tools can link it
+	// alone. Maps the frame slots read-only and only the ring header page (Readers / Waiters
+	// counters) read-write; never blocks the publisher.
+	class FrameReader
+	{
+	public:
+		// Returns nullptr if the segment does not exist (yet) or is not a frame ring; `error`
+		// receives the reason.
+		[[nodiscard]] static std::unique_ptr<FrameReader> Open(const std::string& name, std::string* error = nullptr);
+		~FrameReader();
+
+		FrameReader(const FrameReader&) = delete;
+		FrameReader& operator=(const FrameReader&) = delete;
+		FrameReader(FrameReader&&) = delete;
+		FrameReader& operator=(FrameReader&&) = delete;
+
+		[[nodiscard]] std::uint32_t GetWidth() const noexcept { return m_Header->Width; }
+		[[nodiscard]] std::uint32_t GetHeight() const noexcept { return m_Header->Height; }
+		[[nodiscard]] FrameRing::PixelFormat GetFormat() const noexcept { return m_Header->Format; }
+		[[nodiscard]] std::size_t GetFrameBytes() const noexcept { return m_FrameBytes; }
+
+		// Sequence of the newest published frame, 0 if none yet.
+		[[nodiscard]] std::uint64_t GetLatestSequence() const noexcept;
+
+		// Block (futex) until a frame newer than `afterSequence` is published or the timeout
+		// expires. Returns true if one is available. A negative timeout waits forever.
+		bool WaitForFrame(std::uint64_t afterSequence, int timeoutMilliseconds) noexcept;
+
+		// The newest complete frame, or nullopt if none is published or the writer keeps lapping us.
+		[[nodiscard]] std::optional<FrameView> AcquireLatest() const noexcept;
+		// Seqlock check: true if `view` was not overwritten since AcquireLatest().
+		[[nodiscard]] bool IsStillValid(const FrameView& view) const noexcept;
+
+		// Copy the newest frame into `destination` (GetFrameBytes() long), retrying torn copies.
+		[[nodiscard]] std::optional<FrameView> CopyLatest(std::span<std::byte> destination) const noexcept;
+
+	private:
+		FrameReader(void* mapping, std::size_t size) noexcept;
+
+		[[nodiscard]] const FrameRing::SlotHeader& GetSlot(std::uint32_t slot) const noexcept;
+
+	private:
+		void* m_Mapping = nullptr;
+		std::size_t m_Size = 0;
+		std::size_t m_FrameBytes = 0;
+		FrameRing::RingHeader* m_Header = nullptr;
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <time.h>
+
+namespace RayEngine
+{
+	// Memory layout of the shared-memory frame ring written by FramePublisher and read by
+	// FrameReader. Header-only and free of engine dependencies so external tools can share it.
+	//
+	//   [ RingHeader | slot 0 (SlotHeader + pixels) | slot 1 | ... ]   each slot page aligned
+	//
+	// Every slot is guarded by a seqlock: SlotHeader::Lock is odd while the publisher writes the
+	// slot and advances by 2 per publish. A reader that sees the same even value before and after
+	// consuming the pixels in place knows they were not overwritten in between.
+	namespace FrameRing
+	{
+		inline constexpr std::uint32_t magic = 0x52465247; // "RFRG"
+		inline constexpr std::uint32_t version = 1;
+		inline constexpr std::size_t slotAlignment = 4096;
+
+		enum class PixelFormat : std::uint32_t
+		{
+			RGBA8 = 0,
+			RGBA32F = 1
+		};
+
+		[[nodiscard]] constexpr std::uint32_t BytesPerPixel(PixelFormat format) noexcept
+		{
+			return format == PixelFormat::RGBA32F ? 16u : 4u;
+		}
+
+		struct alignas(64) RingHeader
+		{
+			std::uint32_t Magic;
+			std::uint32_t Version;
+			std::uint32_t SlotCount;
+			std::uint32_t Width;
+			std::uint32_t Height;
+			PixelFormat Format;
+			std::uint64_t SlotStride;   // bytes from one slot to the next
+			std::uint64_t PixelOffset;  // bytes from a slot start to its pixels
+
+			// Sequence number (1-based) of the newest complete frame; 0 before the first publish.
+			alignas(64) std::atomic<std::uint64_t> LatestSequence;
+			// Futex word bumped on every publish; readers block on it while waiting for a frame.
+			alignas(64) std::atomic<std::uint32_t> Wake;
+			std::atomic<std::uint32_t> Waiters;
+			// Attached FrameReaders, informational only: the publisher never waits for readers.
+			std::atomic<std::uint32_t> Readers;
+		};
+
+		struct alignas(64) SlotHeader
+		{
+			std::atomic<std::uint64_t> Lock;      // seqlock: odd while being written
+			std::atomic<std::uint64_t> Sequence;  // frame sequence stored in this slot
+			std::atomic<std::uint64_t> FrameIndex;
+			std::atomic<std::int64_t> PublishNanoseconds; // CLOCK_MONOTONIC when the frame became visible
+		};
+
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "frame ring requires lock-free 64-bit atomics");
+		static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "frame ring requires lock-free 32-bit atomics");
+
+		// Publish timestamps use CLOCK_MONOTONIC, which is shared by all processes on the machine.
+		[[nodiscard]] inline std::int64_t NowNanoseconds() noexcept
+		{
+			timespec ts{};
+			::clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+		}
+
+		[[nodiscard]] constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		[[nodiscard]] constexpr std::size_t HeaderBytes() noexcept
+		{
+			return AlignUp(sizeof(RingHeader), slotAlignment);
+		}
+
+		[[nodiscard]] constexpr std::size_t PixelOffset() noexcept
+		{
+			return AlignUp(sizeof(SlotHeader), 64);
+		}
+
+		[[nodiscard]] constexpr std::size_t SlotStride(std::uint32_t width, std::uint32_t height, PixelFormat format) noexcept
+		{
+			return AlignUp(PixelOffset() + static_cast<std::size_t>(width) * height * BytesPerPixel(format), slotAlignment);
+		}
+
+		[[nodiscard]] constexpr std::size_t TotalBytes(std::uint32_t width, std::uint32_t height, PixelFormat format, std::uint32_t slots) noexcept
+		{
+			return HeaderBytes() + SlotStride(width, height, format) * slots;
+		}
+	}
+}
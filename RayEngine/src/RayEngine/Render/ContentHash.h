@@ -0,0 +1,117 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace RayEngine
+{
+	// 128-bit content hash used as a cache key. Not cryptographic; 128 bits keep accidental
+	// collisions (which would show stale pixels) out of reach for any realistic cache size.
+	struct ContentHash
+	{
+		std::uint64_t Lo = 0;
+		std::uint64_t Hi = 0;
+
+		[[nodiscard]] constexpr bool operator==(const ContentHash&) const noexcept = default;
+	};
+
+	struct ContentHashHasher
+	{
+		[[nodiscard]] std::size_t operator()(const ContentHash& hash) const noexcept { return static_cast<std::size_t>(hash.Lo ^ hash.Hi); }
+	};
+
+	namespace Detail
+	{
+		// MurmurHash3 finalizer.
+		[[nodiscard]] constexpr std::uint64_t Mix64(std::uint64_t x) noexcept
+		{
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdull;
+			x ^= x >> 33;
+			x *= 0xc4ceb9fe1a85ec53ull;
+			x ^= x >> 33;
+			return x;
+		}
+	}
+
+	// Incremental hasher: feed everything a result depends on, in a stable order, then Finish().
+	//   ContentHasher hasher;
+	//   hasher.Add(camera);          // any trivially copyable value
+	//   hasher.Add(materialName);    // strings hash their characters
+	//   ContentHash key = hasher.Finish();
+	// Values are hashed by their object representation, so padding bytes must be deterministic
+	// (zero-initialize structs with padding, or add their fields one by one).
+	class ContentHasher
+	{
+	public:
+		constexpr ContentHasher() noexcept = default;
+		constexpr explicit ContentHasher(const ContentHash& seed) noexcept
+			: m_A(seed.Lo ^ 0x9e3779b97f4a7c15ull), m_B(seed.Hi ^ 0xc2b2ae3d27d4eb4full)
+		{
+		}
+
+		ContentHasher& AddBytes(std::span<const std::byte> bytes) noexcept
+		{
+			std::size_t offset = 0;
+			for (; offset + 8 <= bytes.size(); offset += 8)
+			{
+				std::uint64_t word;
+				std::memcpy(&word, bytes.data() + offset, 8);
+				AddWord(word);
+			}
+			if (offset < bytes.size())
+			{
+				std::uint64_t word = 0;
+				std::memcpy(&word, bytes.data() + offset, bytes.size() - offset);
+				AddWord(word);
+			}
+			m_Length += bytes.size();
+			return *this;
+		}
+
+		template<typename T>
+			requires std::is_trivially_copyable_v<T>
+		ContentHasher& Add(const T& value) noexcept
+		{
+			return AddBytes(std::as_bytes(std::span<const T, 1>(&value, 1)));
+		}
+
+		ContentHasher& Add(std::string_view text) noexcept
+		{
+			Add(static_cast<std::uint64_t>(text.size()));
+			return AddBytes(std::as_bytes(std::span<const char>(text.data(), text.size())));
+		}
+
+		ContentHasher& Add(const ContentHash& hash) noexcept
+		{
+			AddWord(hash.Lo);
+			AddWord(hash.Hi);
+			m_Length += 16;
+			return *this;
+		}
+
+		[[nodiscard]] ContentHash Finish() const noexcept
+		{
+			const std::uint64_t a = Detail::Mix64(m_A ^ m_Length);
+			const std::uint64_t b = Detail::Mix64(m_B + m_Length);
+			return { Detail::Mix64(a + b), Detail::Mix64(a ^ std::rotl(b, 29)) };
+		}
+
+	private:
+		void AddWord(std::uint64_t word) noexcept
+		{
+			m_A = std::rotl((m_A ^ word) * 0x87c37b91114253d5ull, 31) * 0x4cf5ad432745937full;
+			m_B = std::rotl(m_B + word * 0x4cf5ad432745937full, 27) * 0x87c37b91114253d5ull + m_A;
+		}
+
+	private:
+		std::uint64_t m_A = 0x243f6a8885a308d3ull;
+		std::uint64_t m_B = 0x13198a2e03707344ull;
+		std::uint64_t m_Length = 0;
+	};
+}
@@ -0,0 +1,123 @@
+#include "IncrementalRenderer.h"
+#include "TileCache.h"
+#include "RayEngine/Core/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace RayEngine
+{
+	IncrementalRenderer::IncrementalRenderer(const IncrementalRendererSpec& spec)
+		: m_Spec(spec)
+	{
+		m_Spec.TileSize = std::max(1u, m_Spec.TileSize);
+		m_TilesX = (m_Spec.Width + m_Spec.TileSize - 1) / m_Spec.TileSize;
+		m_TilesY = (m_Spec.Height + m_Spec.TileSize - 1) / m_Spec.TileSize;
+		m_Tiles = MakeTiles(m_Spec.Width, m_Spec.Height, m_Spec.TileSize);
+		m_Hashers.resize(m_Tiles.size());
+		m_PreviousHashes.resize(m_Tiles.size());
+		m_Valid.assign(m_Tiles.size(), 0);
+		m_Image.resize(static_cast<std::size_t>(m_Spec.Width) * m_Spec.Height * m_Spec.BytesPerPixel);
+	}
+
+	void IncrementalRenderer::BeginFrame(const ContentHash& frameHash)
+	{
+		ContentHasher hasher;
+		hasher.Add(m_Spec.TileSize).Add(m_Spec.BytesPerPixel).Add(frameHash);
+		for (std::size_t i = 0; i < m_Tiles.size(); ++i)
+		{
+			// The tile rectangle is part of the key, so identical content at another position
+			// (or resolution) never aliases.
+			m_Hashers[i] = hasher;
+			m_Hashers[i].Add(m_Tiles[i].X).Add(m_Tiles[i].Y).Add(m_Tiles[i].Width).Add(m_Tiles[i].Height);
+		}
+	}
+
+	void IncrementalRenderer::AddDependency(float minX, float minY, float maxX, float maxY, const ContentHash& hash)
+	{
+		const float tileSize = static_cast<float>(m_Spec.TileSize);
+		const float x0 = std::max(0.0f, std::floor(minX / tileSize));
+		const float y0 = std::max(0.0f, std::floor(minY / tileSize));
+		const float x1 = std::min(static_cast<float>(m_TilesX), std::ceil(maxX / tileSize));
+		const float y1 = std::min(static_cast<float>(m_TilesY), std::ceil(maxY / tileSize));
+		if (!(x0 < x1 && y0 < y1)) // also rejects NaN bounds
+			return;
+
+		for (std::uint32_t ty = static_cast<std::uint32_t>(y0); ty < static_cast<std::uint32_t>(y1); ++ty)
+		{
+			for (std::uint32_t tx = static_cast<std::uint32_t>(x0); tx < static_cast<std::uint32_t>(x1); ++tx)
+				m_Hashers[static_cast<std::size_t>(ty) * m_TilesX + tx].Add(hash);
+		}
+	}
+
+	void IncrementalRenderer::AddGlobalDependency(const ContentHash& hash)
+	{
+		for (ContentHasher& hasher : m_Hashers)
+			hasher.Add(hash);
+	}
+
+	IncrementalFrameStats IncrementalRenderer::Render(const RenderTileFn& renderTile, TileCache* cache, ThreadPool* pool)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		IncrementalFrameStats stats;
+		stats.Tiles = m_Tiles.size();
+		m_Changed.clear();
+		for (std::size_t i = 0; i < m_Tiles.size(); ++i)
+		{
+			const ContentHash hash = m_Hashers[i].Finish();
+			if (m_Valid[i] && m_PreviousHashes[i] == hash)
+				continue;
+			m_PreviousHashes[i] = hash;
+			m_Changed.push_back(i);
+		}
+		stats.Unchanged = m_Tiles.size() - m_Changed.size();
+
+		std::atomic<std::size_t> hits{ 0 };
+		ParallelFor(pool, m_Changed.size(), [&](std::size_t changed) {
+			const std::size_t index = m_Changed[changed];
+			const Tile& tile = m_Tiles[index];
+			thread_local std::vector<std::byte> t_Pixels;
+			t_Pixels.resize(static_cast<std::size_t>(tile.GetPixelCount()) * m_Spec.BytesPerPixel);
+
+			// Until the tile is complete it must not be trusted, even if rendering throws.
+			m_Valid[index] = 0;
+			if (cache && cache->Lookup(m_PreviousHashes[index], t_Pixels))
+			{
+				hits.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				renderTile(tile, t_Pixels);
+				if (cache)
+					cache->Store(m_PreviousHashes[index], t_Pixels);
+			}
+			CopyTile(tile, t_Pixels);
+			m_Valid[index] = 1;
+		});
+
+		stats.CacheHits = hits.load(std::memory_order_relaxed);
+		stats.Rendered = m_Changed.size() - stats.CacheHits;
+		stats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+
+	void IncrementalRenderer::Invalidate() noexcept
+	{
+		std::fill(m_Valid.begin(), m_Valid.end(), std::uint8_t{ 0 });
+	}
+
+	void IncrementalRenderer::CopyTile(const Tile& tile, std::span<const std::byte> pixels) noexcept
+	{
+		const std::size_t rowBytes = static_cast<std::size_t>(tile.Width) * m_Spec.BytesPerPixel;
+		const std::size_t imageRowBytes = static_cast<std::size_t>(m_Spec.Width) * m_Spec.BytesPerPixel;
+		for (std::uint32_t row = 0; row < tile.Height; ++row)
+		{
+			std::memcpy(m_Image.data() + (static_cast<std::size_t>(tile.Y) + row) * imageRowBytes + static_cast<std::size_t>(tile.X) * m_Spec.BytesPerPixel,
+				pixels.data() + row * rowBytes, rowBytes);
+		}
+	}
+}
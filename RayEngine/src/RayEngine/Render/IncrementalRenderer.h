@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "ContentHash.h"
+#include "RayEngine/Distributed/Tile.h"
+
+namespace RayEngine
+{
+	class ThreadPool;
+	class TileCache;
+
+	struct IncrementalRendererSpec
+	{
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+		std::uint32_t TileSize = 32;
+		std::uint32_t BytesPerPixel = 4;
+	};
+
+	struct IncrementalFrameStats
+	{
+		std::size_t Tiles = 0;
+		std::size_t Unchanged = 0; // same hash as last frame: pixels left in place
+		std::size_t CacheHits = 0; // changed, but found in the TileCache
+		std::size_t Rendered = 0;
+		double Seconds = 0.0;
+	};
+
+	// Re-renders only the tiles whose inputs changed.
+	// Every frame the caller describes what each tile depends on:
+	//   renderer.BeginFrame(hash of camera + settings);  // affects every tile
+	//   for (object : scene)
+	//       renderer.AddDependency(projected screen bounds of object, hash of object);
+	//   renderer.Render(renderTile, &pool);
+	// A tile's key is the frame hash combined, in call order, with every dependency overlapping it.
+	// Tiles whose key matches the previous frame keep their pixels; others are copied from the
+	// TileCache when present and rendered otherwise, so the work done scales with the number of
+	// tiles an edit touches rather than the resolution. Bounds must be conservative: anything
+	// that can change a pixel (shadows, reflections, filter footprints) has to be covered, or
+	// registered with AddGlobalDependency.
+	class IncrementalRenderer
+	{
+	public:
+		// Fills `pixels` (tile.Width * tile.Height pixels, rows packed) for the tile. Called
+		// concurrently for different tiles.
+		using RenderTileFn = std::function<void(const Tile& tile, std::span<std::byte> pixels)>;
+
+		explicit IncrementalRenderer(const IncrementalRendererSpec& spec);
+
+		void BeginFrame(const ContentHash& frameHash);
+		// Screen-space pixel rectangle [minX, maxX) x [minY, maxY); clipped to the image.
+		void AddDependency(float minX, float minY, float maxX, float maxY, const ContentHash& hash);
+		void AddGlobalDependency(const ContentHash& hash);
+
+		// Brings the image up to date. `cache` may be null (previous-frame reuse only).
+		IncrementalFrameStats Render(const RenderTileFn& renderTile, TileCache* cache, ThreadPool* pool);
+
+		// Forget the previous frame: the next Render() re-resolves every tile.
+		void Invalidate() noexcept;
+
+		[[nodiscard]] const IncrementalRendererSpec& GetSpecification() const noexcept { return m_Spec; }
+		[[nodiscard]] const std::vector<Tile>& GetTiles() const noexcept { return m_Tiles; }
+		// Row-major image, Width * BytesPerPixel bytes per row.
+		[[nodiscard]] std::span<const std::byte> GetImage() const noexcept { return m_Image; }
+
+	private:
+		void CopyTile(const Tile& tile, std::span<const std::byte> pixels) noexcept;
+
+	private:
+		IncrementalRendererSpec m_Spec;
+		std::uint32_t m_TilesX = 0;
+		std::uint32_t m_TilesY = 0;
+		std::vector<Tile> m_Tiles;
+		std::vector<ContentHasher> m_Hashers;      // current frame, one per tile
+		std::vector<ContentHash> m_PreviousHashes; // hashes the image currently holds
+		std::vector<std::uint8_t> m_Valid; // not vector<bool>: written concurrently per tile
+		std::vector<std::size_t> m_Changed;
+		std::vector<std::byte> m_Image;
+	};
+}
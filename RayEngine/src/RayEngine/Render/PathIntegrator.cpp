@@ -0,0 +1,254 @@
+#include "PathIntegrator.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Shading/BSDF.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace RayEngine
+{
+	namespace
+	{
+		// Kernel choices fixed at compile time: every test below folds to a constant.
+		template<PathVariant V>
+		struct StaticVariant
+		{
+			explicit StaticVariant(const PathVariant&) noexcept {}
+
+			[[nodiscard]] static constexpr bool HasLobe(LobeMask lobe) noexcept { return (V.Lobes & lobe) != 0; }
+			[[nodiscard]] static constexpr LobeMask GetLobes() noexcept { return V.Lobes; }
+			[[nodiscard]] static constexpr bool IsSingleLobe() noexcept { return RayEngine::IsSingleLobe(V.Lobes); }
+			[[nodiscard]] static constexpr bool HasLightType(LightType type) noexcept { return (V.LightTypes & LightTypeBit(type)) != 0; }
+			[[nodiscard]] static constexpr bool HasSingleLightType() noexcept { return std::popcount(V.LightTypes) == 1; }
+			[[nodiscard]] static constexpr bool RussianRoulette() noexcept { return V.RussianRoulette; }
+			[[nodiscard]] static constexpr bool NextEventEstimation() noexcept { return V.NextEventEstimation; }
+		};
+
+		// The same choices read from memory on every call: what a single general kernel pays.
+		struct RuntimeVariant
+		{
+			explicit RuntimeVariant(const PathVariant& variant) noexcept : V(variant) {}
+
+			[[nodiscard]] bool HasLobe(LobeMask lobe) const noexcept { return (V.Lobes & lobe) != 0; }
+			[[nodiscard]] LobeMask GetLobes() const noexcept { return V.Lobes; }
+			[[nodiscard]] bool IsSingleLobe() const noexcept { return RayEngine::IsSingleLobe(V.Lobes); }
+			[[nodiscard]] bool HasLightType(LightType type) const noexcept { return (V.LightTypes & LightTypeBit(type)) != 0; }
+			[[nodiscard]] bool HasSingleLightType() const noexcept { return std::popcount(V.LightTypes) == 1; }
+			[[nodiscard]] bool RussianRoulette() const noexcept { return V.RussianRoulette; }
+			[[nodiscard]] bool NextEventEstimation() const noexcept { return V.NextEventEstimation; }
+
+			const PathVariant& V;
+		};
+
+		[[nodiscard]] float Mean(const Vec3& v) noexcept { return (v.X + v.Y + v.Z) / 3.0f; }
+		[[nodiscard]] float MaxComponent(const Vec3& v) noexcept { return std::max({ v.X, v.Y, v.Z }); }
+
+		// Offset for rays leaving a surface, relative to the magnitude of the position.
+		[[nodiscard]] float SurfaceEpsilon(const Vec3& position) noexcept
+		{
+			return 1e-4f * std::max({ 1.0f, std::abs(position.X), std::abs(position.Y), std::abs(position.Z) });
+		}
+	}
+
+	PathIntegrator::PathIntegrator(const PathScene& scene, const IntegratorSettings& settings)
+		: m_Scene(scene)
+		, m_Settings(settings)
+	{
+		assert(scene.Geometry && "PathScene needs geometry");
+		assert(scene.TriangleMaterials.size() == scene.Geometry->GetMesh().GetTriangleCount() && "one material index per triangle");
+
+		m_Lobes.reserve(scene.Materials.size());
+		for (const Material& material : scene.Materials)
+		{
+			LobeSelection selection;
+			selection.Lobes = material.GetLobes();
+			m_Variant.Lobes |= selection.Lobes;
+
+			const float weights[3] = { Mean(material.Diffuse), Mean(material.Glossy), Mean(material.Specular) };
+			const float total = weights[0] + weights[1] + weights[2];
+			if (total > 0.0f)
+			{
+				for (int lobe = 0; lobe < 3; ++lobe)
+					selection.Probability[lobe] = weights[lobe] / total;
+				selection.DiffuseEnd = selection.Probability[0];
+				selection.GlossyEnd = selection.Probability[0] + selection.Probability[1];
+				// The last lobe present takes whatever rounding leaves.
+				if (!(selection.Lobes & specularLobe))
+					(selection.Lobes & glossyLobe ? selection.GlossyEnd : selection.DiffuseEnd) = 2.0f;
+			}
+			m_Lobes.push_back(selection);
+		}
+
+		if (settings.NextEventEstimation && scene.Lights)
+		{
+			for (const Light& light : scene.Lights->GetLights())
+				m_Variant.LightTypes |= LightTypeBit(light.Type);
+		}
+		m_Variant.NextEventEstimation = m_Variant.LightTypes != 0;
+		m_Variant.RussianRoulette = settings.RussianRoulette;
+		m_Kernel = GetKernel(m_Variant);
+
+		if (settings.NextEventEstimation && !m_Variant.NextEventEstimation)
+			RAY_CORE_WARN("[PathIntegrator] next-event estimation requested without lights; emission is only gathered by hitting it");
+	}
+
+	void PathIntegrator::EstimateGeneric(std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler) const
+	{
+		EstimateBatch<RuntimeVariant>(*this, paths, radiance, sampler);
+	}
+
+	PathIntegrator::Kernel PathIntegrator::GetKernel(const PathVariant& variant) noexcept
+	{
+		static constexpr auto kernels = []<std::size_t... Indices>(std::index_sequence<Indices...>) {
+			return std::array<Kernel, sizeof...(Indices)>{ &EstimateBatch<StaticVariant<PathVariant::FromIndex(Indices)>>... };
+		}(std::make_index_sequence<PathVariant::count>{});
+		return kernels[variant.GetIndex()];
+	}
+
+	template<typename Variant>
+	void PathIntegrator::EstimateBatch(const PathIntegrator& integrator, std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler)
+	{
+		assert(radiance.size() >= paths.size());
+		const Variant variant(integrator.m_Variant);
+		for (std::size_t i = 0; i < paths.size(); ++i)
+		{
+			const PathStart& path = paths[i];
+			sampler.StartPixelSample(path.PixelX, path.PixelY, path.SampleIndex);
+			radiance[i] = integrator.TracePath(variant, path.CameraRay, sampler);
+		}
+	}
+
+	template<typename Variant>
+	Vec3 PathIntegrator::TracePath(const Variant& variant, const Ray& cameraRay, Sampler& sampler) const noexcept
+	{
+		const TriangleMesh& mesh = m_Scene.Geometry->GetMesh();
+		Vec3 radiance;
+		Vec3 throughput{ 1.0f, 1.0f, 1.0f };
+		Ray ray = cameraRay;
+		bool countEmission = true; // camera rays and mirror bounces: NEE could not have found this light
+
+		for (std::uint32_t depth = 0;; ++depth)
+		{
+			const Hit hit = m_Scene.Geometry->Intersect(ray);
+			if (!hit.IsHit())
+			{
+				radiance += throughput * m_Scene.Background;
+				break;
+			}
+
+			const std::uint32_t materialIndex = m_Scene.TriangleMaterials[hit.Triangle];
+			const Material& material = m_Scene.Materials[materialIndex];
+			const std::uint32_t* corner = mesh.Indices.data() + 3 * static_cast<std::size_t>(hit.Triangle);
+			const Vec3& v0 = mesh.Positions[corner[0]];
+			const Vec3 geometricNormal = Normalize(Cross(mesh.Positions[corner[1]] - v0, mesh.Positions[corner[2]] - v0));
+			const Vec3 wo = -ray.Direction;
+			const bool frontFacing = Dot(geometricNormal, wo) > 0.0f;
+			if (frontFacing && (countEmission || !variant.NextEventEstimation()))
+				radiance += throughput * material.Emission;
+			if (depth == m_Settings.MaxDepth)
+				break;
+
+			const LobeSelection& selection = m_Lobes[materialIndex];
+			const LobeMask lobes = selection.Lobes & variant.GetLobes();
+			if (lobes == 0)
+				break;
+
+			const Vec3 normal = frontFacing ? geometricNormal : -geometricNormal;
+			const Vec3 position = ray.Origin + ray.Direction * hit.T;
+			const Vec3 origin = position + normal * SurfaceEpsilon(position);
+
+			if (variant.NextEventEstimation() && (variant.HasLobe(diffuseLobe) || variant.HasLobe(glossyLobe)) && (lobes & (diffuseLobe | glossyLobe)))
+				radiance += throughput * SampleLight(variant, material, lobes, position, normal, wo, origin, sampler);
+
+			// Pick one lobe in proportion to its albedo; single-lobe scenes never draw for it.
+			LobeMask lobe = lobes;
+			float lobeProbability = 1.0f;
+			if (!variant.IsSingleLobe() && !IsSingleLobe(lobes))
+			{
+				const float u = sampler.Get1D();
+				const int index = u < selection.DiffuseEnd ? 0 : (u < selection.GlossyEnd ? 1 : 2);
+				lobe = static_cast<LobeMask>(1u << index);
+				lobeProbability = selection.Probability[index];
+			}
+
+			Vec3 weight;
+			Vec3 wi;
+			if (variant.HasLobe(diffuseLobe) && (variant.GetLobes() == diffuseLobe || lobe == diffuseLobe))
+				wi = BSDF::SampleDiffuse(material, normal, sampler.Get2D(), weight);
+			else if (variant.HasLobe(glossyLobe) && (variant.GetLobes() == glossyLobe || lobe == glossyLobe))
+				wi = BSDF::SampleGlossy(material, normal, wo, sampler.Get2D(), weight);
+			else
+				wi = BSDF::SampleSpecular(material, normal, wo, weight);
+			throughput = throughput * weight * (1.0f / lobeProbability);
+			countEmission = lobe == specularLobe;
+
+			const float survival = std::min(1.0f, MaxComponent(throughput));
+			if (survival <= 0.0f)
+				break;
+			if (variant.RussianRoulette() && depth + 1 >= m_Settings.RouletteDepth)
+			{
+				if (sampler.Get1D() >= survival)
+					break;
+				throughput *= 1.0f / survival;
+			}
+			ray = Ray{ origin, wi };
+		}
+		return radiance;
+	}
+
+	template<typename Variant>
+	Vec3 PathIntegrator::SampleLight(const Variant& variant, const Material& material, LobeMask lobes, const Vec3& position, const Vec3& normal,
+		const Vec3& wo, const Vec3& origin, Sampler& sampler) const noexcept
+	{
+		const SampledLight sampled = m_Scene.Lights->Sample(position, normal, sampler.Get1D());
+		const Vec2 u = sampler.Get2D();
+		if (!sampled.IsValid())
+			return {};
+
+		const Light& light = m_Scene.Lights->GetLights()[sampled.Index];
+		Vec3 toLight;
+		Vec3 incident; // radiance arriving at `position`, times the light's area measure
+		const bool isPoint = variant.HasSingleLightType() ? variant.HasLightType(LightType::Point) : light.Type == LightType::Point;
+		if (isPoint)
+		{
+			toLight = light.Position - position;
+			incident = light.Emission * (1.0f / Dot(toLight, toLight));
+		}
+		else
+		{
+			// Uniform point on the triangle.
+			const float root = std::sqrt(u.X);
+			toLight = light.Position + light.Edge1 * (root * (1.0f - u.Y)) + light.Edge2 * (root * u.Y) - position;
+			// Emission * cosLight * area / distance^2 with pdf 1 / area; the unnormalized cross
+			// product is twice the area times the light normal.
+			const Vec3 doubleAreaNormal = Cross(light.Edge1, light.Edge2);
+			const float distanceSquared = Dot(toLight, toLight);
+			float projectedArea = -0.5f * Dot(doubleAreaNormal, toLight) / std::sqrt(distanceSquared);
+			if (light.TwoSided)
+				projectedArea = std::abs(projectedArea);
+			if (projectedArea <= 0.0f)
+				return {};
+			incident = light.Emission * (projectedArea / distanceSquared);
+		}
+
+		const float distance = Length(toLight);
+		const Vec3 wi = toLight * (1.0f / distance);
+		const float cosSurface = Dot(normal, wi);
+		if (cosSurface <= 0.0f)
+			return {};
+
+		Vec3 f;
+		if (variant.HasLobe(diffuseLobe) && (lobes & diffuseLobe))
+			f += BSDF::EvaluateDiffuse(material);
+		if (variant.HasLobe(glossyLobe) && (lobes & glossyLobe))
+			f += BSDF::EvaluateGlossy(material, normal, wo, wi);
+
+		if (m_Scene.Geometry->Intersect(Ray{ origin, wi, 0.0f, distance * 0.999f }).IsHit())
+			return {};
+		return f * incident * (cosSurface / sampled.Pmf);
+	}
+}
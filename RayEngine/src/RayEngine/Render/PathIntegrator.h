@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "RayEngine/Geometry/BVH.h"
+#include "RayEngine/Lighting/LightBVH.h"
+#include "RayEngine/Sampling/Sampler.h"
+#include "RayEngine/Shading/Material.h"
+
+namespace RayEngine
+{
+	using LightTypeMask = std::uint8_t; // bit LightTypeBit(type) set = lights of that type present
+
+	[[nodiscard]] constexpr LightTypeMask LightTypeBit(LightType type) noexcept { return static_cast<LightTypeMask>(1u << static_cast<unsigned>(type)); }
+
+	struct IntegratorSettings
+	{
+		std::uint32_t MaxDepth = 8;        // bounces after the camera hit
+		bool RussianRoulette = true;
+		std::uint32_t RouletteDepth = 3;   // first bounce that may be terminated
+		// A shadow ray towards one light (picked through the LightBVH) at every non-specular hit.
+		// Emission is then only counted directly on camera rays and after mirror bounces. Point
+		// lights cannot be hit, so they only contribute through it.
+		bool NextEventEstimation = true;
+	};
+
+	// What a path kernel is compiled for. Lobes and light types are unions over the scene, so a
+	// kernel only contains the code the scene can reach: an all-diffuse scene never tests for
+	// glossy or mirror lobes, a scene of area lights never branches on the light type.
+	struct PathVariant
+	{
+		LobeMask Lobes = 0;
+		LightTypeMask LightTypes = 0;
+		bool RussianRoulette = false;
+		bool NextEventEstimation = false;
+
+		static constexpr std::size_t count = 8 * 4 * 2 * 2;
+
+		[[nodiscard]] constexpr std::size_t GetIndex() const noexcept
+		{
+			return ((static_cast<std::size_t>(Lobes) * 4 + LightTypes) * 2 + RussianRoulette) * 2 + NextEventEstimation;
+		}
+
+		[[nodiscard]] static constexpr PathVariant FromIndex(std::size_t index) noexcept
+		{
+			return { static_cast<LobeMask>(index / 16), static_cast<LightTypeMask>(index / 4 % 4), (index / 2 % 2) != 0, (index % 2) != 0 };
+		}
+	};
+
+	struct PathScene
+	{
+		const BVH* Geometry = nullptr;
+		std::span<const std::uint32_t> TriangleMaterials; // per mesh triangle, index into Materials
+		std::span<const Material> Materials;
+		// Next-event estimation targets; may be null. Emissive triangles must be listed with the
+		// same vertices and radiance as their material, or their light is lost after diffuse bounces.
+		const LightBVH* Lights = nullptr;
+		Vec3 Background;                                  // radiance of escaping rays
+	};
+
+	struct PathStart
+	{
+		Ray CameraRay;
+		std::uint32_t PixelX = 0;
+		std::uint32_t PixelY = 0;
+		std::uint32_t SampleIndex = 0;
+	};
+
+	// Unidirectional path tracer over a BVH with Material surfaces.
+	// Every combination of PathVariant is compiled into its own batch kernel, collected in a
+	// table built at compile time. The integrator picks the kernel for its scene and settings
+	// once, at construction, and Estimate() makes one indirect call per batch; inside the kernel
+	// the lobe, light-type, roulette and NEE choices are constants. EstimateGeneric() runs the
+	// same code with those choices read at run time on every path vertex, and produces
+	// bit-identical results.
+	// The scene is referenced and must outlive the integrator. Estimate() is const and may run
+	// concurrently with one Sampler per thread.
+	class PathIntegrator
+	{
+	public:
+		// radiance[i] = one-sample estimate along paths[i].
+		using Kernel = void (*)(const PathIntegrator& integrator, std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler);
+
+		explicit PathIntegrator(const PathScene& scene, const IntegratorSettings& settings = {});
+
+		void Estimate(std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler) const { m_Kernel(*this, paths, radiance, sampler); }
+		void EstimateGeneric(std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler) const;
+
+		[[nodiscard]] const PathVariant& GetVariant() const noexcept { return m_Variant; }
+		[[nodiscard]] const IntegratorSettings& GetSettings() const noexcept { return m_Settings; }
+		[[nodiscard]] const PathScene& GetScene() const noexcept { return m_Scene; }
+
+		// The specialized kernel for `variant`, from the compile-time table.
+		[[nodiscard]] static Kernel GetKernel(const PathVariant& variant) noexcept;
+
+	private:
+		// Per material: which lobes it has and the cumulative probabilities used to pick one.
+		struct LobeSelection
+		{
+			LobeMask Lobes = 0;
+			float DiffuseEnd = 0.0f;   // u < DiffuseEnd: diffuse
+			float GlossyEnd = 0.0f;    // else u < GlossyEnd: glossy, else specular
+			float Probability[3] = {}; // diffuse, glossy, specular
+		};
+
+		template<typename Variant>
+		static void EstimateBatch(const PathIntegrator& integrator, std::span<const PathStart> paths, std::span<Vec3> radiance, Sampler& sampler);
+		template<typename Variant>
+		[[nodiscard]] Vec3 TracePath(const Variant& variant, const Ray& cameraRay, Sampler& sampler) const noexcept;
+		template<typename Variant>
+		[[nodiscard]] Vec3 SampleLight(const Variant& variant, const Material& material, LobeMask lobes, const Vec3& position, const Vec3& normal,
+			const Vec3& wo, const Vec3& origin, Sampler& sampler) const noexcept;
+
+	private:
+		PathScene m_Scene;
+		IntegratorSettings m_Settings;
+		PathVariant m_Variant;
+		Kernel m_Kernel = nullptr;
+		std::vector<LobeSelection> m_Lobes; // per material
+	};
+}
@@ -0,0 +1,311 @@
+#include "TileCache.h"
+#include "RayEngine/Core/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::uint32_t tileFileMagic = 0x31435452; // "RTC1"
+		constexpr const char* tileFileExtension = ".tile";
+
+		struct TileFileHeader
+		{
+			std::uint32_t Magic = tileFileMagic;
+			std::uint32_t Reserved = 0;
+			std::uint64_t KeyLo = 0;
+			std::uint64_t KeyHi = 0;
+			std::uint64_t PixelBytes = 0;
+		};
+		static_assert(sizeof(TileFileHeader) == 32);
+
+		bool ParseHex(std::string_view text, std::uint64_t& value) noexcept
+		{
+			value = 0;
+			for (char c : text)
+			{
+				const int digit = c >= '0' && c <= '9' ? c - '0' : (c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1);
+				if (digit < 0)
+					return false;
+				value = (value << 4) | static_cast<std::uint64_t>(digit);
+			}
+			return true;
+		}
+	}
+
+	TileCache::TileCache(TileCacheSpec spec)
+		: m_Spec(std::move(spec))
+	{
+		if (m_Spec.DiskDirectory.empty())
+			return;
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_Spec.DiskDirectory, ec);
+		if (ec)
+		{
+			RAY_CORE_ERROR("[TileCache] cannot create '{}': {}; disk level disabled", m_Spec.DiskDirectory.string(), ec.message());
+			m_Spec.DiskDirectory.clear();
+			return;
+		}
+		IndexDiskDirectory();
+	}
+
+	bool TileCache::Lookup(const ContentHash& key, std::span<std::byte> pixels)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			if (auto it = m_Memory.find(key); it != m_Memory.end() && it->second.Pixels.size() == pixels.size())
+			{
+				m_MemoryRecency.splice(m_MemoryRecency.begin(), m_MemoryRecency, it->second.Recency);
+				std::copy(it->second.Pixels.begin(), it->second.Pixels.end(), pixels.begin());
+				m_Counters.MemoryHits++;
+				return true;
+			}
+
+			auto it = m_Disk.find(key);
+			if (it == m_Disk.end())
+			{
+				m_Counters.Misses++;
+				return false;
+			}
+			m_DiskRecency.splice(m_DiskRecency.begin(), m_DiskRecency, it->second.Recency);
+		}
+
+		// The file may be evicted or replaced meanwhile; the header check catches that.
+		const bool read = ReadTileFile(key, pixels);
+
+		std::lock_guard lock(m_Mutex);
+		if (!read)
+		{
+			// Forget a file that went missing, so the next Store writes it again.
+			if (auto it = m_Disk.find(key); it != m_Disk.end())
+			{
+				m_DiskBytes -= it->second.Bytes;
+				m_DiskRecency.erase(it->second.Recency);
+				m_Disk.erase(it);
+			}
+			m_Counters.Misses++;
+			return false;
+		}
+		m_Counters.DiskHits++;
+		InsertMemory(key, std::vector<std::byte>(pixels.begin(), pixels.end()));
+		return true;
+	}
+
+	void TileCache::Store(const ContentHash& key, std::span<const std::byte> pixels)
+	{
+		bool onDisk = false;
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Counters.Stores++;
+			InsertMemory(key, std::vector<std::byte>(pixels.begin(), pixels.end()));
+			onDisk = m_Spec.DiskDirectory.empty() || m_Disk.contains(key);
+		}
+		if (onDisk || !WriteTileFile(key, pixels))
+			return;
+
+		std::vector<ContentHash> evicted;
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_Disk.contains(key))
+				return; // another thread stored the same tile
+			m_DiskRecency.push_front(key);
+			const std::uint64_t bytes = sizeof(TileFileHeader) + pixels.size();
+			m_Disk.emplace(key, DiskEntry{ bytes, m_DiskRecency.begin() });
+			m_DiskBytes += bytes;
+			evicted = EvictDisk();
+		}
+		RemoveTileFiles(evicted);
+	}
+
+	void TileCache::Clear(bool includeDisk)
+	{
+		std::vector<ContentHash> removed;
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Memory.clear();
+			m_MemoryRecency.clear();
+			m_MemoryBytes = 0;
+			if (!includeDisk)
+				return;
+
+			removed.assign(m_DiskRecency.begin(), m_DiskRecency.end());
+			m_Disk.clear();
+			m_DiskRecency.clear();
+			m_DiskBytes = 0;
+		}
+		RemoveTileFiles(removed);
+	}
+
+	TileCacheStats TileCache::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+		TileCacheStats stats = m_Counters;
+		stats.MemoryBytes = m_MemoryBytes;
+		stats.MemoryEntries = m_Memory.size();
+		stats.DiskBytes = m_DiskBytes;
+		stats.DiskEntries = m_Disk.size();
+		return stats;
+	}
+
+	void TileCache::ResetCounters() noexcept
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Counters = {};
+	}
+
+	std::filesystem::path TileCache::GetTilePath(const ContentHash& key) const
+	{
+		char name[40];
+		std::snprintf(name, sizeof(name), "%016llx%016llx", static_cast<unsigned long long>(key.Hi), static_cast<unsigned long long>(key.Lo));
+		return m_Spec.DiskDirectory / (std::string(name) + tileFileExtension);
+	}
+
+	bool TileCache::ReadTileFile(const ContentHash& key, std::span<std::byte> pixels) const
+	{
+		std::ifstream file(GetTilePath(key), std::ios::binary);
+		TileFileHeader header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return false;
+		if (header.Magic != tileFileMagic || header.KeyLo != key.Lo || header.KeyHi != key.Hi || header.PixelBytes != pixels.size())
+			return false;
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size())));
+	}
+
+	bool TileCache::WriteTileFile(const ContentHash& key, std::span<const std::byte> pixels) const
+	{
+		// Write to a temporary name and rename, so readers never see a partial tile.
+		const std::filesystem::path path = GetTilePath(key);
+		std::filesystem::path temporary = path;
+		thread_local std::mt19937_64 t_Names{ std::random_device{}() };
+		temporary += ".tmp" + std::to_string(t_Names());
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			TileFileHeader header;
+			header.KeyLo = key.Lo;
+			header.KeyHi = key.Hi;
+			header.PixelBytes = pixels.size();
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+			if (!file)
+			{
+				RAY_CORE_WARN("[TileCache] failed to write '{}'", temporary.string());
+				file.close();
+				std::error_code ec;
+				std::filesystem::remove(temporary, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temporary, path, ec);
+		if (ec)
+		{
+			RAY_CORE_WARN("[TileCache] failed to publish '{}': {}", path.string(), ec.message());
+			std::filesystem::remove(temporary, ec);
+			return false;
+		}
+		return true;
+	}
+
+	void TileCache::RemoveTileFiles(std::span<const ContentHash> keys) const
+	{
+		for (const ContentHash& key : keys)
+		{
+			std::error_code ec;
+			std::filesystem::remove(GetTilePath(key), ec);
+		}
+	}
+
+	void TileCache::IndexDiskDirectory()
+	{
+		struct Found
+		{
+			ContentHash Key;
+			std::uint64_t Bytes;
+			std::filesystem::file_time_type Time;
+		};
+		std::vector<Found> found;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(m_Spec.DiskDirectory, ec))
+		{
+			const std::filesystem::path& path = entry.path();
+			const std::string stem = path.stem().string();
+			ContentHash key;
+			if (path.extension() != tileFileExtension || stem.size() != 32
+				|| !ParseHex(std::string_view(stem).substr(0, 16), key.Hi) || !ParseHex(std::string_view(stem).substr(16), key.Lo))
+				continue;
+
+			std::error_code fileError;
+			const std::uint64_t bytes = entry.file_size(fileError);
+			const auto time = entry.last_write_time(fileError);
+			if (!fileError)
+				found.push_back({ key, bytes, time });
+		}
+
+		// Oldest first, so the newest files end up at the front of the recency list.
+		std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.Time < b.Time; });
+		for (const Found& file : found)
+		{
+			m_DiskRecency.push_front(file.Key);
+			m_Disk.emplace(file.Key, DiskEntry{ file.Bytes, m_DiskRecency.begin() });
+			m_DiskBytes += file.Bytes;
+		}
+		RemoveTileFiles(EvictDisk());
+
+		if (!found.empty())
+			RAY_CORE_INFO("[TileCache] indexed {} tile(s), {} MiB in '{}'", m_Disk.size(), m_DiskBytes >> 20, m_Spec.DiskDirectory.string());
+	}
+
+	void TileCache::InsertMemory(const ContentHash& key, std::vector<std::byte> pixels)
+	{
+		if (pixels.size() > m_Spec.MemoryBudgetBytes)
+			return;
+
+		if (auto it = m_Memory.find(key); it != m_Memory.end())
+		{
+			m_MemoryBytes -= it->second.Pixels.size();
+			m_MemoryRecency.erase(it->second.Recency);
+			m_Memory.erase(it);
+		}
+
+		m_MemoryBytes += pixels.size();
+		m_MemoryRecency.push_front(key);
+		m_Memory.emplace(key, MemoryEntry{ std::move(pixels), m_MemoryRecency.begin() });
+		EvictMemory();
+	}
+
+	void TileCache::EvictMemory()
+	{
+		while (m_MemoryBytes > m_Spec.MemoryBudgetBytes && !m_MemoryRecency.empty())
+		{
+			const auto it = m_Memory.find(m_MemoryRecency.back());
+			m_MemoryBytes -= it->second.Pixels.size();
+			m_Memory.erase(it);
+			m_MemoryRecency.pop_back();
+			m_Counters.MemoryEvictions++;
+		}
+	}
+
+	std::vector<ContentHash> TileCache::EvictDisk()
+	{
+		std::vector<ContentHash> evicted;
+		while (m_DiskBytes > m_Spec.DiskBudgetBytes && !m_DiskRecency.empty())
+		{
+			const ContentHash key = m_DiskRecency.back();
+			const auto it = m_Disk.find(key);
+			m_DiskBytes -= it->second.Bytes;
+			m_Disk.erase(it);
+			m_DiskRecency.pop_back();
+			m_Counters.DiskEvictions++;
+			evicted.push_back(key);
+		}
+		return evicted;
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "ContentHash.h"
+
+namespace RayEngine
+{
+	struct TileCacheSpec
+	{
+		std::size_t MemoryBudgetBytes = 256ull * 1024 * 1024;
+		// Optional second level: one file per tile in this directory. Entries found there on
+		// construction are indexed, so the cache carries over between runs and processes.
+		std::filesystem::path DiskDirectory;
+		std::uint64_t DiskBudgetBytes = 2ull * 1024 * 1024 * 1024;
+	};
+
+	struct TileCacheStats
+	{
+		std::uint64_t MemoryHits = 0;
+		std::uint64_t DiskHits = 0;
+		std::uint64_t Misses = 0;
+		std::uint64_t Stores = 0;
+		std::uint64_t MemoryEvictions = 0;
+		std::uint64_t DiskEvictions = 0;
+		std::size_t MemoryBytes = 0;
+		std::size_t MemoryEntries = 0;
+		std::uint64_t DiskBytes = 0;
+		std::size_t DiskEntries = 0;
+	};
+
+	// Content-addressed store of rendered tile pixels, keyed by the hash of everything the tile
+	// depends on. Both levels evict least-recently-used entries once over budget; a disk hit is
+	// promoted to memory. Thread-safe: lookups and stores may come from any render thread, disk
+	// reads and writes happen outside the index lock.
+	class TileCache
+	{
+	public:
+		explicit TileCache(TileCacheSpec spec = {});
+
+		TileCache(const TileCache&) = delete;
+		TileCache& operator=(const TileCache&) = delete;
+		TileCache(TileCache&&) = delete;
+		TileCache& operator=(TileCache&&) = delete;
+
+		// Copies the cached pixels into `pixels` and returns true if an entry of exactly that size
+		// exists for `key`.
+		[[nodiscard]] bool Lookup(const ContentHash& key, std::span<std::byte> pixels);
+		// Inserts (or refreshes) the entry; written through to disk when a directory is set.
+		void Store(const ContentHash& key, std::span<const std::byte> pixels);
+
+		// Drops the memory level; with `includeDisk` also deletes every indexed tile file.
+		void Clear(bool includeDisk = false);
+
+		[[nodiscard]] TileCacheStats GetStats() const;
+		void ResetCounters() noexcept;
+		[[nodiscard]] const TileCacheSpec& GetSpecification() const noexcept { return m_Spec; }
+
+	private:
+		struct MemoryEntry
+		{
+			std::vector<std::byte> Pixels;
+			std::list<ContentHash>::iterator Recency;
+		};
+
+		struct DiskEntry
+		{
+			std::uint64_t Bytes = 0; // file size, header included
+			std::list<ContentHash>::iterator Recency;
+		};
+
+		[[nodiscard]] std::filesystem::path GetTilePath(const ContentHash& key) const;
+		bool ReadTileFile(const ContentHash& key, std::span<std::byte> pixels) const;
+		bool WriteTileFile(const ContentHash& key, std::span<const std::byte> pixels) const;
+		// Deletes the files of entries already dropped from the index; called without m_Mutex.
+		void RemoveTileFiles(std::span<const ContentHash> keys) const;
+		void IndexDiskDirectory();
+
+		// Callers hold m_Mutex.
+		void InsertMemory(const ContentHash& key, std::vector<std::byte> pixels);
+		void EvictMemory();
+		// Drops least-recently-used disk entries over budget and returns their keys for RemoveTileFiles().
+		[[nodiscard]] std::vector<ContentHash> EvictDisk();
+
+	private:
+		TileCacheSpec m_Spec;
+
+		mutable std::mutex m_Mutex;
+		std::unordered_map<ContentHash, MemoryEntry, ContentHashHasher> m_Memory;
+		std::list<ContentHash> m_MemoryRecency; // front = most recently used
+		std::size_t m_MemoryBytes = 0;
+
+		std::unordered_map<ContentHash, DiskEntry, ContentHashHasher> m_Disk;
+		std::list<ContentHash> m_DiskRecency;
+		std::uint64_t m_DiskBytes = 0;
+
+		TileCacheStats m_Counters;
+	};
+}
@@ -0,0 +1,129 @@
+#include "BlueNoise.h"
+#include "PCG.h"
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <limits>
+
+namespace RayEngine
+{
+	namespace
+	{
+		constexpr std::uint32_t texelCount = BlueNoise::size * BlueNoise::size;
+		constexpr float sigma = 1.5f;
+		constexpr int kernelRadius = 6;
+		constexpr std::uint32_t initialPoints = texelCount / 10;
+
+		// Gaussian energy field of a binary pattern on the torus, updated incrementally.
+		class EnergyField
+		{
+		public:
+			EnergyField()
+				: m_Energy(texelCount, 0.0f), m_Set(texelCount, false)
+			{
+				for (int dy = -kernelRadius; dy <= kernelRadius; ++dy)
+				{
+					for (int dx = -kernelRadius; dx <= kernelRadius; ++dx)
+						m_Kernel.push_back(std::exp(-static_cast<float>(dx * dx + dy * dy) / (2.0f * sigma * sigma)));
+				}
+			}
+
+			[[nodiscard]] bool IsSet(std::uint32_t texel) const noexcept { return m_Set[texel]; }
+
+			void Toggle(std::uint32_t texel)
+			{
+				m_Set[texel] = !m_Set[texel];
+				const float sign = m_Set[texel] ? 1.0f : -1.0f;
+				const int x = static_cast<int>(texel % BlueNoise::size), y = static_cast<int>(texel / BlueNoise::size);
+				const int wrap = static_cast<int>(BlueNoise::size);
+				std::size_t k = 0;
+				for (int dy = -kernelRadius; dy <= kernelRadius; ++dy)
+				{
+					const int row = ((y + dy) % wrap + wrap) % wrap;
+					for (int dx = -kernelRadius; dx <= kernelRadius; ++dx, ++k)
+						m_Energy[row * wrap + ((x + dx) % wrap + wrap) % wrap] += sign * m_Kernel[k];
+				}
+			}
+
+			// Tightest cluster: the set texel with the highest energy.
+			[[nodiscard]] std::uint32_t FindTightestCluster() const noexcept { return Find(true, std::greater<>{}); }
+			// Largest void: the empty texel with the lowest energy.
+			[[nodiscard]] std::uint32_t FindLargestVoid() const noexcept { return Find(false, std::less<>{}); }
+
+		private:
+			template<typename Compare>
+			[[nodiscard]] std::uint32_t Find(bool set, Compare better) const noexcept
+			{
+				std::uint32_t best = 0;
+				float bestEnergy = set ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+				for (std::uint32_t i = 0; i < texelCount; ++i)
+				{
+					if (m_Set[i] == set && better(m_Energy[i], bestEnergy))
+					{
+						best = i;
+						bestEnergy = m_Energy[i];
+					}
+				}
+				return best;
+			}
+
+			std::vector<float> m_Energy;
+			std::vector<bool> m_Set;
+			std::vector<float> m_Kernel;
+		};
+	}
+
+	const BlueNoise& BlueNoise::Get()
+	{
+		static const BlueNoise s_Instance;
+		return s_Instance;
+	}
+
+	BlueNoise::BlueNoise()
+		: m_Values(texelCount, 0.0f)
+	{
+		// Void-and-cluster (Ulichney 1993).
+		// 1. Random initial pattern, relaxed until the tightest cluster is also the largest void.
+		EnergyField field;
+		PCG32 rng(0x5eed);
+		for (std::uint32_t placed = 0; placed < initialPoints;)
+		{
+			const std::uint32_t texel = rng.NextUInt(texelCount);
+			if (!field.IsSet(texel))
+			{
+				field.Toggle(texel);
+				placed++;
+			}
+		}
+		for (;;)
+		{
+			const std::uint32_t cluster = field.FindTightestCluster();
+			field.Toggle(cluster);
+			const std::uint32_t emptiest = field.FindLargestVoid();
+			field.Toggle(emptiest);
+			if (emptiest == cluster)
+				break;
+		}
+
+		std::vector<std::uint32_t> ranks(texelCount, 0);
+		// 2. Rank the initial points by removing tightest clusters from a copy.
+		EnergyField removal = field;
+		for (std::uint32_t rank = initialPoints; rank-- > 0;)
+		{
+			const std::uint32_t cluster = removal.FindTightestCluster();
+			removal.Toggle(cluster);
+			ranks[cluster] = rank;
+		}
+		// 3. Rank everything else by filling largest voids.
+		for (std::uint32_t rank = initialPoints; rank < texelCount; ++rank)
+		{
+			const std::uint32_t emptiest = field.FindLargestVoid();
+			field.Toggle(emptiest);
+			ranks[emptiest] = rank;
+		}
+
+		for (std::uint32_t i = 0; i < texelCount; ++i)
+			m_Values[i] = (static_cast<float>(ranks[i]) + 0.5f) / texelCount;
+	}
+}
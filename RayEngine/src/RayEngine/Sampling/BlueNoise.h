@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace RayEngine
+{
+	// Tileable blue-noise threshold table (void-and-cluster), generated once on first use from a
+	// fixed seed, so it is identical in every process and run. Values are ranks mapped to (0, 1):
+	// thresholding at t lights a fraction t of the texels with no low-frequency clumping.
+	class BlueNoise
+	{
+	public:
+		static constexpr std::uint32_t size = 64;
+
+		// Thread-safe; built by the first caller, read-only afterwards.
+		[[nodiscard]] static const BlueNoise& Get();
+
+		// Value at texel (x, y) (wrapped) for `dimension`. Dimensions read the same table through
+		// different toroidal offsets (R2 sequence), which keeps them decorrelated.
+		[[nodiscard]] float Sample(std::uint32_t x, std::uint32_t y, std::uint32_t dimension = 0) const noexcept
+		{
+			const std::uint32_t offsetX = static_cast<std::uint32_t>(dimension * 0.7548776662f * size);
+			const std::uint32_t offsetY = static_cast<std::uint32_t>(dimension * 0.5698402910f * size);
+			return m_Values[((y + offsetY) % size) * size + (x + offsetX) % size];
+		}
+
+	private:
+		BlueNoise();
+
+	private:
+		std::vector<float> m_Values;
+	};
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RayEngine
+{
+	// PCG32 (XSH-RR, 64-bit state) random number generator.
+	// A plain value with no shared state: give every worker its own, seeded from something stable
+	// (seed, pixel, sample) rather than from the thread, so results do not depend on scheduling.
+	class PCG32
+	{
+	public:
+		explicit PCG32(std::uint64_t seed = 0x853c49e6748fea9bull, std::uint64_t stream = 0xda3e39cb94b95bdbull) noexcept
+		{
+			Seed(seed, stream);
+		}
+
+		// Distinct streams give statistically independent sequences for the same seed.
+		void Seed(std::uint64_t seed, std::uint64_t stream) noexcept
+		{
+			m_State = 0;
+			m_Increment = (stream << 1u) | 1u;
+			(void)NextUInt();
+			m_State += seed;
+			(void)NextUInt();
+		}
+
+		std::uint32_t NextUInt() noexcept
+		{
+			const std::uint64_t previous = m_State;
+			m_State = previous * 6364136223846793005ull + m_Increment;
+			const auto shifted = static_cast<std::uint32_t>(((previous >> 18u) ^ previous) >> 27u);
+			const auto rotation = static_cast<std::uint32_t>(previous >> 59u);
+			return (shifted >> rotation) | (shifted << ((0u - rotation) & 31u));
+		}
+
+		// Uniform in [0, bound) without modulo bias (Lemire).
+		std::uint32_t NextUInt(std::uint32_t bound) noexcept
+		{
+			std::uint64_t product = static_cast<std::uint64_t>(NextUInt()) * bound;
+			auto low = static_cast<std::uint32_t>(product);
+			if (low < bound)
+			{
+				const std::uint32_t threshold = (0u - bound) % bound;
+				while (low < threshold)
+				{
+					product = static_cast<std::uint64_t>(NextUInt()) * bound;
+					low = static_cast<std::uint32_t>(product);
+				}
+			}
+			return static_cast<std::uint32_t>(product >> 32u);
+		}
+
+		// Uniform in [0, 1).
+		float NextFloat() noexcept
+		{
+			return static_cast<float>(NextUInt() >> 8u) * 0x1p-24f;
+		}
+
+	private:
+		std::uint64_t m_State = 0;
+		std::uint64_t m_Increment = 1;
+	};
+}
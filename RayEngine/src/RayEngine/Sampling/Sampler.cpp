@@ -0,0 +1,48 @@
+#include "Sampler.h"
+
+#include <cmath>
+
+namespace RayEngine
+{
+	const char* ToString(SamplerType type) noexcept
+	{
+		switch (type)
+		{
+		case SamplerType::Random:         return "Random";
+		case SamplerType::SobolOwen:      return "SobolOwen";
+		case SamplerType::BlueNoiseSobol: return "BlueNoiseSobol";
+		default:                          return "Unknown";
+		}
+	}
+
+	void Sampler::StartPixelSample(std::uint32_t x, std::uint32_t y, std::uint32_t sampleIndex) noexcept
+	{
+		m_X = x;
+		m_Y = y;
+		m_SampleIndex = sampleIndex;
+		m_Dimension = 0;
+		m_PixelSeed = Sampling::HashCombine(Sampling::HashCombine(m_Seed, x), y);
+		if (m_Type == SamplerType::Random)
+			m_Random.Seed(m_PixelSeed, sampleIndex);
+	}
+
+	float Sampler::Get1D() noexcept
+	{
+		const std::uint32_t dimension = m_Dimension++;
+		switch (m_Type)
+		{
+		case SamplerType::Random:
+			return m_Random.NextFloat();
+		case SamplerType::SobolOwen:
+			return Sampling::SobolOwen(m_SampleIndex, dimension, m_PixelSeed);
+		case SamplerType::BlueNoiseSobol:
+		default:
+		{
+			// Cranley-Patterson rotation by blue noise: every pixel walks the same well-stratified
+			// sequence, offset so that neighbouring pixels sit at very different points of it.
+			const float value = Sampling::SobolOwen(m_SampleIndex, dimension, m_Seed) + BlueNoise::Get().Sample(m_X, m_Y, dimension);
+			return value >= 1.0f ? value - 1.0f : value;
+		}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BlueNoise.h"
+#include "PCG.h"
+#include "Sobol.h"
+#include "RayEngine/Geometry/Math.h"
+
+namespace RayEngine
+{
+	enum class SamplerType : std::uint8_t
+	{
+		Random,        // PCG32, independent per pixel and sample
+		SobolOwen,     // Owen-scrambled Sobol, scrambled independently per pixel
+		BlueNoiseSobol // one Owen-scrambled Sobol sequence, rotated per pixel by blue noise
+	};
+
+	[[nodiscard]] const char* ToString(SamplerType type) noexcept;
+
+	// Per-pixel sample generator. A small value type: each render thread owns its own and there
+	// is no shared mutable state (the blue-noise table is read-only).
+	// Usage per pixel sample:
+	//   sampler.StartPixelSample(x, y, sampleIndex);
+	//   Vec2 film = sampler.Get2D(); Vec2 lens = sampler.Get2D(); float light = sampler.Get1D(); ...
+	// The values depend only on (type, seed, x, y, sampleIndex, dimension), never on which thread
+	// or in which order pixels are rendered. Pixels are decorrelated through per-pixel seeds
+	// (or blue-noise rotations); dimensions through per-dimension scrambles.
+	class Sampler
+	{
+	public:
+		explicit Sampler(SamplerType type = SamplerType::SobolOwen, std::uint32_t seed = 0) noexcept
+			: m_Type(type), m_Seed(seed)
+		{
+		}
+
+		void StartPixelSample(std::uint32_t x, std::uint32_t y, std::uint32_t sampleIndex) noexcept;
+
+		[[nodiscard]] float Get1D() noexcept;
+		[[nodiscard]] Vec2 Get2D() noexcept
+		{
+			const float u = Get1D();
+			return { u, Get1D() };
+		}
+
+		[[nodiscard]] SamplerType GetType() const noexcept { return m_Type; }
+		[[nodiscard]] std::uint32_t GetSeed() const noexcept { return m_Seed; }
+
+	private:
+		SamplerType m_Type;
+		std::uint32_t m_Seed;
+
+		std::uint32_t m_X = 0;
+		std::uint32_t m_Y = 0;
+		std::uint32_t m_PixelSeed = 0;
+		std::uint32_t m_SampleIndex = 0;
+		std::uint32_t m_Dimension = 0;
+		PCG32 m_Random;
+	};
+}
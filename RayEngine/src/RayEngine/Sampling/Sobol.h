@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace RayEngine::Sampling
+{
+	// Integer hash (lowbias32) used for every seed derivation in the sampling code.
+	[[nodiscard]] constexpr std::uint32_t Hash(std::uint32_t x) noexcept
+	{
+		x ^= x >> 16u;
+		x *= 0x7feb352du;
+		x ^= x >> 15u;
+		x *= 0x846ca68bu;
+		x ^= x >> 16u;
+		return x;
+	}
+
+	[[nodiscard]] constexpr std::uint32_t HashCombine(std::uint32_t seed, std::uint32_t value) noexcept
+	{
+		return seed ^ (Hash(value) + 0x9e3779b9u + (seed << 6u) + (seed >> 2u));
+	}
+
+	[[nodiscard]] constexpr std::uint32_t ReverseBits(std::uint32_t x) noexcept
+	{
+		x = ((x >> 1u) & 0x55555555u) | ((x & 0x55555555u) << 1u);
+		x = ((x >> 2u) & 0x33333333u) | ((x & 0x33333333u) << 2u);
+		x = ((x >> 4u) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4u);
+		x = ((x >> 8u) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8u);
+		return (x >> 16u) | (x << 16u);
+	}
+
+	// [0, 1) from the top 24 bits.
+	[[nodiscard]] constexpr float ToUnitFloat(std::uint32_t bits) noexcept
+	{
+		return static_cast<float>(bits >> 8u) * 0x1p-24f;
+	}
+
+	namespace Detail
+	{
+		// Sobol generator matrices (direction numbers, MSB first) for the first four dimensions
+		// (Joe-Kuo): van der Corput, then s/a/m = 1/0/{1}, 2/1/{1,3}, 3/1/{1,3,1}.
+		struct SobolDimension
+		{
+			std::uint32_t Degree;
+			std::uint32_t Coefficients;
+			std::array<std::uint32_t, 3> InitialDirections;
+		};
+
+		constexpr std::array<std::array<std::uint32_t, 32>, 4> BuildSobolMatrices() noexcept
+		{
+			constexpr std::array<SobolDimension, 3> dimensions{ {
+				{ 1, 0, { 1, 0, 0 } },
+				{ 2, 1, { 1, 3, 0 } },
+				{ 3, 1, { 1, 3, 1 } },
+			} };
+
+			std::array<std::array<std::uint32_t, 32>, 4> matrices{};
+			for (std::uint32_t k = 0; k < 32; ++k)
+				matrices[0][k] = 1u << (31u - k);
+
+			for (std::uint32_t d = 0; d < dimensions.size(); ++d)
+			{
+				const SobolDimension& dim = dimensions[d];
+				std::array<std::uint32_t, 32>& v = matrices[d + 1];
+				for (std::uint32_t k = 0; k < dim.Degree; ++k)
+					v[k] = dim.InitialDirections[k] << (31u - k);
+				for (std::uint32_t k = dim.Degree; k < 32; ++k)
+				{
+					v[k] = v[k - dim.Degree] ^ (v[k - dim.Degree] >> dim.Degree);
+					for (std::uint32_t j = 1; j < dim.Degree; ++j)
+					{
+						if ((dim.Coefficients >> (dim.Degree - 1u - j)) & 1u)
+							v[k] ^= v[k - j];
+					}
+				}
+			}
+			return matrices;
+		}
+
+		// Matrix-vector products per index byte: SobolSample is four lookups instead of 32 steps.
+		using SobolByteTables = std::array<std::array<std::array<std::uint32_t, 256>, 4>, 4>;
+
+		constexpr SobolByteTables BuildSobolByteTables() noexcept
+		{
+			const auto matrices = BuildSobolMatrices();
+			SobolByteTables tables{};
+			for (std::uint32_t dimension = 0; dimension < 4; ++dimension)
+			{
+				for (std::uint32_t byte = 0; byte < 4; ++byte)
+				{
+					for (std::uint32_t value = 0; value < 256; ++value)
+					{
+						std::uint32_t result = 0;
+						for (std::uint32_t bit = 0; bit < 8; ++bit)
+						{
+							if ((value >> bit) & 1u)
+								result ^= matrices[dimension][byte * 8 + bit];
+						}
+						tables[dimension][byte][value] = result;
+					}
+				}
+			}
+			return tables;
+		}
+
+		inline constexpr SobolByteTables sobolByteTables = BuildSobolByteTables();
+	}
+
+	inline constexpr std::uint32_t sobolDimensions = 4;
+
+	// Unscrambled Sobol point `index` in dimension `dimension` (< sobolDimensions), as 32 bits.
+	[[nodiscard]] constexpr std::uint32_t SobolSample(std::uint32_t index, std::uint32_t dimension) noexcept
+	{
+		const auto& tables = Detail::sobolByteTables[dimension];
+		return tables[0][index & 0xffu] ^ tables[1][(index >> 8u) & 0xffu] ^ tables[2][(index >> 16u) & 0xffu] ^ tables[3][index >> 24u];
+	}
+
+	// Hash-based nested uniform (Owen) scramble, Laine-Karras style with Burley's constants:
+	// each bit is flipped depending only on the bits above it, which keeps the (0,m,s)-net
+	// properties of the sequence while decorrelating it.
+	[[nodiscard]] constexpr std::uint32_t NestedUniformScramble(std::uint32_t x, std::uint32_t seed) noexcept
+	{
+		x = ReverseBits(x);
+		x += seed;
+		x ^= x * 0x6c50b47cu;
+		x ^= x * 0xb82f1e52u;
+		x ^= x * 0xc7afe638u;
+		x ^= x * 0x8d22f6e6u;
+		return ReverseBits(x);
+	}
+
+	// Owen-scrambled Sobol in any dimension. Dimensions are taken in padded sets of four: each set
+	// reuses the four Sobol dimensions with its own index shuffle, so sets are uncorrelated with
+	// each other while every set keeps full 4D stratification.
+	[[nodiscard]] constexpr float SobolOwen(std::uint32_t index, std::uint32_t dimension, std::uint32_t seed) noexcept
+	{
+		const std::uint32_t setSeed = HashCombine(seed, dimension / sobolDimensions);
+		const std::uint32_t shuffled = NestedUniformScramble(index, Hash(setSeed));
+		const std::uint32_t sample = SobolSample(shuffled, dimension % sobolDimensions);
+		return ToUnitFloat(NestedUniformScramble(sample, HashCombine(setSeed, dimension % sobolDimensions)));
+	}
+}
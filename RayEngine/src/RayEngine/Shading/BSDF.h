@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "Material.h"
+
+namespace RayEngine
+{
+	// Orthonormal basis around a unit normal (Duff et al., "Building an Orthonormal Basis, Revisited").
+	struct ShadingFrame
+	{
+		Vec3 Tangent;
+		Vec3 Bitangent;
+		Vec3 Normal;
+
+		[[nodiscard]] static ShadingFrame FromNormal(const Vec3& normal) noexcept
+		{
+			const float sign = std::copysign(1.0f, normal.Z);
+			const float a = -1.0f / (sign + normal.Z);
+			const float b = normal.X * normal.Y * a;
+			return { { 1.0f + sign * normal.X * normal.X * a, sign * b, -sign * normal.X }, { b, sign + normal.Y * normal.Y * a, -normal.Y }, normal };
+		}
+
+		[[nodiscard]] Vec3 ToWorld(const Vec3& local) const noexcept { return Tangent * local.X + Bitangent * local.Y + Normal * local.Z; }
+	};
+
+	// Lobe evaluation and sampling. Directions are world space and unit length; `wo` points back
+	// towards the viewer and `normal` is on its side. Sampling functions return the sampled
+	// direction and, in `weight`, f * cos / pdf for that lobe alone.
+	namespace BSDF
+	{
+		[[nodiscard]] inline Vec3 Reflect(const Vec3& wo, const Vec3& normal) noexcept { return normal * (2.0f * Dot(wo, normal)) - wo; }
+
+		[[nodiscard]] inline Vec3 EvaluateDiffuse(const Material& material) noexcept { return material.Diffuse * std::numbers::inv_pi_v<float>; }
+
+		[[nodiscard]] inline Vec3 SampleDiffuse(const Material& material, const Vec3& normal, Vec2 u, Vec3& weight) noexcept
+		{
+			// Cosine-weighted hemisphere: f * cos / pdf is the albedo.
+			const float radius = std::sqrt(u.X);
+			const float phi = 2.0f * std::numbers::pi_v<float> * u.Y;
+			weight = material.Diffuse;
+			return ShadingFrame::FromNormal(normal).ToWorld({ radius * std::cos(phi), radius * std::sin(phi), std::sqrt(std::max(0.0f, 1.0f - u.X)) });
+		}
+
+		// Normalized Phong: Glossy * (n + 2) / (2 pi) * cos^n of the angle to the mirror direction.
+		[[nodiscard]] inline Vec3 EvaluateGlossy(const Material& material, const Vec3& normal, const Vec3& wo, const Vec3& wi) noexcept
+		{
+			const float cosAlpha = Dot(Reflect(wo, normal), wi);
+			if (cosAlpha <= 0.0f)
+				return {};
+			const float exponent = material.GlossyExponent;
+			return material.Glossy * ((exponent + 2.0f) * 0.5f * std::numbers::inv_pi_v<float> * std::pow(cosAlpha, exponent));
+		}
+
+		[[nodiscard]] inline Vec3 SampleGlossy(const Material& material, const Vec3& normal, const Vec3& wo, Vec2 u, Vec3& weight) noexcept
+		{
+			// pdf = (n + 1) / (2 pi) cos^n around the mirror direction.
+			const float exponent = material.GlossyExponent;
+			const float cosAlpha = std::pow(u.X, 1.0f / (exponent + 1.0f));
+			const float sinAlpha = std::sqrt(std::max(0.0f, 1.0f - cosAlpha * cosAlpha));
+			const float phi = 2.0f * std::numbers::pi_v<float> * u.Y;
+			const Vec3 wi = ShadingFrame::FromNormal(Reflect(wo, normal)).ToWorld({ sinAlpha * std::cos(phi), sinAlpha * std::sin(phi), cosAlpha });
+			const float cosTheta = Dot(wi, normal);
+			weight = cosTheta > 0.0f ? material.Glossy * ((exponent + 2.0f) / (exponent + 1.0f) * cosTheta) : Vec3{};
+			return wi;
+		}
+
+		[[nodiscard]] inline Vec3 SampleSpecular(const Material& material, const Vec3& normal, const Vec3& wo, Vec3& weight) noexcept
+		{
+			weight = material.Specular;
+			return Reflect(wo, normal);
+		}
+	}
+}
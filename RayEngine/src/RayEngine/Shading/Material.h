@@ -0,0 +1,52 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "RayEngine/Geometry/Math.h"
+
+namespace RayEngine
+{
+	using LobeMask = std::uint8_t; // bit set = BSDF lobe present
+	inline constexpr LobeMask diffuseLobe = 1u << 0;
+	inline constexpr LobeMask glossyLobe = 1u << 1;
+	inline constexpr LobeMask specularLobe = 1u << 2;
+	inline constexpr LobeMask allLobes = diffuseLobe | glossyLobe | specularLobe;
+
+	[[nodiscard]] constexpr bool IsSingleLobe(LobeMask lobes) noexcept { return std::popcount(lobes) == 1; }
+
+	// Surface description as a sum of up to three lobes: Lambertian diffuse, a normalized Phong
+	// lobe around the mirror direction, and a perfect mirror. A zero colour disables its lobe.
+	// The lobes are not renormalized: keep Diffuse + Glossy + Specular <= 1 per channel.
+	struct Material
+	{
+		Vec3 Diffuse;
+		Vec3 Glossy;
+		float GlossyExponent = 64.0f; // higher is sharper
+		Vec3 Specular;
+		Vec3 Emission;                // radiance leaving the front side, (v1-v0)x(v2-v0)
+
+		[[nodiscard]] static Material MakeDiffuse(const Vec3& albedo) noexcept
+		{
+			Material material;
+			material.Diffuse = albedo;
+			return material;
+		}
+
+		[[nodiscard]] static Material MakeEmissive(const Vec3& radiance) noexcept
+		{
+			Material material;
+			material.Emission = radiance;
+			return material;
+		}
+
+		[[nodiscard]] LobeMask GetLobes() const noexcept
+		{
+			const auto present = [](const Vec3& colour) { return colour.X > 0.0f || colour.Y > 0.0f || colour.Z > 0.0f; };
+			return static_cast<LobeMask>((present(Diffuse) ? diffuseLobe : 0) | (present(Glossy) ? glossyLobe : 0)
+				| (present(Specular) ? specularLobe : 0));
+		}
+
+		[[nodiscard]] bool IsEmissive() const noexcept { return Emission.X > 0.0f || Emission.Y > 0.0f || Emission.Z > 0.0f; }
+	};
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Geometry/BVH.h"
+#include "RayEngine/Geometry/CompressedWideBVH.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Procedural terrain: a gridSize x gridSize heightfield, two triangles per cell.
+inline RayEngine::TriangleMesh MakeExampleTerrain(std::uint32_t gridSize)
+{
+    RayEngine::TriangleMesh mesh;
+    const std::uint32_t verticesPerRow = gridSize + 1;
+    mesh.Positions.reserve(static_cast<std::size_t>(verticesPerRow) * verticesPerRow);
+    for (std::uint32_t z = 0; z <= gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x <= gridSize; ++x)
+        {
+            const float fx = static_cast<float>(x) / gridSize, fz = static_cast<float>(z) / gridSize;
+            const float height = 0.08f * std::sin(fx * 23.0f) * std::cos(fz * 17.0f) + 0.03f * std::sin((fx + fz) * 71.0f);
+            mesh.Positions.push_back({ fx, height, fz });
+        }
+    }
+
+    mesh.Indices.reserve(static_cast<std::size_t>(gridSize) * gridSize * 6);
+    for (std::uint32_t z = 0; z < gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x < gridSize; ++x)
+        {
+            const std::uint32_t v = z * verticesPerRow + x;
+            mesh.Indices.insert(mesh.Indices.end(), { v, v + verticesPerRow, v + 1, v + 1, v + verticesPerRow, v + verticesPerRow + 1 });
+        }
+    }
+    return mesh;
+}
+
+// Sandbox bvh-bench: memory per triangle and ray throughput of the full-precision binary BVH
+// against the quantized 4- and 8-wide layouts, plus a check that every ray reports the same hit.
+inline int RunBVHCompressionBenchmark()
+{
+    constexpr std::uint32_t gridSize = 512;
+    constexpr std::uint32_t imageSize = 512;
+
+    const RayEngine::TriangleMesh mesh = MakeExampleTerrain(gridSize);
+    const double triangles = static_cast<double>(mesh.GetTriangleCount());
+
+    std::vector<RayEngine::Ray> rays;
+    rays.reserve(static_cast<std::size_t>(imageSize) * imageSize);
+    const RayEngine::Vec3 eye{ 0.5f, 0.6f, -0.4f };
+    for (std::uint32_t y = 0; y < imageSize; ++y)
+    {
+        for (std::uint32_t x = 0; x < imageSize; ++x)
+        {
+            const RayEngine::Vec3 target{ (x + 0.5f) / imageSize, 0.0f, (y + 0.5f) / imageSize * 1.2f };
+            rays.push_back({ eye, RayEngine::Normalize(target - eye) });
+        }
+    }
+
+    const auto timed = [](auto&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::vector<RayEngine::Hit> reference(rays.size());
+    std::unique_ptr<RayEngine::BVH> bvh;
+    const double buildSeconds = timed([&] { bvh = std::make_unique<RayEngine::BVH>(mesh); });
+    const double referenceSeconds = timed([&] {
+        for (std::size_t i = 0; i < rays.size(); ++i)
+            reference[i] = bvh->Intersect(rays[i]);
+    });
+    const double nodeBytes = static_cast<double>(bvh->GetNodes().size() * sizeof(RayEngine::BVHNode));
+    RAY_CLIENT_INFO("BVHBench: {} triangles, {} vertices, {} rays", mesh.GetTriangleCount(), mesh.Positions.size(), rays.size());
+    RAY_CLIENT_INFO("BVHBench: binary fp32  {:6.2f} B/tri ({:5.2f} in nodes), build {:.0f} ms, {:.2f} Mrays/s",
+        bvh->GetMemoryBytes() / triangles, nodeBytes / triangles, buildSeconds * 1000.0, rays.size() / referenceSeconds / 1e6);
+
+    int result = 0;
+    const auto measure = [&](const auto& compressed, const char* name) {
+        std::size_t mismatches = 0;
+        const double seconds = timed([&] {
+            for (std::size_t i = 0; i < rays.size(); ++i)
+            {
+                const RayEngine::Hit hit = compressed.Intersect(rays[i]);
+                mismatches += hit.IsHit() != reference[i].IsHit() || (hit.IsHit() && hit.T != reference[i].T);
+            }
+        });
+        const double wideNodeBytes = static_cast<double>(compressed.GetNodeCount() * sizeof(typename std::remove_cvref_t<decltype(compressed)>::Node));
+        RAY_CLIENT_INFO("BVHBench: {} {:6.2f} B/tri ({:5.2f} in nodes, {} duplicated vertices), {:.2f} Mrays/s, {:.2f}x slower, {} mismatches",
+            name, compressed.GetMemoryBytes() / triangles, wideNodeBytes / triangles, compressed.GetDuplicatedVertexCount(),
+            rays.size() / seconds / 1e6, seconds / referenceSeconds, mismatches);
+        if (mismatches != 0)
+            result = -1;
+    };
+
+    measure(RayEngine::CompressedBVH4(*bvh), "wide4 q8  ");
+    measure(RayEngine::CompressedBVH8(*bvh), "wide8 q8  ");
+    return result;
+}
@@ -0,0 +1,115 @@
+
+#pragma once
+
+#ifdef __linux__
+
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Distributed/RenderCoordinator.h"
+#include "RayEngine/Distributed/RenderWorker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Mandelbrot tile kernel: per-tile cost varies by orders of magnitude, which is what the
+// coordinator's cost-ordered dynamic dispatch has to cope with.
+inline void ExampleMandelbrotKernel(const RayEngine::Tile& tile, std::uint64_t frameIndex, RayEngine::SharedFramebuffer& target)
+{
+    constexpr int maxIterations = 512;
+    const double zoom = 1.0 + 0.05 * static_cast<double>(frameIndex);
+    const double width = target.GetWidth();
+    const double height = target.GetHeight();
+
+    for (std::uint32_t y = tile.Y; y < tile.Y + tile.Height; ++y)
+    {
+        float* pixel = target.GetPixel(tile.X, y);
+        for (std::uint32_t x = tile.X; x < tile.X + tile.Width; ++x, pixel += RayEngine::SharedFramebuffer::channels)
+        {
+            const double cr = -0.745 + (x / width - 0.5) * 3.0 / zoom;
+            const double ci = 0.1 + (y / height - 0.5) * 1.7 / zoom;
+            double zr = 0.0, zi = 0.0;
+            int i = 0;
+            for (; i < maxIterations && zr * zr + zi * zi < 4.0; ++i)
+            {
+                const double t = zr * zr - zi * zi + cr;
+                zi = 2.0 * zr * zi + ci;
+                zr = t;
+            }
+            const float v = static_cast<float>(i) / maxIterations;
+            pixel[0] = v;
+            pixel[1] = v * v;
+            pixel[2] = 1.0f - v;
+            pixel[3] = 1.0f;
+        }
+    }
+}
+
+// Sandbox dist-bench: throughput for 1, 2, 4 and 8 local workers, then a run that SIGKILLs a
+// worker mid-frame and checks that the frame still completes with every pixel written.
+inline int RunDistributedRenderBenchmark()
+{
+    constexpr int framesPerRun = 4;
+
+    char executable[4096] = {};
+    const ssize_t length = ::readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    if (length <= 0)
+        return -1;
+
+    RayEngine::RenderCoordinatorSpecification spec;
+    spec.Width = 640;
+    spec.Height = 360;
+    spec.TileSize = 32;
+
+    double singleWorkerRate = 0.0;
+    for (std::size_t workers : { 1u, 2u, 4u, 8u })
+    {
+        RayEngine::RenderCoordinator coordinator(spec);
+        if (!coordinator.Start() || !coordinator.SpawnWorkers(workers, executable) || !coordinator.WaitForWorkers(workers, 5000))
+            return -1;
+
+        (void)coordinator.RenderFrame(0); // warm-up: measures tile costs
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 1; frame <= framesPerRun; ++frame)
+        {
+            if (!coordinator.RenderFrame(static_cast<std::uint64_t>(frame)))
+                return -1;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double rate = framesPerRun * static_cast<double>(spec.Width) * spec.Height / seconds / 1e6;
+        if (workers == 1)
+            singleWorkerRate = rate;
+        RAY_CLIENT_INFO("DistBench: {} worker(s): {:.2f} MPix/s, {:.1f} ms/frame, speedup {:.2f}x",
+            workers, rate, seconds * 1000.0 / framesPerRun, rate / singleWorkerRate);
+    }
+
+    // Fault injection: kill one of three workers after the frame has started.
+    RayEngine::RenderCoordinator coordinator(spec);
+    if (!coordinator.Start() || !coordinator.SpawnWorkers(3, executable) || !coordinator.WaitForWorkers(3, 5000))
+        return -1;
+
+    auto& framebuffer = coordinator.GetFramebuffer();
+    std::fill_n(framebuffer.GetPixels(), static_cast<std::size_t>(spec.Width) * spec.Height * RayEngine::SharedFramebuffer::channels, 0.0f);
+
+    coordinator.BeginFrame(0);
+    for (int i = 0; i < 5 && !coordinator.IsFrameComplete(); ++i)
+        coordinator.Update(1);
+    coordinator.KillWorker(0);
+    while (!coordinator.IsFrameComplete() && coordinator.GetAliveWorkerCount() > 0)
+        coordinator.Update(100);
+
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(spec.Width) * spec.Height; ++i)
+        written += framebuffer.GetPixels()[i * RayEngine::SharedFramebuffer::channels + 3] == 1.0f;
+
+    const auto& stats = coordinator.GetStats();
+    RAY_CLIENT_INFO("DistBench: fault run {} - {} worker(s) lost, {} tile(s) reassigned, {}/{} pixels written",
+        coordinator.IsFrameComplete() ? "completed" : "FAILED", stats.WorkersLost, stats.TilesReassigned,
+        written, static_cast<std::size_t>(spec.Width) * spec.Height);
+    return coordinator.IsFrameComplete() && written == static_cast<std::size_t>(spec.Width) * spec.Height ? 0 : -1;
+}
+
+#endif
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/ECS/World.h"
+#include "RayEngine/Geometry/Math.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Sandbox ecs-bench: one million entities through the World versus the pre-ECS pattern of one
+// heap-allocated object per entity with a virtual update. Measures spawn (batched, one by one and
+// deferred), per-entity and per-chunk iteration on one thread and across the pool, and a frame of
+// mass destruction requested from inside a parallel query and applied at the safe point.
+namespace ExampleECS
+{
+    struct Position { RayEngine::Vec3 Value; };
+    struct Velocity { RayEngine::Vec3 Value; };
+    struct Lifetime { float Seconds; };
+    struct Sleeping {};
+
+    // Baseline: what a Layer-per-object design does per entity.
+    class Object
+    {
+    public:
+        virtual ~Object() = default;
+        virtual void Update(float dt) = 0;
+    };
+
+    class MovingObject final : public Object
+    {
+    public:
+        MovingObject(const RayEngine::Vec3& velocity) : m_Velocity(velocity) {}
+        void Update(float dt) override { m_Position += m_Velocity * dt; m_Lifetime -= dt; }
+
+    private:
+        RayEngine::Vec3 m_Position{};
+        RayEngine::Vec3 m_Velocity;
+        float m_Lifetime = 10.0f;
+    };
+
+    template<typename Fn>
+    double MeasureMs(Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+inline int RunECSBenchmark()
+{
+    using namespace ExampleECS;
+    constexpr std::size_t entityCount = 1'000'000;
+    constexpr int iterations = 10;
+    constexpr float dt = 1.0f / 60.0f;
+    auto& pool = RayEngine::Application::GetInstance().GetThreadPool();
+
+    RAY_CLIENT_INFO("ECSBench: {} entities, {} pool worker(s) + caller, {} KiB chunks", entityCount, pool.GetWorkerCount(),
+        RayEngine::ChunkAllocator::chunkBytes / 1024);
+
+    // --- baseline ---
+    {
+        std::vector<std::unique_ptr<Object>> objects;
+        const double spawn = MeasureMs([&] {
+            objects.reserve(entityCount);
+            for (std::size_t i = 0; i < entityCount; ++i)
+                objects.push_back(std::make_unique<MovingObject>(RayEngine::Vec3{ 1.0f, 0.0f, static_cast<float>(i & 7) }));
+        });
+        const double update = MeasureMs([&] {
+            for (int it = 0; it < iterations; ++it)
+                for (const auto& object : objects)
+                    object->Update(dt);
+        }) / iterations;
+        const double destroy = MeasureMs([&] { objects.clear(); });
+        RAY_CLIENT_INFO("ECSBench: heap objects + virtual Update   spawn {:7.1f} ms  update {:6.2f} ms ({:5.2f} ns/entity)  destroy {:6.1f} ms",
+            spawn, update, update * 1e6 / entityCount, destroy);
+    }
+
+    // --- spawn ---
+    {
+        RayEngine::World world;
+        const double single = MeasureMs([&] {
+            for (std::size_t i = 0; i < entityCount; ++i)
+                world.Create(Position{}, Velocity{ { 1.0f, 0.0f, static_cast<float>(i & 7) } }, Lifetime{ 10.0f });
+        });
+        std::vector<RayEngine::Entity> entities;
+        const double destroyAll = MeasureMs([&] {
+            world.ForEachChunk<>([&](std::span<const RayEngine::Entity> chunk) { entities.insert(entities.end(), chunk.begin(), chunk.end()); });
+            for (RayEngine::Entity entity : entities)
+                world.Destroy(entity);
+        });
+        const double batched = MeasureMs([&] { world.CreateMany(entityCount, Position{}, Velocity{ { 1.0f, 0.0f, 0.0f } }, Lifetime{ 10.0f }); });
+        RayEngine::World deferredWorld;
+        const double queue = MeasureMs([&] {
+            for (std::size_t i = 0; i < entityCount; ++i)
+                deferredWorld.CreateDeferred(Position{}, Velocity{ { 1.0f, 0.0f, 0.0f } }, Lifetime{ 10.0f });
+        });
+        const double apply = MeasureMs([&] { deferredWorld.ApplyPending(); });
+        RAY_CLIENT_INFO("ECSBench: spawn one by one {:6.1f} ms, batched {:5.1f} ms, deferred {:6.1f} ms queue + {:6.1f} ms apply; destroy one by one {:5.1f} ms",
+            single, batched, queue, apply, destroyAll);
+    }
+
+    // --- iteration and deferred destruction ---
+    RayEngine::World world;
+    world.CreateMany(entityCount / 2, Position{}, Velocity{ { 1.0f, 0.0f, 0.0f } }, Lifetime{ 5.0f });
+    world.CreateMany(entityCount / 4, Position{}, Velocity{ { 0.0f, 1.0f, 0.0f } }, Lifetime{ 10.0f }, Sleeping{});
+    world.CreateMany(entityCount / 4, Position{}, Velocity{ { 0.0f, 0.0f, 1.0f } });
+    RAY_CLIENT_INFO("ECSBench: {} entities in {} archetypes, {} MiB of chunks", world.GetEntityCount(), world.GetArchetypeCount(),
+        world.GetChunkMemoryBytes() >> 20);
+
+    const auto report = [&](const char* label, double ms) {
+        RAY_CLIENT_INFO("ECSBench: {:<34} {:6.2f} ms ({:5.2f} ns/entity)", label, ms, ms * 1e6 / world.GetEntityCount());
+    };
+    report("ForEach<Position, const Velocity>", MeasureMs([&] {
+        for (int it = 0; it < iterations; ++it)
+            world.ForEach<Position, const Velocity>([](Position& p, const Velocity& v) { p.Value += v.Value * dt; });
+    }) / iterations);
+    report("ForEachChunk (spans)", MeasureMs([&] {
+        for (int it = 0; it < iterations; ++it)
+        {
+            world.ForEachChunk<Position, const Velocity>([](std::span<const RayEngine::Entity>, std::span<Position> p, std::span<const Velocity> v) {
+                for (std::size_t i = 0; i < p.size(); ++i)
+                    p[i].Value += v[i].Value * dt;
+            });
+        }
+    }) / iterations);
+    report("ParallelForEach", MeasureMs([&] {
+        for (int it = 0; it < iterations; ++it)
+            world.ParallelForEach<Position, const Velocity>(&pool, [](Position& p, const Velocity& v) { p.Value += v.Value * dt; });
+    }) / iterations);
+
+    // Expire every entity with a Lifetime of 5 s after one simulated step of 5 s: 500k destroys
+    // requested concurrently from worker threads, applied together at the safe point.
+    std::size_t requested = 0;
+    const double query = MeasureMs([&] {
+        world.ParallelForEachChunk<Lifetime>(&pool, [&](std::span<const RayEngine::Entity> entities, std::span<Lifetime> lifetimes) {
+            std::vector<RayEngine::Entity> expired;
+            for (std::size_t i = 0; i < lifetimes.size(); ++i)
+            {
+                lifetimes[i].Seconds -= 5.0f;
+                if (lifetimes[i].Seconds <= 0.0f)
+                    expired.push_back(entities[i]);
+            }
+            world.DestroyDeferred(expired);
+        });
+        requested = world.GetPendingCommandCount();
+    });
+    const double apply = MeasureMs([&] { world.ApplyPending(); });
+    RAY_CLIENT_INFO("ECSBench: expire query {:.2f} ms queued {} destroys, ApplyPending {:.2f} ms, {} entities left",
+        query, requested, apply, world.GetEntityCount());
+    return 0;
+}
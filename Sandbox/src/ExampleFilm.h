@@ -0,0 +1,95 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Film/Film.h"
+#include "RayEngine/Sampling/PCG.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Sandbox film-bench: develop throughput (exposure + ACES + gamma + 8-bit) of a 4K film for the
+// scalar reference, the SIMD kernel on one thread and the SIMD kernel over the thread pool, in
+// both accumulation formats, plus the accuracy cost of SIMD math and of fp16 accumulation.
+inline int RunFilmBenchmark()
+{
+    constexpr std::uint32_t width = 3840;
+    constexpr std::uint32_t height = 2160;
+    constexpr int repetitions = 5;
+    const double pixels = static_cast<double>(width) * height;
+
+    RayEngine::Film film32(width, height, RayEngine::FilmFormat::RGBA32F);
+    RayEngine::Film film16(width, height, RayEngine::FilmFormat::RGBA16F);
+    RayEngine::PCG32 rng(7);
+    for (std::uint32_t y = 0; y < height; ++y)
+    {
+        for (std::uint32_t x = 0; x < width; ++x)
+        {
+            for (int sample = 0; sample < 4; ++sample)
+            {
+                // Log-uniform HDR radiance between 2^-6 and 2^6.
+                const RayEngine::Vec3 radiance{ std::exp2(rng.NextFloat() * 12.0f - 6.0f), std::exp2(rng.NextFloat() * 12.0f - 6.0f),
+                    std::exp2(rng.NextFloat() * 12.0f - 6.0f) };
+                film32.AddSample(x, y, radiance);
+                film16.AddSample(x, y, radiance);
+            }
+        }
+    }
+
+    auto& pool = RayEngine::Application::GetInstance().GetThreadPool();
+    std::vector<std::uint8_t> reference(static_cast<std::size_t>(width) * height * 4);
+    std::vector<std::uint8_t> output(reference.size());
+    RayEngine::FilmDevelopSettings settings;
+    settings.ExposureEV = 0.5f;
+
+    RAY_CLIENT_INFO("FilmBench: {}x{}, SIMD kernel '{}', {} pool worker(s) + caller", width, height,
+        RayEngine::Film::GetSIMDKernelName(), pool.GetWorkerCount());
+    for (const RayEngine::Film* film : { &film32, &film16 })
+    {
+        const auto run = [&](RayEngine::FilmKernel kernel, RayEngine::ThreadPool* threads, std::vector<std::uint8_t>& target) {
+            settings.Kernel = kernel;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repetitions; ++i)
+                (void)film->Develop(settings, target, threads);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repetitions;
+            return pixels / seconds / 1e6;
+        };
+
+        const double scalar = run(RayEngine::FilmKernel::Scalar, nullptr, reference);
+        const double simd = run(RayEngine::FilmKernel::SIMD, nullptr, output);
+        const double parallel = run(RayEngine::FilmKernel::SIMD, &pool, output);
+
+        int maxDifference = 0;
+        std::size_t differing = 0;
+        for (std::size_t i = 0; i < reference.size(); ++i)
+        {
+            const int difference = std::abs(static_cast<int>(reference[i]) - static_cast<int>(output[i]));
+            maxDifference = std::max(maxDifference, difference);
+            differing += difference != 0;
+        }
+
+        RAY_CLIENT_INFO("FilmBench: {} ({} MiB): scalar {:.1f} MPix/s, SIMD {:.1f} MPix/s ({:.1f}x), SIMD parallel {:.1f} MPix/s ({:.1f}x)",
+            ToString(film->GetFormat()), film->GetMemoryBytes() >> 20, scalar, simd, simd / scalar, parallel, parallel / scalar);
+        RAY_CLIENT_INFO("FilmBench: {}: SIMD vs scalar max {} LSB, {:.3f}% of channels differ", ToString(film->GetFormat()),
+            maxDifference, 100.0 * differing / reference.size());
+    }
+
+    double maxRelativeError = 0.0;
+    for (std::uint32_t y = 0; y < height; y += 7)
+    {
+        for (std::uint32_t x = 0; x < width; x += 7)
+        {
+            const RayEngine::Vec3 full = film32.GetPixel(x, y);
+            const RayEngine::Vec3 half = film16.GetPixel(x, y);
+            for (int channel = 0; channel < 3; ++channel)
+                maxRelativeError = std::max(maxRelativeError, std::abs(static_cast<double>(half[channel] - full[channel])) / full[channel]);
+        }
+    }
+    constexpr double pixels8K = 7680.0 * 4320.0;
+    RAY_CLIENT_INFO("FilmBench: fp16 accumulation max relative error {:.2e}; 8K film {} MiB (fp32) vs {} MiB (fp16)",
+        maxRelativeError, static_cast<std::uint64_t>(pixels8K * 16) >> 20, static_cast<std::uint64_t>(pixels8K * 8) >> 20);
+    return 0;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Output/FramePublisher.h"
+#include "RayEngine/Output/FrameReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <spawn.h>
+#include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+extern char** environ;
+
+inline constexpr std::string_view exampleFrameReaderFlag = "--ray-frame-reader";
+
+// Reader process for frame-pub-bench, built on RayFrameReader only:
+//   Sandbox --ray-frame-reader <shm name> <last frame index> <consume microseconds>
+// Waits for frames, consumes each one in place (checksums it, then pretends to work for
+// <consume microseconds>) and prints publish-to-visible latency and skipped/torn counts.
+inline int RunFrameReaderProcess(int argc, char** argv)
+{
+    if (argc < 5)
+        return 2;
+    const std::string name = argv[2];
+    const std::uint64_t lastFrame = std::strtoull(argv[3], nullptr, 10);
+    const auto consume = std::chrono::microseconds(std::strtoll(argv[4], nullptr, 10));
+
+    std::unique_ptr<RayEngine::FrameReader> reader;
+    std::string error;
+    for (int attempt = 0; attempt < 200 && !reader; ++attempt)
+    {
+        reader = RayEngine::FrameReader::Open(name, &error);
+        if (!reader)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!reader)
+    {
+        std::fprintf(stderr, "frame reader: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<std::int64_t> latencies;
+    std::uint64_t seen = 0, skipped = 0, torn = 0, previous = 0, checksum = 0;
+    while (reader->WaitForFrame(previous, 2000))
+    {
+        const std::optional<RayEngine::FrameView> view = reader->AcquireLatest();
+        if (!view)
+            continue;
+        latencies.push_back(RayEngine::FrameRing::NowNanoseconds() - view->PublishNanoseconds);
+
+        // Consume in place: the first byte of every row carries the frame index (see the writer).
+        for (std::size_t row = 0; row < view->Height; ++row)
+            checksum += static_cast<std::uint8_t>(view->Pixels[row * view->Width * 4]);
+        if (consume.count() > 0)
+            std::this_thread::sleep_for(consume);
+
+        if (!reader->IsStillValid(*view))
+            torn++;
+        seen++;
+        skipped += previous != 0 ? view->Sequence - previous - 1 : 0;
+        previous = view->Sequence;
+        if (view->FrameIndex >= lastFrame)
+            break;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](double p) {
+        return latencies.empty() ? 0.0 : latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))] / 1000.0;
+    };
+    std::printf("[frame reader %d] consume %lld us: %llu frames seen, %llu skipped, %llu torn (discarded); "
+        "latency p50 %.1f us, p99 %.1f us, max %.1f us (checksum %llu)\n",
+        static_cast<int>(::getpid()), static_cast<long long>(consume.count()),
+        static_cast<unsigned long long>(seen), static_cast<unsigned long long>(skipped), static_cast<unsigned long long>(torn),
+        percentile(0.5), percentile(0.99), percentile(1.0), static_cast<unsigned long long>(checksum));
+    return 0;
+}
+
+// Sandbox frame-pub-bench: renders a 1280x720 RGBA8 test pattern straight into the publisher's
+// ring every frame, with two reader processes attached: a fast one (latency) and one that takes
+// 20 ms per frame and must fall behind without ever stalling the render loop.
+class ExampleLayerFramePublish : public RayEngine::Layer
+{
+public:
+    static constexpr std::uint64_t frameCount = 1000;
+
+    ExampleLayerFramePublish() : RayEngine::Layer("ExampleFramePublish") {}
+
+    void OnAttach() override
+    {
+        RayEngine::FramePublisherSpecification spec;
+        spec.Name = "/rayengine-frame-bench-" + std::to_string(::getpid());
+        spec.Width = 1280;
+        spec.Height = 720;
+        spec.SlotCount = 4;
+        m_Publisher = RayEngine::FramePublisher::Create(spec);
+        if (!m_Publisher)
+        {
+            RayEngine::Application::GetInstance().Stop();
+            return;
+        }
+
+        char executable[4096] = {};
+        if (::readlink("/proc/self/exe", executable, sizeof(executable) - 1) <= 0)
+            return;
+        for (const char* consume : { "0", "20000" })
+        {
+            const std::string lastFrame = std::to_string(frameCount - 1);
+            char* args[] = { executable, const_cast<char*>(exampleFrameReaderFlag.data()), spec.Name.data(),
+                const_cast<char*>(lastFrame.c_str()), const_cast<char*>(consume), nullptr };
+            pid_t pid = 0;
+            if (::posix_spawn(&pid, executable, nullptr, nullptr, args, environ) == 0)
+                m_Readers.push_back(pid);
+        }
+    }
+
+    void OnDetach() override
+    {
+        for (pid_t pid : m_Readers)
+            ::waitpid(pid, nullptr, 0);
+    }
+
+    void OnUpdate(float dt) override
+    {
+        if (!m_Publisher)
+            return;
+
+        // Start once both readers are attached (or after a grace period), so none misses frame 0.
+        if (m_Frame == 0 && m_Publisher->GetReaderCount() < m_Readers.size() && m_WaitFrames++ < 2000)
+            return;
+
+        if (m_Frame < frameCount)
+        {
+            m_MaxFrameSeconds = m_Frame > 0 ? std::max(m_MaxFrameSeconds, dt) : 0.0f;
+
+            // Zero copy: the pattern is written directly into the slot the readers will map.
+            const auto renderStart = std::chrono::steady_clock::now();
+            const std::span<std::byte> pixels = m_Publisher->BeginFrame();
+            const auto& spec = m_Publisher->GetSpecification();
+            for (std::uint32_t y = 0; y < spec.Height; ++y)
+            {
+                std::byte* row = pixels.data() + static_cast<std::size_t>(y) * spec.Width * 4;
+                for (std::uint32_t x = 0; x < spec.Width; ++x)
+                {
+                    row[x * 4 + 0] = static_cast<std::byte>(x == 0 ? m_Frame : x + m_Frame);
+                    row[x * 4 + 1] = static_cast<std::byte>(y);
+                    row[x * 4 + 2] = static_cast<std::byte>(x ^ y);
+                    row[x * 4 + 3] = std::byte{ 255 };
+                }
+            }
+            const auto commitStart = std::chrono::steady_clock::now();
+            m_Publisher->Commit(m_Frame);
+            const auto commitEnd = std::chrono::steady_clock::now();
+            m_RenderNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(commitStart - renderStart).count();
+            m_CommitNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(commitEnd - commitStart).count();
+            m_Frame++;
+            return;
+        }
+
+        // Keep the segment alive (and the loop running) until both readers are done.
+        for (auto it = m_Readers.begin(); it != m_Readers.end();)
+            it = ::waitpid(*it, nullptr, WNOHANG) == *it ? m_Readers.erase(it) : it + 1;
+        if (!m_Readers.empty())
+            return;
+
+        const auto& stats = m_Publisher->GetStats();
+        RAY_CLIENT_INFO("FramePubBench: {} frames of {} KiB published, render {:.1f} us/frame, commit {:.0f} ns/frame, {} reader wakeups",
+            stats.Published, m_Publisher->GetFrameBytes() / 1024, m_RenderNanoseconds / 1000.0 / frameCount,
+            static_cast<double>(m_CommitNanoseconds) / frameCount, stats.ReaderWakeups);
+        RAY_CLIENT_INFO("FramePubBench: longest frame while publishing {:.3f} ms", m_MaxFrameSeconds * 1000.0f);
+        m_Publisher.reset();
+        RayEngine::Application::GetInstance().Stop();
+    }
+
+private:
+    std::unique_ptr<RayEngine::FramePublisher> m_Publisher;
+    std::vector<pid_t> m_Readers;
+    std::uint64_t m_Frame = 0;
+    std::uint32_t m_WaitFrames = 0;
+    double m_RenderNanoseconds = 0.0;
+    std::int64_t m_CommitNanoseconds = 0;
+    float m_MaxFrameSeconds = 0.0f;
+};
+
+#endif
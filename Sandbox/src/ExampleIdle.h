@@ -0,0 +1,257 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/Scheduler.h"
+#include "RayEngine/IO/FileHandle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+// Sandbox idle-bench: the same engine run with the classic 1 ms polling loop and with
+// ApplicationSpecification::WakeOnWork. Reports CPU used and frames run while idle, how late the
+// loop reacts to each kind of wake-up (async layer push, coroutine timer, RunInBackground
+// completion, file read, Stop()), and the first frame delta after a long idle period.
+namespace ExampleIdle
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int samples = 40;
+
+    // Process CPU time (user + system).
+    inline double CpuSeconds()
+    {
+#ifdef __linux__
+        rusage usage{};
+        ::getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+            + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#else
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    inline double Microseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    struct Summary
+    {
+        double Median = 0.0;
+        double P99 = 0.0;
+    };
+
+    inline Summary Summarize(std::vector<double> values)
+    {
+        if (values.empty())
+            return {};
+        std::sort(values.begin(), values.end());
+        return { values[values.size() / 2], values[std::min(values.size() - 1, values.size() * 99 / 100)] };
+    }
+
+    class FrameCounterLayer : public RayEngine::Layer
+    {
+    public:
+        explicit FrameCounterLayer(std::atomic<std::uint64_t>& frames) : RayEngine::Layer("IdleFrameCounter"), m_Frames(frames) {}
+        void OnUpdate(float) override { m_Frames.fetch_add(1, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint64_t>& m_Frames;
+    };
+
+    // Records when it was attached, then the delta and idle time of its first frame.
+    struct Marker
+    {
+        Clock::time_point AttachedAt;
+        float FirstDelta = 0.0f;
+        double FirstIdle = 0.0;
+        std::atomic_bool Attached = false;
+        std::atomic_bool Updated = false;
+    };
+
+    class MarkerLayer : public RayEngine::Layer
+    {
+    public:
+        explicit MarkerLayer(Marker& marker) : RayEngine::Layer("IdleMarker"), m_Marker(marker) {}
+
+        void OnAttach() override
+        {
+            m_Marker.AttachedAt = Clock::now();
+            m_Marker.Attached.store(true);
+            m_Marker.Attached.notify_one();
+        }
+
+        void OnUpdate(float deltaTime) override
+        {
+            if (m_Marker.Updated.load())
+                return;
+            m_Marker.FirstDelta = deltaTime;
+            m_Marker.FirstIdle = RayEngine::Application::GetInstance().GetTime().GetIdleSeconds();
+            m_Marker.Updated.store(true);
+            m_Marker.Updated.notify_one();
+        }
+
+    private:
+        Marker& m_Marker;
+    };
+
+    struct TaskLatencies
+    {
+        std::vector<double> Timer;      // lateness of a 10 ms Delay()
+        std::vector<double> Background; // RunInBackground body finished -> task resumed
+        std::vector<double> Read;       // AwaitRead of 4 KiB from a cached file, whole await
+        std::atomic_bool Done = false;
+    };
+
+    inline RayEngine::Task<> MeasureTasks(RayEngine::IOService& io, const RayEngine::FileHandle& file, TaskLatencies& out)
+    {
+        std::vector<std::byte> buffer(4096);
+        for (int i = 0; i < samples; ++i)
+        {
+            const auto delayed = Clock::now();
+            co_await RayEngine::Delay(0.01);
+            out.Timer.push_back(Microseconds(Clock::now() - delayed - std::chrono::milliseconds(10)));
+
+            Clock::time_point finished;
+            co_await RayEngine::RunInBackground([&finished] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                finished = Clock::now();
+            });
+            out.Background.push_back(Microseconds(Clock::now() - finished));
+
+            const auto reading = Clock::now();
+            (void)co_await io.AwaitRead(file, 4096ull * static_cast<std::uint64_t>(i % 16), buffer);
+            out.Read.push_back(Microseconds(Clock::now() - reading));
+        }
+        out.Done.store(true);
+        out.Done.notify_one();
+    }
+
+    class TaskLauncherLayer : public RayEngine::Layer
+    {
+    public:
+        TaskLauncherLayer(const RayEngine::FileHandle& file, TaskLatencies& out) : RayEngine::Layer("IdleTasks"), m_File(file), m_Out(out) {}
+
+        void OnAttach() override
+        {
+            auto& app = RayEngine::Application::GetInstance();
+            app.Spawn(MeasureTasks(app.GetIOService(), m_File, m_Out));
+        }
+
+    private:
+        const RayEngine::FileHandle& m_File;
+        TaskLatencies& m_Out;
+    };
+
+    // Runs one instance on its own thread and measures it from this one.
+    inline void MeasureInstance(bool wakeOnWork, const RayEngine::FileHandle& file)
+    {
+        const char* mode = wakeOnWork ? "wake-on-work" : "polling";
+        RayEngine::ApplicationSpecification spec;
+        spec.Name = wakeOnWork ? "Wake" : "Poll";
+        spec.WorkerThreads = 1;
+        spec.WakeOnWork = wakeOnWork;
+        // Removed layers may run one more frame, so markers outlive the application.
+        std::vector<std::unique_ptr<Marker>> markers;
+        RayEngine::Application app(spec);
+        if (!app.Initialize())
+            return;
+
+        std::atomic<std::uint64_t> frames = 0;
+        app.PushLayer(std::make_unique<FrameCounterLayer>(frames));
+        std::thread runner([&app] { (void)app.Run(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        // 1) Idle: nothing to do for two seconds.
+        const double cpuBefore = CpuSeconds();
+        const std::uint64_t framesBefore = frames.load();
+        const auto idleStart = Clock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        const double idleSeconds = std::chrono::duration<double>(Clock::now() - idleStart).count();
+        const double cpuPercent = 100.0 * (CpuSeconds() - cpuBefore) / idleSeconds;
+        const double framesPerSecond = static_cast<double>(frames.load() - framesBefore) / idleSeconds;
+
+        // 2) Async layer push from another thread -> OnAttach.
+        std::vector<double> push;
+        for (int i = 0; i < samples; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            Marker& marker = *markers.emplace_back(std::make_unique<Marker>());
+            auto layer = std::make_unique<MarkerLayer>(marker);
+            RayEngine::Layer* raw = layer.get();
+            const auto requested = Clock::now();
+            app.PushLayerAsync(std::move(layer));
+            marker.Attached.wait(false);
+            push.push_back(Microseconds(marker.AttachedAt - requested));
+            marker.Updated.wait(false);
+            app.RemoveLayerAsync(raw);
+        }
+
+        // 3) Coroutine wake-ups: timers, background completions and file reads.
+        TaskLatencies tasks;
+        app.PushLayerAsync(std::make_unique<TaskLauncherLayer>(file, tasks));
+        tasks.Done.wait(false);
+
+        // 4) First frame after half a second of idling.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        Marker& marker = *markers.emplace_back(std::make_unique<Marker>());
+        app.PushLayerAsync(std::make_unique<MarkerLayer>(marker));
+        marker.Updated.wait(false);
+
+        // 5) Stop() -> Run() returns.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const auto stopping = Clock::now();
+        app.Stop();
+        runner.join();
+        const double stop = Microseconds(Clock::now() - stopping);
+
+        const Summary pushSummary = Summarize(push);
+        const Summary timer = Summarize(tasks.Timer);
+        const Summary background = Summarize(tasks.Background);
+        const Summary read = Summarize(tasks.Read);
+        const RayEngine::ApplicationIdleStats& idle = app.GetIdleStats();
+        RAY_CLIENT_INFO("IdleBench {:>12}: idle CPU {:5.2f}%, {:6.1f} frames/s while idle ({} I/O)", mode, cpuPercent, framesPerSecond,
+            app.GetIOService().GetBackendName());
+        RAY_CLIENT_INFO("IdleBench {:>12}: wake latency median/p99 us: push {:.0f}/{:.0f}, timer {:.0f}/{:.0f}, background {:.0f}/{:.0f}, "
+            "read {:.0f}/{:.0f}, stop {:.0f}", mode, pushSummary.Median, pushSummary.P99, timer.Median, timer.P99, background.Median,
+            background.P99, read.Median, read.P99, stop);
+        RAY_CLIENT_INFO("IdleBench {:>12}: first frame after 500 ms idle: delta {:.2f} ms, idle excluded {:.1f} ms; {} waits ({} woken), {:.2f} s blocked",
+            mode, marker.FirstDelta * 1000.0f, marker.FirstIdle * 1000.0, idle.Waits, idle.Signaled, idle.Seconds);
+    }
+}
+
+inline int RunIdleBenchmark()
+{
+    using namespace ExampleIdle;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "rayengine-idle-bench.bin";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const std::vector<char> data(64 * 1024, 'x');
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    {
+        const RayEngine::FileHandle file = RayEngine::FileHandle::OpenRead(path);
+        if (!file.IsOpen())
+            return -1;
+        MeasureInstance(false, file);
+        MeasureInstance(true, file);
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return 0;
+}
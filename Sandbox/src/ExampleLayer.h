@@ -1,6 +1,9 @@
 #pragma once
 #include <RayEngine.h>
 
+#include <chrono>
+#include <thread>
+
 using namespace RayEngine;
 
 class ExampleLayer : public Layer
@@ -0,0 +1,61 @@
+
+#pragma once
+
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/AllocationTracker.h"
+#include "RayEngine/Core/Scheduler.h"
+
+#include <cstdint>
+
+// Runs a steady-state workload (a coroutine that awaits every frame) and reports how much the
+// engine allocates per frame. Build with -DRAY_TRACK_ALLOCATIONS=ON to get non-zero numbers.
+class ExampleLayerAllocReport : public RayEngine::Layer
+{
+public:
+    static constexpr int reportEvery = 60;
+    static constexpr int totalFrames = 300;
+
+    ExampleLayerAllocReport() : RayEngine::Layer("ExampleAllocReport") {}
+
+    void OnAttach() override
+    {
+        auto& app = RayEngine::Application::GetInstance();
+        app.SetFrameAllocationBudget(0);
+        app.Spawn(Ticker());
+        if (!RayEngine::AllocationTracker::IsEnabled())
+            RAY_CLIENT_WARN("AllocReport: built without RAY_TRACK_ALLOCATIONS, all counters are zero");
+    }
+
+    void OnUpdate(float) override
+    {
+        // This layer's own per-frame work must not allocate.
+        {
+            RayEngine::NoAllocationScope noAlloc("ExampleAllocReport::OnUpdate", false);
+            m_Frame++;
+        }
+
+        if (m_Frame % reportEvery == 0)
+        {
+            const auto frame = RayEngine::AllocationTracker::GetLastFrame();
+            RAY_CLIENT_INFO("AllocReport: frame {} allocated {} time(s), {} bytes", m_Frame, frame.Allocations, frame.Bytes);
+        }
+
+        if (m_Frame == totalFrames)
+        {
+            auto& app = RayEngine::Application::GetInstance();
+            RAY_CLIENT_INFO("AllocReport: {} of {} frames exceeded a zero-allocation budget",
+                app.GetFramesOverAllocationBudget(), m_Frame);
+            app.Stop();
+        }
+    }
+
+private:
+    static RayEngine::Task<> Ticker()
+    {
+        for (;;)
+            co_await RayEngine::NextFrame();
+    }
+
+    std::uint64_t m_Frame = 0;
+};
@@ -0,0 +1,57 @@
+
+#pragma once
+
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/FramePool.h"
+#include "RayEngine/Core/Scheduler.h"
+
+#include <cstddef>
+
+// Measures scheduler overhead: spawns many tasks that only `co_await NextFrame()`,
+// so the time per resume is almost entirely queue management and coroutine switching.
+class ExampleLayerTaskBench : public RayEngine::Layer
+{
+public:
+    static constexpr std::size_t taskCount = 10'000;
+    static constexpr int framesPerTask = 100;
+
+    ExampleLayerTaskBench() : RayEngine::Layer("ExampleTaskBench") {}
+
+    void OnAttach() override
+    {
+        auto& app = RayEngine::Application::GetInstance();
+        app.GetScheduler().ResetStats();
+        for (std::size_t i = 0; i < taskCount; ++i)
+            app.Spawn(Spin(framesPerTask));
+        m_Started = true;
+    }
+
+    void OnUpdate(float) override
+    {
+        auto& app = RayEngine::Application::GetInstance();
+        auto& scheduler = app.GetScheduler();
+        if (!m_Started || scheduler.GetLiveTaskCount() != 0)
+            return;
+
+        const auto& stats = scheduler.GetStats();
+        const auto pool = RayEngine::FramePool::Get().GetStats();
+        RAY_CLIENT_INFO("TaskBench: {} tasks x {} frames, {} resumes over {} frames",
+            taskCount, framesPerTask, stats.Resumed, stats.Frames);
+        RAY_CLIENT_INFO("TaskBench: {:.1f} ns per resumed task", stats.AverageNanosecondsPerResume());
+        RAY_CLIENT_INFO("TaskBench: frame pool {} pooled / {} fallback allocations, {} KiB arenas",
+            pool.PooledAllocations, pool.FallbackAllocations, pool.ArenaBytes / 1024);
+
+        m_Started = false;
+        app.Stop();
+    }
+
+private:
+    static RayEngine::Task<> Spin(int frames)
+    {
+        for (int i = 0; i < frames; ++i)
+            co_await RayEngine::NextFrame();
+    }
+
+    bool m_Started = false;
+};
@@ -0,0 +1,64 @@
+
+#pragma once
+
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/Scheduler.h"
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+class ExampleChildLayerTask : public RayEngine::Layer
+{
+public:
+    ExampleChildLayerTask() : RayEngine::Layer("ExampleChildTask") {}
+    void OnAttach() override { RAY_CLIENT_INFO("ExampleChildTask attached"); }
+    void OnDetach() override { RAY_CLIENT_INFO("ExampleChildTask detached"); }
+    void OnUpdate(float) override { RAY_CLIENT_INFO("ExampleChildTask OnUpdate"); }
+};
+
+// Same flow as ExampleLayerAsync, written as a coroutine instead of boolean guards.
+class ExampleLayerTask : public RayEngine::Layer
+{
+public:
+    ExampleLayerTask() : RayEngine::Layer("ExampleTask") {}
+
+    void OnAttach() override
+    {
+        RAY_CLIENT_INFO("ExampleTask attached");
+        RayEngine::Application::GetInstance().Spawn(Script());
+    }
+    void OnDetach() override { RAY_CLIENT_INFO("ExampleTask detached"); }
+
+private:
+    static RayEngine::Task<long long> SumInBackground(int count)
+    {
+        co_return co_await RayEngine::RunInBackground([count]() {
+            std::vector<long long> values(static_cast<std::size_t>(count));
+            std::iota(values.begin(), values.end(), 1LL);
+            return std::accumulate(values.begin(), values.end(), 0LL);
+        });
+    }
+
+    RayEngine::Task<> Script()
+    {
+        auto& app = RayEngine::Application::GetInstance();
+
+        RAY_CLIENT_INFO("ExampleTask: co_await AwaitPushLayer(child)");
+        RayEngine::Layer* child = co_await app.AwaitPushLayer(std::make_unique<ExampleChildLayerTask>());
+        RAY_CLIENT_INFO("ExampleTask: child pushed ({})", child ? child->GetName() : std::string("nullptr"));
+
+        co_await RayEngine::NextFrame();
+        co_await RayEngine::Delay(0.25);
+
+        const long long sum = co_await SumInBackground(1'000'000);
+        RAY_CLIENT_INFO("ExampleTask: background sum = {}", sum);
+
+        auto popped = co_await app.AwaitPopLayer(child);
+        RAY_CLIENT_INFO("ExampleTask: popped '{}'", popped ? popped->GetName() : std::string("nullptr"));
+
+        RAY_CLIENT_INFO("ExampleTask: done, stopping application");
+        app.Stop();
+    }
+};
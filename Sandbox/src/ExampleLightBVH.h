@@ -0,0 +1,346 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/ParallelFor.h"
+#include "RayEngine/Geometry/Math.h"
+#include "RayEngine/Lighting/LightBVH.h"
+#include "RayEngine/Sampling/PCG.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+// Sandbox light-bench: a night-time city block lit by 40k emissive window and ceiling triangles
+// and 10k street lamps. Direct irradiance at points on the street is estimated by picking one
+// light per sample uniformly, by power, or through the LightBVH, and compared against the exact
+// (unoccluded) sum over all lights: error at equal sample count and at equal time, the cost of
+// one selection, the parallel build time, and refit versus rebuild after the lights move.
+namespace ExampleLightBVH
+{
+    struct Receiver
+    {
+        RayEngine::Vec3 Point;
+        RayEngine::Vec3 Normal;
+        double Reference = 0.0;
+    };
+
+    [[nodiscard]] inline float MeanEmission(const RayEngine::Light& light)
+    {
+        return (light.Emission.X + light.Emission.Y + light.Emission.Z) / 3.0f;
+    }
+
+    // Exact irradiance from one light: inverse square law for points, Lambert's polygon formula
+    // for triangles (clipped to the receiver's upper hemisphere).
+    [[nodiscard]] inline double ExactIrradiance(const RayEngine::Light& light, const Receiver& receiver)
+    {
+        using RayEngine::Vec3;
+        if (light.Type == RayEngine::LightType::Point)
+        {
+            const Vec3 d = light.Position - receiver.Point;
+            const double distanceSquared = RayEngine::Dot(d, d);
+            const double cosine = std::max(0.0f, RayEngine::Dot(receiver.Normal, d)) / std::sqrt(distanceSquared);
+            return MeanEmission(light) * cosine / distanceSquared;
+        }
+
+        const Vec3 lightNormal = RayEngine::Cross(light.Edge1, light.Edge2);
+        if (!light.TwoSided && RayEngine::Dot(lightNormal, receiver.Point - light.Position) <= 0.0f)
+            return 0.0;
+
+        const std::array<Vec3, 3> triangle{ light.Position - receiver.Point, light.Position + light.Edge1 - receiver.Point,
+            light.Position + light.Edge2 - receiver.Point };
+        std::array<Vec3, 4> polygon{};
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const Vec3& a = triangle[i];
+            const Vec3& b = triangle[(i + 1) % 3];
+            const float da = RayEngine::Dot(receiver.Normal, a);
+            const float db = RayEngine::Dot(receiver.Normal, b);
+            if (da >= 0.0f)
+                polygon[count++] = a;
+            if ((da >= 0.0f) != (db >= 0.0f))
+                polygon[count++] = a + (b - a) * (da / (da - db));
+        }
+        if (count < 3)
+            return 0.0;
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Vec3 a = RayEngine::Normalize(polygon[i]);
+            const Vec3 b = RayEngine::Normalize(polygon[(i + 1) % count]);
+            const Vec3 edgeNormal = RayEngine::Cross(a, b);
+            const float edgeLength = RayEngine::Length(edgeNormal);
+            if (edgeLength <= 0.0f)
+                continue;
+            const double angle = std::acos(std::clamp(static_cast<double>(RayEngine::Dot(a, b)), -1.0, 1.0));
+            sum += angle * RayEngine::Dot(receiver.Normal, edgeNormal) / edgeLength;
+        }
+        return 0.5 * MeanEmission(light) * std::abs(sum);
+    }
+
+    // One-sample estimate of a light's irradiance, dividing by the selection probability.
+    [[nodiscard]] inline double SampleIrradiance(const RayEngine::Light& light, const Receiver& receiver, float pmf, RayEngine::PCG32& rng)
+    {
+        using RayEngine::Vec3;
+        if (light.Type == RayEngine::LightType::Point)
+            return ExactIrradiance(light, receiver) / pmf;
+
+        // Uniform point on the triangle.
+        const float su = std::sqrt(rng.NextFloat());
+        const float b1 = 1.0f - su;
+        const float b2 = rng.NextFloat() * su;
+        const Vec3 point = light.Position + light.Edge1 * b1 + light.Edge2 * b2;
+        const Vec3 d = point - receiver.Point;
+        const float distanceSquared = RayEngine::Dot(d, d);
+        const float distance = std::sqrt(distanceSquared);
+        const Vec3 lightNormal = RayEngine::Normalize(RayEngine::Cross(light.Edge1, light.Edge2));
+        float cosLight = -RayEngine::Dot(lightNormal, d) / distance;
+        if (light.TwoSided)
+            cosLight = std::abs(cosLight);
+        const float cosReceiver = RayEngine::Dot(receiver.Normal, d) / distance;
+        if (cosLight <= 0.0f || cosReceiver <= 0.0f)
+            return 0.0;
+        return static_cast<double>(MeanEmission(light)) * cosLight * cosReceiver * light.GetArea() / (distanceSquared * pmf);
+    }
+
+    [[nodiscard]] inline std::vector<RayEngine::Light> MakeCity(std::uint32_t triangleCount, std::uint32_t lampCount, std::uint64_t seed)
+    {
+        using RayEngine::Vec3;
+        constexpr float citySize = 400.0f;
+        RayEngine::PCG32 rng(seed);
+        std::vector<RayEngine::Light> lights;
+        lights.reserve(triangleCount + lampCount);
+
+        for (std::uint32_t i = 0; i < triangleCount; ++i)
+        {
+            const Vec3 base{ rng.NextFloat() * citySize, rng.NextFloat() * citySize, 3.0f + rng.NextFloat() * 40.0f };
+            const float size = 0.3f + rng.NextFloat() * 0.7f;
+            // Brightness spans two orders of magnitude; a few shop signs are much brighter.
+            float radiance = 0.5f + 20.0f * rng.NextFloat() * rng.NextFloat();
+            if (rng.NextUInt(100) == 0)
+                radiance *= 50.0f;
+            const Vec3 colour{ radiance, radiance * (0.7f + 0.3f * rng.NextFloat()), radiance * (0.5f + 0.5f * rng.NextFloat()) };
+            if (i % 3 == 0)
+            {
+                // Ceiling panel facing down.
+                lights.push_back(RayEngine::Light::MakeTriangle(base, base + Vec3{ 0.0f, size, 0.0f }, base + Vec3{ size, 0.0f, 0.0f }, colour));
+            }
+            else
+            {
+                // Window facing one of the four horizontal directions.
+                const float angle = 0.5f * std::numbers::pi_v<float> * static_cast<float>(rng.NextUInt(4));
+                const Vec3 facing{ std::cos(angle), std::sin(angle), 0.0f };
+                const Vec3 side = RayEngine::Cross({ 0.0f, 0.0f, 1.0f }, facing);
+                lights.push_back(RayEngine::Light::MakeTriangle(base, base + side * size, base + Vec3{ 0.0f, 0.0f, size }, colour));
+            }
+        }
+
+        const auto grid = static_cast<std::uint32_t>(std::sqrt(static_cast<float>(lampCount)));
+        for (std::uint32_t i = 0; i < lampCount; ++i)
+        {
+            const float x = (static_cast<float>(i % grid) + 0.5f) * citySize / grid;
+            const float y = (static_cast<float>(i / grid % grid) + 0.5f) * citySize / grid;
+            const float intensity = 20.0f + 180.0f * rng.NextFloat();
+            lights.push_back(RayEngine::Light::MakePoint({ x, y, 6.0f }, { intensity, intensity * 0.8f, intensity * 0.5f }));
+        }
+        return lights;
+    }
+
+    // Power-proportional selection through a CDF, the usual many-light baseline.
+    class PowerSampler
+    {
+    public:
+        explicit PowerSampler(const std::vector<RayEngine::Light>& lights)
+        {
+            m_Cdf.reserve(lights.size());
+            double sum = 0.0;
+            for (const RayEngine::Light& light : lights)
+            {
+                sum += light.GetPower();
+                m_Cdf.push_back(static_cast<float>(sum));
+            }
+            m_Total = static_cast<float>(sum);
+        }
+
+        [[nodiscard]] RayEngine::SampledLight Sample(float u) const
+        {
+            const float target = u * m_Total;
+            const auto index = static_cast<std::uint32_t>(std::min<std::size_t>(
+                std::upper_bound(m_Cdf.begin(), m_Cdf.end(), target) - m_Cdf.begin(), m_Cdf.size() - 1));
+            const float power = m_Cdf[index] - (index > 0 ? m_Cdf[index - 1] : 0.0f);
+            return RayEngine::SampledLight{ index, power / m_Total };
+        }
+
+    private:
+        std::vector<float> m_Cdf;
+        float m_Total = 0.0f;
+    };
+
+    enum class Strategy
+    {
+        Uniform,
+        Power,
+        BVH
+    };
+
+    inline constexpr std::array<const char*, 3> strategyNames{ "uniform", "power", "light BVH" };
+
+    struct EstimateResult
+    {
+        double RelativeRmse = 0.0;
+        double NanosecondsPerSample = 0.0;
+    };
+
+    inline EstimateResult Estimate(Strategy strategy, const std::vector<RayEngine::Light>& lights, const PowerSampler& power,
+        const RayEngine::LightBVH& bvh, const std::vector<Receiver>& receivers, std::uint32_t samples)
+    {
+        double squaredError = 0.0;
+        double referenceSum = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0; r < receivers.size(); ++r)
+        {
+            const Receiver& receiver = receivers[r];
+            RayEngine::PCG32 rng(r, static_cast<std::uint64_t>(strategy));
+            double sum = 0.0;
+            for (std::uint32_t s = 0; s < samples; ++s)
+            {
+                const float u = rng.NextFloat();
+                RayEngine::SampledLight sampled;
+                if (strategy == Strategy::Uniform)
+                    sampled = { std::min(static_cast<std::uint32_t>(u * lights.size()), static_cast<std::uint32_t>(lights.size() - 1)), 1.0f / lights.size() };
+                else if (strategy == Strategy::Power)
+                    sampled = power.Sample(u);
+                else
+                    sampled = bvh.Sample(receiver.Point, receiver.Normal, u);
+                if (sampled.IsValid())
+                    sum += SampleIrradiance(lights[sampled.Index], receiver, sampled.Pmf, rng);
+            }
+            const double error = sum / samples - receiver.Reference;
+            squaredError += error * error;
+            referenceSum += receiver.Reference;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double meanReference = referenceSum / receivers.size();
+        return { std::sqrt(squaredError / receivers.size()) / meanReference, seconds * 1e9 / (static_cast<double>(receivers.size()) * samples) };
+    }
+
+    inline void ComputeReferences(const std::vector<RayEngine::Light>& lights, std::vector<Receiver>& receivers, RayEngine::ThreadPool& pool)
+    {
+        RayEngine::ParallelFor(&pool, receivers.size(), [&](std::size_t r) {
+            double sum = 0.0;
+            for (const RayEngine::Light& light : lights)
+                sum += ExactIrradiance(light, receivers[r]);
+            receivers[r].Reference = sum;
+        });
+    }
+}
+
+inline int RunLightBVHBenchmark()
+{
+    using namespace ExampleLightBVH;
+    constexpr std::uint32_t triangleCount = 40000;
+    constexpr std::uint32_t lampCount = 10000;
+    constexpr std::uint32_t receiverCount = 512;
+    constexpr std::uint32_t samplesPerReceiver = 64;
+    constexpr std::uint32_t selections = 1u << 20;
+
+    auto& pool = RayEngine::Application::GetInstance().GetThreadPool();
+    std::vector<RayEngine::Light> lights = MakeCity(triangleCount, lampCount, 7);
+
+    const auto timeMs = [](auto&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Build: serial, then on the pool.
+    const double serialBuildMs = timeMs([&] { RayEngine::LightBVH serial(lights); });
+    RayEngine::LightBVH bvh(lights, &pool);
+    const double parallelBuildMs = timeMs([&] { bvh.Rebuild(&pool); });
+    RAY_CLIENT_INFO("LightBench: {} lights ({} triangles, {} points), {} nodes, depth {}, {:.2f} MiB", lights.size(), triangleCount, lampCount,
+        bvh.GetNodes().size(), bvh.GetDepth(), bvh.GetMemoryBytes() / (1024.0 * 1024.0));
+    RAY_CLIENT_INFO("LightBench: build {:.1f} ms serial, {:.1f} ms on {} workers + caller", serialBuildMs, parallelBuildMs, pool.GetWorkerCount());
+
+    RayEngine::PCG32 rng(99);
+    std::vector<Receiver> receivers(receiverCount);
+    for (Receiver& receiver : receivers)
+        receiver = { { rng.NextFloat() * 400.0f, rng.NextFloat() * 400.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+    const double referenceMs = timeMs([&] { ComputeReferences(lights, receivers, pool); });
+    RAY_CLIENT_INFO("LightBench: exact irradiance at {} street points in {:.0f} ms", receiverCount, referenceMs);
+
+    // Sample() and Pmf() must agree, or MIS weights would be biased.
+    float worstPmfError = 0.0f;
+    for (std::uint32_t i = 0; i < 10000; ++i)
+    {
+        const Receiver& receiver = receivers[i % receiverCount];
+        const RayEngine::SampledLight sampled = bvh.Sample(receiver.Point, receiver.Normal, rng.NextFloat());
+        if (sampled.IsValid())
+            worstPmfError = std::max(worstPmfError, std::abs(bvh.Pmf(receiver.Point, receiver.Normal, sampled.Index) / sampled.Pmf - 1.0f));
+    }
+    RAY_CLIENT_INFO("LightBench: Sample/Pmf worst relative mismatch {:.2e}", worstPmfError);
+
+    // Cost of one selection alone.
+    const PowerSampler power(lights);
+    std::array<double, 3> selectionNs{};
+    for (std::size_t s = 0; s < selectionNs.size(); ++s)
+    {
+        RayEngine::PCG32 selectRng(5);
+        double sink = 0.0;
+        const double ms = timeMs([&] {
+            for (std::uint32_t i = 0; i < selections; ++i)
+            {
+                const Receiver& receiver = receivers[i % receiverCount];
+                const float u = selectRng.NextFloat();
+                if (s == 0)
+                    sink += static_cast<std::uint32_t>(u * lights.size());
+                else if (s == 1)
+                    sink += power.Sample(u).Pmf;
+                else
+                    sink += bvh.Sample(receiver.Point, receiver.Normal, u).Pmf;
+            }
+        });
+        selectionNs[s] = ms * 1e6 / selections;
+        if (sink < 0.0)
+            RAY_CLIENT_WARN("LightBench: unexpected sink {}", sink);
+    }
+
+    // Noise at equal sample count, and at the time the uniform estimate takes.
+    std::array<EstimateResult, 3> results{};
+    for (std::size_t s = 0; s < results.size(); ++s)
+        results[s] = Estimate(static_cast<Strategy>(s), lights, power, bvh, receivers, samplesPerReceiver);
+    for (std::size_t s = 0; s < results.size(); ++s)
+    {
+        const double equalTime = results[s].RelativeRmse * std::sqrt(results[s].NanosecondsPerSample / results[0].NanosecondsPerSample);
+        RAY_CLIENT_INFO("LightBench: {:>9}: select {:6.1f} ns, {:6.1f} ns/sample, rel. RMSE {:.4f} at {} spp, {:.4f} at equal time ({:.1f}x lower than uniform)",
+            strategyNames[s], selectionNs[s], results[s].NanosecondsPerSample, results[s].RelativeRmse, samplesPerReceiver, equalTime,
+            results[0].RelativeRmse / equalTime);
+    }
+
+    // Lights move between frames (vehicles, swaying lamps): every light drifts further from where
+    // the tree was built. Refit keeps the topology; rebuild starts over.
+    const std::vector<RayEngine::Light> original = lights;
+    std::vector<RayEngine::Vec3> directions(lights.size());
+    for (RayEngine::Vec3& direction : directions)
+        direction = { rng.NextFloat() - 0.5f, rng.NextFloat() - 0.5f, 0.0f };
+    for (const float drift : { 2.0f, 10.0f, 50.0f })
+    {
+        for (std::size_t i = 0; i < lights.size(); ++i)
+            lights[i].Position = original[i].Position + directions[i] * drift;
+        ComputeReferences(lights, receivers, pool);
+
+        const double refitMs = timeMs([&] { bvh.Refit(&pool); });
+        const EstimateResult refit = Estimate(Strategy::BVH, lights, power, bvh, receivers, samplesPerReceiver);
+        RayEngine::LightBVH rebuilt(lights);
+        const double rebuildMs = timeMs([&] { rebuilt.Rebuild(&pool); });
+        const EstimateResult fresh = Estimate(Strategy::BVH, lights, power, rebuilt, receivers, samplesPerReceiver);
+        RAY_CLIENT_INFO("LightBench: lights moved up to {:.0f} m: refit {:.2f} ms (rel. RMSE {:.4f}), rebuild {:.1f} ms (rel. RMSE {:.4f})",
+            drift * 0.5f * std::numbers::sqrt2_v<float>, refitMs, refit.RelativeRmse, rebuildMs, fresh.RelativeRmse);
+    }
+    return 0;
+}
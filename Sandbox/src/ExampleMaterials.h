@@ -0,0 +1,253 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/ParallelFor.h"
+#include "RayEngine/Geometry/BVH.h"
+#include "RayEngine/Lighting/LightBVH.h"
+#include "RayEngine/Render/PathIntegrator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+// Sandbox material-bench: a Cornell box with two tessellated spheres, path traced with the
+// integrator's specialized kernel (picked once per batch from the compile-time table) and with
+// the generic kernel that tests every lobe, light-type, roulette and NEE choice at run time.
+// Several material / light / setting combinations are rendered; each reports both timings and
+// checks that the two images are identical.
+namespace ExampleMaterials
+{
+    enum SceneMaterial : std::uint32_t
+    {
+        White,
+        Red,
+        Green,
+        Emitter,
+        SphereA,
+        SphereB,
+        MaterialCount
+    };
+
+    struct Scene
+    {
+        RayEngine::TriangleMesh Mesh;
+        std::vector<std::uint32_t> TriangleMaterials;
+        std::vector<RayEngine::Light> AreaLights; // the emitter triangles, for next-event estimation
+    };
+
+    // Appends a triangle whose front side, (v1-v0)x(v2-v0), faces `towards`.
+    inline void AddTriangle(Scene& scene, RayEngine::Vec3 v0, RayEngine::Vec3 v1, RayEngine::Vec3 v2, const RayEngine::Vec3& towards, std::uint32_t material)
+    {
+        if (RayEngine::Dot(RayEngine::Cross(v1 - v0, v2 - v0), towards) < 0.0f)
+            std::swap(v1, v2);
+        const auto first = static_cast<std::uint32_t>(scene.Mesh.Positions.size());
+        scene.Mesh.Positions.insert(scene.Mesh.Positions.end(), { v0, v1, v2 });
+        scene.Mesh.Indices.insert(scene.Mesh.Indices.end(), { first, first + 1, first + 2 });
+        scene.TriangleMaterials.push_back(material);
+    }
+
+    inline void AddQuad(Scene& scene, const RayEngine::Vec3& a, const RayEngine::Vec3& b, const RayEngine::Vec3& c, const RayEngine::Vec3& d,
+        const RayEngine::Vec3& normal, std::uint32_t material)
+    {
+        AddTriangle(scene, a, b, c, normal, material);
+        AddTriangle(scene, a, c, d, normal, material);
+    }
+
+    inline void AddSphere(Scene& scene, const RayEngine::Vec3& center, float radius, std::uint32_t stacks, std::uint32_t slices, std::uint32_t material)
+    {
+        const auto point = [&](std::uint32_t stack, std::uint32_t slice) {
+            const float theta = std::numbers::pi_v<float> * static_cast<float>(stack) / static_cast<float>(stacks);
+            const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(slice) / static_cast<float>(slices);
+            return center + RayEngine::Vec3{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) } * radius;
+        };
+        for (std::uint32_t stack = 0; stack < stacks; ++stack)
+        {
+            for (std::uint32_t slice = 0; slice < slices; ++slice)
+            {
+                const RayEngine::Vec3 a = point(stack, slice), b = point(stack + 1, slice), c = point(stack + 1, slice + 1), d = point(stack, slice + 1);
+                const RayEngine::Vec3 outwards = (a + c) * 0.5f - center;
+                if (stack + 1 < stacks)
+                    AddTriangle(scene, a, b, c, outwards, material);
+                if (stack > 0)
+                    AddTriangle(scene, a, c, d, outwards, material);
+            }
+        }
+    }
+
+    inline Scene MakeCornellBox(const RayEngine::Vec3& lightRadiance)
+    {
+        using RayEngine::Vec3;
+        Scene scene;
+        AddQuad(scene, { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 }, { 0, 1, 0 }, White);   // floor
+        AddQuad(scene, { 0, 1, 0 }, { 1, 1, 0 }, { 1, 1, 1 }, { 0, 1, 1 }, { 0, -1, 0 }, White);  // ceiling
+        AddQuad(scene, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 }, { 0, 0, -1 }, White);  // back
+        AddQuad(scene, { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 }, { 1, 0, 0 }, Red);     // left
+        AddQuad(scene, { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1, 1 }, { 1, 1, 0 }, { -1, 0, 0 }, Green);  // right
+        AddSphere(scene, { 0.3f, 0.2f, 0.6f }, 0.2f, 32, 64, SphereA);
+        AddSphere(scene, { 0.72f, 0.18f, 0.35f }, 0.18f, 32, 64, SphereB);
+
+        const auto lightTriangles = static_cast<std::uint32_t>(scene.TriangleMaterials.size());
+        AddQuad(scene, { 0.38f, 0.999f, 0.38f }, { 0.62f, 0.999f, 0.38f }, { 0.62f, 0.999f, 0.62f }, { 0.38f, 0.999f, 0.62f }, { 0, -1, 0 }, Emitter);
+        for (std::uint32_t triangle = lightTriangles; triangle < scene.TriangleMaterials.size(); ++triangle)
+        {
+            const std::uint32_t* corner = scene.Mesh.Indices.data() + 3 * static_cast<std::size_t>(triangle);
+            scene.AreaLights.push_back(RayEngine::Light::MakeTriangle(scene.Mesh.Positions[corner[0]], scene.Mesh.Positions[corner[1]],
+                scene.Mesh.Positions[corner[2]], lightRadiance));
+        }
+        return scene;
+    }
+
+    struct Configuration
+    {
+        const char* Name;
+        RayEngine::Material SphereA;
+        RayEngine::Material SphereB;
+        bool PointLights;
+        RayEngine::IntegratorSettings Settings;
+    };
+
+    inline RayEngine::Material MakeGlossy(const RayEngine::Vec3& diffuse, const RayEngine::Vec3& glossy, float exponent)
+    {
+        RayEngine::Material material = RayEngine::Material::MakeDiffuse(diffuse);
+        material.Glossy = glossy;
+        material.GlossyExponent = exponent;
+        return material;
+    }
+
+    inline RayEngine::Material MakeMirror(const RayEngine::Vec3& reflectance)
+    {
+        RayEngine::Material material;
+        material.Specular = reflectance;
+        return material;
+    }
+
+    // One path per pixel and sample, in rows.
+    inline std::vector<RayEngine::PathStart> MakeCameraPaths(std::uint32_t width, std::uint32_t height, std::uint32_t samples)
+    {
+        const RayEngine::Vec3 eye{ 0.5f, 0.5f, -1.35f };
+        const float scale = 0.7f / static_cast<float>(height);
+        std::vector<RayEngine::PathStart> paths;
+        paths.reserve(static_cast<std::size_t>(width) * height * samples);
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t sample = 0; sample < samples; ++sample)
+            {
+                for (std::uint32_t x = 0; x < width; ++x)
+                {
+                    // Fixed sub-pixel jitter pattern, so the camera consumes no sampler dimensions.
+                    const float jitterX = (static_cast<float>(sample % 2) + 0.5f) * 0.5f;
+                    const float jitterY = (static_cast<float>(sample / 2 % 2) + 0.5f) * 0.5f;
+                    const RayEngine::Vec3 direction{ (static_cast<float>(x) + jitterX - 0.5f * static_cast<float>(width)) * scale,
+                        (0.5f * static_cast<float>(height) - static_cast<float>(y) - jitterY) * scale, 1.0f };
+                    paths.push_back({ { eye, RayEngine::Normalize(direction) }, x, y, sample });
+                }
+            }
+        }
+        return paths;
+    }
+}
+
+inline int RunMaterialBenchmark()
+{
+    using namespace ExampleMaterials;
+    using RayEngine::Vec3;
+    constexpr std::uint32_t width = 160;
+    constexpr std::uint32_t height = 160;
+    constexpr std::uint32_t samples = 4;
+    constexpr int repeats = 3;
+
+    auto& pool = RayEngine::Application::GetInstance().GetThreadPool();
+    const Scene scene = MakeCornellBox({ 17.0f, 12.0f, 4.0f });
+    const RayEngine::BVH bvh(scene.Mesh);
+    const std::vector<RayEngine::PathStart> paths = MakeCameraPaths(width, height, samples);
+    const std::size_t rowPaths = static_cast<std::size_t>(width) * samples;
+    RAY_CLIENT_INFO("MaterialBench: Cornell box, {} triangles, {}x{} at {} spp, {} path kernels compiled", scene.Mesh.GetTriangleCount(), width,
+        height, samples, RayEngine::PathVariant::count);
+
+    RayEngine::IntegratorSettings noRoulette;
+    noRoulette.RussianRoulette = false;
+    noRoulette.MaxDepth = 5;
+    RayEngine::IntegratorSettings bruteForce;
+    bruteForce.NextEventEstimation = false;
+    const Vec3 grey{ 0.75f, 0.75f, 0.75f };
+    const Configuration configurations[] = {
+        { "diffuse, area light, NEE + RR", RayEngine::Material::MakeDiffuse(grey), RayEngine::Material::MakeDiffuse({ 0.3f, 0.4f, 0.75f }), false, {} },
+        { "diffuse, no NEE", RayEngine::Material::MakeDiffuse(grey), RayEngine::Material::MakeDiffuse({ 0.3f, 0.4f, 0.75f }), false, bruteForce },
+        { "diffuse + glossy, no RR", MakeGlossy({ 0.2f, 0.2f, 0.2f }, { 0.6f, 0.6f, 0.6f }, 80.0f), MakeGlossy({}, { 0.8f, 0.7f, 0.4f }, 400.0f), false, noRoulette },
+        { "all lobes, area + point lights", MakeGlossy({ 0.2f, 0.2f, 0.2f }, { 0.6f, 0.6f, 0.6f }, 80.0f), MakeMirror({ 0.9f, 0.9f, 0.9f }), true, {} },
+    };
+
+    int result = 0;
+    for (const Configuration& configuration : configurations)
+    {
+        std::vector<RayEngine::Material> materials(MaterialCount);
+        materials[White] = RayEngine::Material::MakeDiffuse(grey);
+        materials[Red] = RayEngine::Material::MakeDiffuse({ 0.63f, 0.07f, 0.05f });
+        materials[Green] = RayEngine::Material::MakeDiffuse({ 0.14f, 0.45f, 0.09f });
+        materials[Emitter] = RayEngine::Material::MakeEmissive(scene.AreaLights.front().Emission);
+        materials[SphereA] = configuration.SphereA;
+        materials[SphereB] = configuration.SphereB;
+
+        std::vector<RayEngine::Light> lights = scene.AreaLights;
+        if (configuration.PointLights)
+        {
+            lights.push_back(RayEngine::Light::MakePoint({ 0.15f, 0.85f, 0.2f }, { 0.15f, 0.1f, 0.05f }));
+            lights.push_back(RayEngine::Light::MakePoint({ 0.85f, 0.6f, 0.15f }, { 0.05f, 0.08f, 0.15f }));
+        }
+        const RayEngine::LightBVH lightBVH(lights);
+
+        RayEngine::PathScene pathScene;
+        pathScene.Geometry = &bvh;
+        pathScene.TriangleMaterials = scene.TriangleMaterials;
+        pathScene.Materials = materials;
+        pathScene.Lights = &lightBVH;
+        const RayEngine::PathIntegrator integrator(pathScene, configuration.Settings);
+
+        // One batch per image row; each batch gets its own sampler.
+        const auto render = [&](bool specialized, std::vector<Vec3>& radiance) {
+            radiance.resize(paths.size());
+            const auto start = std::chrono::steady_clock::now();
+            RayEngine::ParallelFor(&pool, height, [&](std::size_t row) {
+                RayEngine::Sampler sampler(RayEngine::SamplerType::SobolOwen, 1);
+                const std::span<const RayEngine::PathStart> batch(paths.data() + row * rowPaths, rowPaths);
+                const std::span<Vec3> out(radiance.data() + row * rowPaths, rowPaths);
+                if (specialized)
+                    integrator.Estimate(batch, out, sampler);
+                else
+                    integrator.EstimateGeneric(batch, out, sampler);
+            });
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        // Best of a few interleaved runs, so both paths see the same machine state.
+        std::vector<Vec3> generic, specialized;
+        double genericMs = 1e30, specializedMs = 1e30;
+        for (int repeat = 0; repeat < repeats; ++repeat)
+        {
+            genericMs = std::min(genericMs, render(false, generic));
+            specializedMs = std::min(specializedMs, render(true, specialized));
+        }
+
+        std::size_t mismatches = 0;
+        double mean = 0.0;
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            mismatches += generic[i].X != specialized[i].X || generic[i].Y != specialized[i].Y || generic[i].Z != specialized[i].Z;
+            mean += (specialized[i].X + specialized[i].Y + specialized[i].Z) / 3.0;
+        }
+        if (mismatches != 0)
+            result = -1;
+
+        const RayEngine::PathVariant& variant = integrator.GetVariant();
+        RAY_CLIENT_INFO("MaterialBench: {:<31} kernel {:3} (lobes {:#x}, lights {:#x}, RR {:d}, NEE {:d}): generic {:6.0f} ms, specialized {:6.0f} ms "
+            "({:.2f}x, {:.0f} ns/path), mean radiance {:.4f}, {} mismatching paths",
+            configuration.Name, variant.GetIndex(), variant.Lobes, variant.LightTypes, variant.RussianRoulette, variant.NextEventEstimation, genericMs,
+            specializedMs, genericMs / specializedMs, specializedMs * 1e6 / static_cast<double>(paths.size()), mean / static_cast<double>(paths.size()),
+            mismatches);
+    }
+    return result;
+}
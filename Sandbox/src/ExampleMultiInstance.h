@@ -0,0 +1,80 @@
+
+#pragma once
+
+#include "RayEngine/Core/Layer.h"
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/SharedAssets.h"
+
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A "job" layer: reads a shared, read-only table and stops its own Application after N frames.
+class ExampleJobLayer : public RayEngine::Layer
+{
+public:
+    static constexpr int jobFrames = 50;
+
+    ExampleJobLayer() : RayEngine::Layer("ExampleJob") {}
+
+    void OnAttach() override
+    {
+        // Every instance asks for the same key; only the first one builds the table.
+        m_Table = RayEngine::SharedAssets::GetOrLoad<std::vector<float>>("example/table", []() {
+            RAY_CLIENT_INFO("building shared table");
+            auto table = std::make_shared<std::vector<float>>(1 << 20);
+            std::iota(table->begin(), table->end(), 0.0f);
+            return table;
+        });
+        RAY_CLIENT_INFO("ExampleJob attached (shared table at {})", static_cast<const void*>(m_Table.get()));
+    }
+
+    void OnUpdate(float) override
+    {
+        m_Sum += (*m_Table)[static_cast<std::size_t>(m_Frame) * 997 % m_Table->size()];
+        if (++m_Frame == jobFrames)
+        {
+            // GetInstance() resolves to the Application running this layer, not a global one.
+            RAY_CLIENT_INFO("ExampleJob finished after {} frames (checksum {})", m_Frame, m_Sum);
+            RayEngine::Application::GetInstance().Stop();
+        }
+    }
+
+private:
+    std::shared_ptr<const std::vector<float>> m_Table;
+    int m_Frame = 0;
+    double m_Sum = 0.0;
+};
+
+// Runs `count` independent engine instances on their own threads and waits for all of them.
+inline int RunMultiInstanceExample(int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        threads.emplace_back([i]() {
+            RayEngine::ApplicationSpecification spec;
+            spec.Name = "Job" + std::to_string(i);
+            spec.WorkerThreads = 1;
+
+            RayEngine::Application app(spec);
+            if (!app.Initialize())
+                return;
+            app.PushLayer(std::make_unique<ExampleJobLayer>());
+            (void)app.Run();
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    RAY_CLIENT_INFO("MultiInstance: {} instances x {} frames finished in {:.3f} s", count, ExampleJobLayer::jobFrames, seconds);
+    return 0;
+}
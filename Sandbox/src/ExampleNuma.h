@@ -0,0 +1,116 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/NumaMemory.h"
+#include "RayEngine/Core/ThreadPool.h"
+#include "RayEngine/Core/Topology.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Sandbox numa-bench: prints the detected topology, then for every affinity policy on a simulated
+// two-node topology (and the real one) streams over per-tile buffers that were first-touched by
+// their owning worker, versus the same tiles first-touched by the main thread. Reports bandwidth,
+// per-node job / busy / remote-job counters and where the kernel actually put the pages.
+// On a single-node machine the two layouts should match; the point there is that every policy and
+// the per-node bookkeeping still run.
+inline int RunNumaBenchmark()
+{
+    constexpr std::size_t tileCount = 64;
+    constexpr std::size_t tileBytes = 2 * 1024 * 1024;
+    constexpr int passes = 8;
+
+    const RayEngine::CpuTopology real = RayEngine::CpuTopology::Detect();
+    const RayEngine::CpuTopology simulated = RayEngine::CpuTopology::Simulate(2);
+    RAY_CLIENT_INFO("NumaBench: detected topology ({} node(s), {} cpu(s))", real.GetNodeCount(), real.GetCpuCount());
+    for (const auto& node : real.GetNodes())
+        RAY_CLIENT_INFO("NumaBench:   node {}: {} cpu(s), {} MiB", node.Id, node.Cpus.size(), node.MemoryBytes >> 20);
+
+    // Every worker sums the tiles it owns; returns GB/s over all passes.
+    const auto stream = [&](RayEngine::ThreadPool& pool, const std::vector<std::span<std::byte>>& tiles) {
+        const std::size_t workers = pool.GetWorkerCount();
+        std::vector<std::uint64_t> sums(workers * 8, 0); // 64 bytes apart per worker
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            pool.RunOnEachWorker([&](std::size_t worker) {
+                std::uint64_t sum = 0;
+                for (std::size_t tile = worker; tile < tiles.size(); tile += workers)
+                {
+                    const std::span<std::byte> bytes = tiles[tile];
+                    for (std::size_t offset = 0; offset + sizeof(std::uint64_t) <= bytes.size(); offset += sizeof(std::uint64_t))
+                    {
+                        std::uint64_t value;
+                        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+                        sum += value;
+                    }
+                    bytes[pass % bytes.size()] = static_cast<std::byte>(sum); // keep the loop honest
+                }
+                sums[worker * 8] += sum;
+            });
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(tileCount * tileBytes) * passes / seconds / 1e9;
+    };
+
+    const std::size_t workerCount = std::max<std::size_t>(2, RayEngine::Application::GetInstance().GetThreadPool().GetWorkerCount());
+    for (const RayEngine::CpuTopology* topology : { &simulated, &real })
+    {
+        RAY_CLIENT_INFO("NumaBench: --- {} topology, {} node(s), {} workers ---", topology->IsSimulated() ? "simulated" : "detected",
+            topology->GetNodeCount(), workerCount);
+        for (RayEngine::AffinityPolicy policy : { RayEngine::AffinityPolicy::None, RayEngine::AffinityPolicy::Compact,
+                 RayEngine::AffinityPolicy::Scatter, RayEngine::AffinityPolicy::NodeLocal })
+        {
+            RayEngine::ThreadPool pool(workerCount, RayEngine::ThreadPlacement{ topology, policy });
+
+            // Per-tile buffers first-touched by their owning worker.
+            const RayEngine::WorkerBufferSet local(pool, tileCount, tileBytes);
+            std::vector<std::span<std::byte>> localTiles;
+            for (std::size_t i = 0; i < local.GetCount(); ++i)
+                localTiles.push_back(local.Get(i));
+
+            // The same layout, all pages first-touched by the main thread.
+            std::vector<RayEngine::FirstTouchBuffer> central;
+            std::vector<std::span<std::byte>> centralTiles;
+            for (std::size_t i = 0; i < tileCount; ++i)
+            {
+                central.emplace_back(tileBytes).Touch();
+                centralTiles.push_back(central.back().GetBytes());
+            }
+
+            const double centralGBs = stream(pool, centralTiles);
+            pool.ResetStats();
+            const double localGBs = stream(pool, localTiles);
+
+            RAY_CLIENT_INFO("NumaBench: {:<9} first-touch per tile {:6.2f} GB/s, main-thread touched {:6.2f} GB/s ({:.2f}x)",
+                RayEngine::ToString(policy), localGBs, centralGBs, localGBs / centralGBs);
+            for (const RayEngine::ThreadPoolNodeStats& node : pool.GetNodeStats())
+            {
+                RAY_CLIENT_INFO("NumaBench:   node {}: {} worker(s), {} job(s), busy {:.1f} ms, {} remote job(s)",
+                    node.Node, node.Workers, node.Jobs, node.BusyNanoseconds / 1e6, node.RemoteJobs);
+            }
+
+            // Physical placement is only checkable against the real topology.
+            if (!topology->IsSimulated())
+            {
+                const std::vector<std::size_t> bytes = local.GetBytesPerNode(topology->GetNodeCount());
+                std::size_t onIntendedNode = 0;
+                for (std::size_t i = 0; i < local.GetCount(); ++i)
+                {
+                    const std::uint32_t node = RayEngine::QueryMemoryNode(local.Get(i).data());
+                    onIntendedNode += node != RayEngine::CpuTopology::unknownNode
+                        && topology->GetNodes()[local.GetIntendedNode(i)].Id == node;
+                }
+                RAY_CLIENT_INFO("NumaBench:   {}/{} tile(s) resident on their owner's node ({} MiB on unknown node)",
+                    onIntendedNode, local.GetCount(), bytes.back() >> 20);
+            }
+        }
+    }
+    return 0;
+}
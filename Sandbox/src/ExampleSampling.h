@@ -0,0 +1,113 @@
+#pragma once
+
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Sampling/Sampler.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+// Sandbox sampling-bench: per-pixel Monte Carlo estimates of integrands with known values,
+// RMSE across pixels versus samples per pixel for each sampler, and how many samples each one
+// needs to match the noise of the random sampler at the highest sample count.
+inline int RunSamplingBenchmark()
+{
+    constexpr std::uint32_t imageSize = 64;
+    constexpr std::uint32_t maxSamples = 256;
+    constexpr std::uint32_t checkpoints = 9; // 1, 2, 4, ... 256 spp
+    constexpr std::uint32_t seed = 1234;
+
+    struct Integrand
+    {
+        const char* Name;
+        double Reference;
+        double (*Evaluate)(RayEngine::Sampler&);
+    };
+    const std::array<Integrand, 2> integrands{ {
+        // Pixel footprint against an edge: discontinuous 2D, like geometry edges in a render.
+        { "2D disk", std::numbers::pi * 0.4 * 0.4, [](RayEngine::Sampler& sampler) {
+            const RayEngine::Vec2 p = sampler.Get2D();
+            return (p.X - 0.5) * (p.X - 0.5) + (p.Y - 0.5) * (p.Y - 0.5) < 0.16 ? 1.0 : 0.0;
+        } },
+        // Smooth 6D product spanning two padded Sobol sets, like lens + light + BSDF dimensions.
+        { "6D smooth", 1.0, [](RayEngine::Sampler& sampler) {
+            double value = 1.0;
+            for (int i = 0; i < 6; ++i)
+                value *= 2.0 * sampler.Get1D();
+            return value;
+        } },
+    } };
+
+    constexpr std::array<RayEngine::SamplerType, 3> types{ RayEngine::SamplerType::Random, RayEngine::SamplerType::SobolOwen,
+        RayEngine::SamplerType::BlueNoiseSobol };
+
+    // Warm the blue-noise table outside the timings.
+    const auto tableStart = std::chrono::steady_clock::now();
+    (void)RayEngine::BlueNoise::Get();
+    RAY_CLIENT_INFO("SamplingBench: {}x{} blue-noise table built in {:.1f} ms", RayEngine::BlueNoise::size, RayEngine::BlueNoise::size,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tableStart).count());
+
+    for (const Integrand& integrand : integrands)
+    {
+        std::array<std::array<double, checkpoints>, types.size()> rmse{};
+        std::array<double, types.size()> nanosecondsPerSample{};
+        for (std::size_t t = 0; t < types.size(); ++t)
+        {
+            std::array<double, checkpoints> squaredError{};
+            RayEngine::Sampler sampler(types[t], seed);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint32_t y = 0; y < imageSize; ++y)
+            {
+                for (std::uint32_t x = 0; x < imageSize; ++x)
+                {
+                    double sum = 0.0;
+                    for (std::uint32_t s = 0, checkpoint = 0; s < maxSamples; ++s)
+                    {
+                        sampler.StartPixelSample(x, y, s);
+                        sum += integrand.Evaluate(sampler);
+                        if (((s + 1) & s) == 0) // s + 1 is a power of two
+                        {
+                            const double error = sum / (s + 1) - integrand.Reference;
+                            squaredError[checkpoint++] += error * error;
+                        }
+                    }
+                }
+            }
+            nanosecondsPerSample[t] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                / (static_cast<double>(imageSize) * imageSize * maxSamples);
+            for (std::uint32_t c = 0; c < checkpoints; ++c)
+                rmse[t][c] = std::sqrt(squaredError[c] / (imageSize * imageSize));
+        }
+
+        RAY_CLIENT_INFO("SamplingBench: {} (RMSE over {} pixels)", integrand.Name, imageSize * imageSize);
+        RAY_CLIENT_INFO("SamplingBench:   {:>5} {:>12} {:>12} {:>14}", "spp", ToString(types[0]), ToString(types[1]), ToString(types[2]));
+        for (std::uint32_t c = 0; c < checkpoints; ++c)
+            RAY_CLIENT_INFO("SamplingBench:   {:>5} {:>12.6f} {:>12.6f} {:>14.6f}", 1u << c, rmse[0][c], rmse[1][c], rmse[2][c]);
+
+        // Samples needed to reach the random sampler's error at maxSamples, interpolated log-log.
+        const double target = rmse[0][checkpoints - 1];
+        for (std::size_t t = 0; t < types.size(); ++t)
+        {
+            double needed = maxSamples;
+            for (std::uint32_t c = 0; c < checkpoints; ++c)
+            {
+                if (rmse[t][c] > target)
+                    continue;
+                needed = 1u << c;
+                if (c > 0)
+                {
+                    const double slope = std::log2(rmse[t][c] / rmse[t][c - 1]);
+                    if (slope < 0.0)
+                        needed = std::exp2((c - 1) + std::log2(target / rmse[t][c - 1]) / slope);
+                }
+                break;
+            }
+            RAY_CLIENT_INFO("SamplingBench:   {:<14} reaches RMSE {:.6f} at ~{:.1f} spp ({:.1f}x fewer samples), {:.1f} ns/sample",
+                ToString(types[t]), target, needed, maxSamples / needed, nanosecondsPerSample[t]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "ExampleBVHCompression.h"
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Core/Log.h"
+#include "RayEngine/Core/ParallelFor.h"
+#include "RayEngine/Geometry/BVH.h"
+#include "RayEngine/Geometry/StreamingGeometry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Sandbox stream-bench: a 4.5M-triangle terrain written as a cluster file and rendered (camera
+// rays, then shadow rays towards the sun) through StreamingGeometry with the whole file in budget
+// and with a budget several times smaller than the file, starting from a cold page cache.
+// Reports frame time, bytes read, loads, evictions and deferred rays against an in-memory BVH,
+// and checks that every ray reports the same hit distance.
+namespace ExampleStreaming
+{
+    // Best effort: drop the file from the page cache so the first frame really reads from disk.
+    inline void DropPageCache(const std::filesystem::path& path)
+    {
+#ifdef __linux__
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+#else
+        (void)path;
+#endif
+    }
+
+    inline std::vector<RayEngine::Ray> MakeCameraRays(const RayEngine::Vec3& eye, const RayEngine::Vec3& target, std::uint32_t width, std::uint32_t height)
+    {
+        const RayEngine::Vec3 forward = RayEngine::Normalize(target - eye);
+        const RayEngine::Vec3 right = RayEngine::Normalize(RayEngine::Cross({ 0.0f, 1.0f, 0.0f }, forward));
+        const RayEngine::Vec3 up = RayEngine::Cross(forward, right);
+        const float focal = 0.8f * static_cast<float>(width);
+        std::vector<RayEngine::Ray> rays;
+        rays.reserve(static_cast<std::size_t>(width) * height);
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                const float px = static_cast<float>(x) + 0.5f - 0.5f * static_cast<float>(width);
+                const float py = 0.5f * static_cast<float>(height) - static_cast<float>(y) - 0.5f;
+                rays.push_back({ eye, RayEngine::Normalize(forward * focal + right * px + up * py) });
+            }
+        }
+        return rays;
+    }
+
+    // One ray towards the sun from every camera hit.
+    inline std::vector<RayEngine::Ray> MakeShadowRays(std::span<const RayEngine::Ray> cameraRays, std::span<const RayEngine::Hit> hits)
+    {
+        const RayEngine::Vec3 sun = RayEngine::Normalize({ -0.5f, 0.35f, -0.4f });
+        std::vector<RayEngine::Ray> rays;
+        rays.reserve(cameraRays.size());
+        for (std::size_t i = 0; i < cameraRays.size(); ++i)
+        {
+            if (hits[i].IsHit())
+                rays.push_back({ cameraRays[i].Origin + cameraRays[i].Direction * hits[i].T, sun, 1e-4f });
+        }
+        return rays;
+    }
+}
+
+inline int RunStreamingBenchmark()
+{
+    using namespace ExampleStreaming;
+    constexpr std::uint32_t gridSize = 1500;
+    constexpr std::uint32_t width = 960;
+    constexpr std::uint32_t height = 540;
+
+    auto& app = RayEngine::Application::GetInstance();
+    RayEngine::ThreadPool& pool = app.GetThreadPool();
+    RayEngine::IOService& io = app.GetIOService();
+
+    const auto timed = [](auto&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "rayengine-stream-bench.rcl";
+    std::vector<RayEngine::Ray> cameraRays;
+    std::vector<RayEngine::Hit> referenceCamera, referenceShadow;
+    double referenceSeconds = 0.0;
+    {
+        // The mesh and its in-memory BVH only exist to write the file and produce reference hits.
+        const RayEngine::TriangleMesh mesh = MakeExampleTerrain(gridSize);
+        const double writeSeconds = timed([&] { (void)RayEngine::WriteClusterFile(mesh, path); });
+        const RayEngine::BVH bvh(mesh);
+        RAY_CLIENT_INFO("StreamBench: {} triangles, in-memory BVH {:.0f} MiB, cluster file {:.0f} MiB written in {:.1f} s",
+            mesh.GetTriangleCount(), bvh.GetMemoryBytes() / (1024.0 * 1024.0), std::filesystem::file_size(path) / (1024.0 * 1024.0), writeSeconds);
+
+        cameraRays = MakeCameraRays({ 0.02f, 0.14f, 0.02f }, { 0.7f, -0.05f, 0.7f }, width, height);
+        referenceCamera.resize(cameraRays.size());
+        std::vector<RayEngine::Ray> shadowRays;
+        referenceSeconds = timed([&] {
+            RayEngine::ParallelFor(&pool, cameraRays.size() / width, [&](std::size_t row) {
+                for (std::size_t i = row * width; i < (row + 1) * width; ++i)
+                    referenceCamera[i] = bvh.Intersect(cameraRays[i]);
+            });
+            shadowRays = MakeShadowRays(cameraRays, referenceCamera);
+            referenceShadow.resize(shadowRays.size());
+            RayEngine::ParallelFor(&pool, (shadowRays.size() + width - 1) / width, [&](std::size_t row) {
+                for (std::size_t i = row * width; i < std::min(shadowRays.size(), (row + 1) * width); ++i)
+                    referenceShadow[i] = bvh.Intersect(shadowRays[i]);
+            });
+        });
+        RAY_CLIENT_INFO("StreamBench: in-memory BVH frame ({} camera + {} shadow rays) {:.0f} ms", cameraRays.size(), shadowRays.size(),
+            referenceSeconds * 1000.0);
+    }
+
+    const std::uint64_t fileBytes = std::filesystem::file_size(path);
+    int result = 0;
+    for (const std::uint64_t budget : { fileBytes, fileBytes / 4, fileBytes / 8 })
+    {
+        RayEngine::StreamingGeometrySpec spec;
+        spec.MemoryBudgetBytes = budget;
+        auto geometry = RayEngine::StreamingGeometry::Open(path, io, spec);
+        if (!geometry)
+            return -1;
+
+        for (const char* frame : { "cold", "warm" })
+        {
+            DropPageCache(path);
+            geometry->ResetCounters();
+            std::vector<RayEngine::Hit> cameraHits(cameraRays.size()), shadowHits;
+            std::size_t mismatches = 0;
+            const double seconds = timed([&] {
+                geometry->Trace(cameraRays, cameraHits, &pool);
+                const std::vector<RayEngine::Ray> shadowRays = MakeShadowRays(cameraRays, cameraHits);
+                shadowHits.resize(shadowRays.size());
+                geometry->Trace(shadowRays, shadowHits, &pool);
+            });
+            // Compare distances: a ray through an edge shared by two clusters may report either triangle.
+            for (std::size_t i = 0; i < cameraHits.size(); ++i)
+                mismatches += cameraHits[i].T != referenceCamera[i].T;
+            mismatches += shadowHits.size() != referenceShadow.size();
+            for (std::size_t i = 0; i < std::min(shadowHits.size(), referenceShadow.size()); ++i)
+                mismatches += shadowHits[i].IsHit() != referenceShadow[i].IsHit();
+            if (mismatches != 0)
+                result = -1;
+
+            const RayEngine::StreamingGeometryStats stats = geometry->GetStats();
+            RAY_CLIENT_INFO("StreamBench: budget {:4.0f}% {}: {:6.0f} ms ({:.1f}x in-memory), read {:6.1f} MiB in {} loads, {} evictions, "
+                "{} of {} rays deferred ({} deferrals, {} loads skipped), peak {:.0f} MiB, I/O wait {:.0f} ms, {} mismatches",
+                100.0 * budget / fileBytes, frame, seconds * 1000.0, seconds / referenceSeconds, stats.BytesRead / (1024.0 * 1024.0), stats.Loads,
+                stats.Evictions, stats.DeferredRays, stats.Rays, stats.Deferrals, stats.SkippedLoads, stats.PeakResidentBytes / (1024.0 * 1024.0),
+                stats.IOWaitSeconds * 1000.0, mismatches);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return result;
+}
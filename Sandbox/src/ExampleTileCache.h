@@ -0,0 +1,285 @@
+#pragma once
+
+#include "RayEngine/Core/Application.h"
+#include "RayEngine/Geometry/Math.h"
+#include "RayEngine/Render/ContentHash.h"
+#include "RayEngine/Render/IncrementalRenderer.h"
+#include "RayEngine/Render/TileCache.h"
+#include "RayEngine/Sampling/PCG.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Sandbox cache-bench: a field of spheres over a ground plane rendered through the
+// IncrementalRenderer at 1080p and 4K. Edits of different sizes (one sphere, sixteen spheres,
+// undoing an edit, orbiting the camera and back) show that frame time follows the number of
+// touched tiles rather than the resolution, and a second cache opened on the same directory
+// shows disk hits.
+namespace ExampleTileCache
+{
+    struct Sphere
+    {
+        RayEngine::Vec3 Center;
+        float Radius = 0.0f;
+        RayEngine::Vec3 Albedo;
+    };
+
+    struct Camera
+    {
+        RayEngine::Vec3 Position;
+        RayEngine::Vec3 Forward;
+        RayEngine::Vec3 Right;
+        RayEngine::Vec3 Up;
+        float Focal = 0.0f; // pixels
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+
+        static Camera LookAt(const RayEngine::Vec3& position, const RayEngine::Vec3& target, std::uint32_t width, std::uint32_t height)
+        {
+            Camera camera;
+            camera.Position = position;
+            camera.Forward = RayEngine::Normalize(target - position);
+            camera.Right = RayEngine::Normalize(RayEngine::Cross(camera.Forward, { 0.0f, 1.0f, 0.0f }));
+            camera.Up = RayEngine::Cross(camera.Right, camera.Forward);
+            camera.Focal = 0.9f * static_cast<float>(width);
+            camera.Width = width;
+            camera.Height = height;
+            return camera;
+        }
+
+        [[nodiscard]] RayEngine::ContentHash Hash() const
+        {
+            RayEngine::ContentHasher hasher;
+            hasher.Add(Position).Add(Forward).Add(Right).Add(Up).Add(Focal).Add(Width).Add(Height);
+            return hasher.Finish();
+        }
+    };
+
+    [[nodiscard]] inline RayEngine::ContentHash HashSphere(const Sphere& sphere)
+    {
+        RayEngine::ContentHasher hasher;
+        hasher.Add(sphere.Center).Add(sphere.Radius).Add(sphere.Albedo);
+        return hasher.Finish();
+    }
+
+    struct ScreenBounds
+    {
+        float MinX = std::numeric_limits<float>::max(), MinY = std::numeric_limits<float>::max();
+        float MaxX = std::numeric_limits<float>::lowest(), MaxY = std::numeric_limits<float>::lowest();
+        bool Global = false; // crosses the camera plane: may cover anything
+    };
+
+    // Conservative: the projected corners of the sphere's bounding box.
+    [[nodiscard]] inline ScreenBounds Project(const Camera& camera, const Sphere& sphere)
+    {
+        ScreenBounds bounds;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const RayEngine::Vec3 p = sphere.Center + RayEngine::Vec3{ corner & 1 ? sphere.Radius : -sphere.Radius,
+                corner & 2 ? sphere.Radius : -sphere.Radius, corner & 4 ? sphere.Radius : -sphere.Radius };
+            const RayEngine::Vec3 d = p - camera.Position;
+            const float z = RayEngine::Dot(d, camera.Forward);
+            if (z < 1e-3f)
+            {
+                bounds.Global = true;
+                return bounds;
+            }
+            const float x = 0.5f * camera.Width + camera.Focal * RayEngine::Dot(d, camera.Right) / z;
+            const float y = 0.5f * camera.Height - camera.Focal * RayEngine::Dot(d, camera.Up) / z;
+            bounds.MinX = std::min(bounds.MinX, x);
+            bounds.MaxX = std::max(bounds.MaxX, x);
+            bounds.MinY = std::min(bounds.MinY, y);
+            bounds.MaxY = std::max(bounds.MaxY, y);
+        }
+        bounds.MaxX += 1.0f; // pixel (x, y) covers [x, x + 1)
+        bounds.MaxY += 1.0f;
+        return bounds;
+    }
+
+    class Scene
+    {
+    public:
+        std::vector<Sphere> Spheres;
+
+        void Describe(RayEngine::IncrementalRenderer& renderer, const Camera& camera)
+        {
+            RayEngine::ContentHasher frame;
+            frame.Add(camera.Hash()).Add(std::string_view("ground:checker,sky:gradient,spp:4"));
+            renderer.BeginFrame(frame.Finish());
+
+            m_Bounds.resize(Spheres.size());
+            for (std::size_t i = 0; i < Spheres.size(); ++i)
+            {
+                m_Bounds[i] = Project(camera, Spheres[i]);
+                if (m_Bounds[i].Global)
+                    renderer.AddGlobalDependency(HashSphere(Spheres[i]));
+                else
+                    renderer.AddDependency(m_Bounds[i].MinX, m_Bounds[i].MinY, m_Bounds[i].MaxX, m_Bounds[i].MaxY, HashSphere(Spheres[i]));
+            }
+        }
+
+        // 2x2 stratified samples, Lambert + sky, no shadows (so sphere bounds cover everything a
+        // sphere changes). Only spheres whose bounds overlap the tile are tested.
+        void RenderTile(const Camera& camera, const RayEngine::Tile& tile, std::span<std::byte> pixels) const
+        {
+            std::vector<const Sphere*> candidates;
+            for (std::size_t i = 0; i < Spheres.size(); ++i)
+            {
+                const ScreenBounds& b = m_Bounds[i];
+                if (b.Global || (b.MaxX > tile.X && b.MinX < tile.X + tile.Width && b.MaxY > tile.Y && b.MinY < tile.Y + tile.Height))
+                    candidates.push_back(&Spheres[i]);
+            }
+
+            const RayEngine::Vec3 light = RayEngine::Normalize({ 0.4f, 1.0f, 0.3f });
+            for (std::uint32_t y = 0; y < tile.Height; ++y)
+            {
+                for (std::uint32_t x = 0; x < tile.Width; ++x)
+                {
+                    RayEngine::Vec3 color{};
+                    for (int s = 0; s < 4; ++s)
+                    {
+                        const float px = static_cast<float>(tile.X + x) + 0.25f + 0.5f * (s & 1);
+                        const float py = static_cast<float>(tile.Y + y) + 0.25f + 0.5f * (s >> 1);
+                        const RayEngine::Vec3 dir = RayEngine::Normalize(camera.Forward * camera.Focal
+                            + camera.Right * (px - 0.5f * camera.Width) - camera.Up * (py - 0.5f * camera.Height));
+
+                        float nearest = std::numeric_limits<float>::max();
+                        RayEngine::Vec3 normal{}, albedo{};
+                        for (const Sphere* sphere : candidates)
+                        {
+                            const RayEngine::Vec3 oc = camera.Position - sphere->Center;
+                            const float b = RayEngine::Dot(oc, dir);
+                            const float disc = b * b - (RayEngine::Dot(oc, oc) - sphere->Radius * sphere->Radius);
+                            if (disc < 0.0f)
+                                continue;
+                            const float t = -b - std::sqrt(disc);
+                            if (t > 1e-3f && t < nearest)
+                            {
+                                nearest = t;
+                                normal = RayEngine::Normalize(camera.Position + dir * t - sphere->Center);
+                                albedo = sphere->Albedo;
+                            }
+                        }
+                        if (dir.Y < 0.0f)
+                        {
+                            const float t = -camera.Position.Y / dir.Y;
+                            if (t < nearest)
+                            {
+                                nearest = t;
+                                const RayEngine::Vec3 p = camera.Position + dir * t;
+                                const bool checker = (static_cast<int>(std::floor(p.X)) + static_cast<int>(std::floor(p.Z))) & 1;
+                                normal = { 0.0f, 1.0f, 0.0f };
+                                albedo = checker ? RayEngine::Vec3{ 0.8f, 0.8f, 0.8f } : RayEngine::Vec3{ 0.3f, 0.3f, 0.3f };
+                            }
+                        }
+
+                        if (nearest == std::numeric_limits<float>::max())
+                            color += RayEngine::Vec3{ 0.5f, 0.7f, 1.0f } * (0.5f + 0.5f * dir.Y);
+                        else
+                            color += albedo * (0.15f + 0.85f * std::max(0.0f, RayEngine::Dot(normal, light)));
+                    }
+
+                    std::byte* out = pixels.data() + (static_cast<std::size_t>(y) * tile.Width + x) * 4;
+                    out[0] = static_cast<std::byte>(std::min(255.0f, color.X * 63.75f));
+                    out[1] = static_cast<std::byte>(std::min(255.0f, color.Y * 63.75f));
+                    out[2] = static_cast<std::byte>(std::min(255.0f, color.Z * 63.75f));
+                    out[3] = std::byte{ 255 };
+                }
+            }
+        }
+
+    private:
+        std::vector<ScreenBounds> m_Bounds;
+    };
+
+    [[nodiscard]] inline Scene MakeScene()
+    {
+        Scene scene;
+        RayEngine::PCG32 rng(11);
+        for (int i = 0; i < 96; ++i)
+        {
+            const float radius = 0.2f + 0.5f * rng.NextFloat();
+            scene.Spheres.push_back({ { rng.NextFloat() * 24.0f - 12.0f, radius, rng.NextFloat() * 24.0f - 18.0f }, radius,
+                { 0.2f + 0.8f * rng.NextFloat(), 0.2f + 0.8f * rng.NextFloat(), 0.2f + 0.8f * rng.NextFloat() } });
+        }
+        return scene;
+    }
+}
+
+inline int RunTileCacheBenchmark()
+{
+    using namespace ExampleTileCache;
+    auto& pool = RayEngine::Application::GetInstance().GetThreadPool();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "rayengine_tile_cache";
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+
+    for (const auto& [width, height] : { std::pair{ 1920u, 1080u }, std::pair{ 3840u, 2160u } })
+    {
+        RayEngine::TileCacheSpec cacheSpec;
+        cacheSpec.MemoryBudgetBytes = 128ull * 1024 * 1024;
+        cacheSpec.DiskDirectory = directory;
+        RayEngine::TileCache cache(cacheSpec);
+        RayEngine::IncrementalRenderer renderer({ width, height, 32, 4 });
+
+        Scene scene = MakeScene();
+        const Camera home = Camera::LookAt({ 0.0f, 3.0f, 8.0f }, { 0.0f, 0.5f, -4.0f }, width, height);
+        const Camera orbit = Camera::LookAt({ 3.0f, 3.5f, 7.5f }, { 0.0f, 0.5f, -4.0f }, width, height);
+
+        const auto frame = [&](const char* label, const Camera& camera) {
+            scene.Describe(renderer, camera);
+            const RayEngine::IncrementalFrameStats stats = renderer.Render(
+                [&](const RayEngine::Tile& tile, std::span<std::byte> pixels) { scene.RenderTile(camera, tile, pixels); }, &cache, &pool);
+            RAY_CLIENT_INFO("CacheBench: {}x{} {:<22} {:8.2f} ms  tiles {:5}  unchanged {:5}  cache hits {:5}  rendered {:5}",
+                width, height, label, stats.Seconds * 1000.0, stats.Tiles, stats.Unchanged, stats.CacheHits, stats.Rendered);
+        };
+
+        frame("cold", home);
+        frame("no change", home);
+
+        const Sphere original = scene.Spheres[5];
+        scene.Spheres[5].Center.X += 0.3f;
+        frame("move 1 sphere", home);
+        scene.Spheres[5] = original;
+        frame("undo (cache)", home);
+
+        const std::vector<Sphere> before = scene.Spheres;
+        for (std::size_t i = 0; i < 16; ++i)
+            scene.Spheres[i * 6].Center.Z -= 0.5f;
+        frame("move 16 spheres", home);
+        scene.Spheres = before;
+        frame("undo 16 (cache)", home);
+
+        frame("orbit camera", orbit);
+        frame("orbit back (cache)", home);
+
+        const RayEngine::TileCacheStats stats = cache.GetStats();
+        RAY_CLIENT_INFO("CacheBench: memory hits {}, disk hits {}, misses {}, stores {}, evictions {} / {}, {} MiB in memory, {} MiB on disk",
+            stats.MemoryHits, stats.DiskHits, stats.Misses, stats.Stores, stats.MemoryEvictions, stats.DiskEvictions,
+            stats.MemoryBytes >> 20, stats.DiskBytes >> 20);
+    }
+
+    // A fresh process would start like this: empty memory level, tiles indexed from disk.
+    {
+        RayEngine::TileCacheSpec cacheSpec;
+        cacheSpec.DiskDirectory = directory;
+        RayEngine::TileCache cache(cacheSpec);
+        RayEngine::IncrementalRenderer renderer({ 1920, 1080, 32, 4 });
+        Scene scene = MakeScene();
+        const Camera home = Camera::LookAt({ 0.0f, 3.0f, 8.0f }, { 0.0f, 0.5f, -4.0f }, 1920, 1080);
+        scene.Describe(renderer, home);
+        const RayEngine::IncrementalFrameStats frame = renderer.Render(
+            [&](const RayEngine::Tile& tile, std::span<std::byte> pixels) { scene.RenderTile(home, tile, pixels); }, &cache, &pool);
+        const RayEngine::TileCacheStats stats = cache.GetStats();
+        RAY_CLIENT_INFO("CacheBench: restarted 1920x1080 cold frame {:.2f} ms, {} disk hits, {} rendered",
+            frame.Seconds * 1000.0, stats.DiskHits, frame.Rendered);
+    }
+
+    std::filesystem::remove_all(directory, ec);
+    return 0;
+}
@@ -1,18 +1,91 @@
 #include<iostream>
+#include <string_view>
 
 #include "ExampleLayer.h"
 #include "ExampleLayerDirectTest.h"
 #include "ExampleLayerAsyncTest.h"
+#include "ExampleLayerTaskTest.h"
+#include "ExampleLayerTaskBench.h"
+#include "ExampleLayerIOBench.h"
+#include "ExampleLayerAllocReport.h"
+#include "ExampleMultiInstance.h"
+#include "ExampleDistributedRender.h"
+#include "ExampleFramePublish.h"
+#include "ExampleBVHCompression.h"
+#include "ExampleSampling.h"
+#include "ExampleFilm.h"
+#include "ExampleNuma.h"
+#include "ExampleTileCache.h"
+#include "ExampleECS.h"
+#include "ExampleLightBVH.h"
+#include "ExampleStreaming.h"
+#include "ExampleIdle.h"
+#include "ExampleMaterials.h"
 
 #include "RayEngine.h"
 
-int main()
+int main(int argc, char** argv)
 {
+#ifdef __linux__
+	// Worker process launched by RenderCoordinator::SpawnWorkers (see dist-bench).
+	if (RayEngine::RenderWorker::IsWorkerCommandLine(argc, argv))
+	{
+		RayEngine::Log::Init();
+		const int result = RayEngine::RenderWorker::RunFromCommandLine(argc, argv, ExampleMandelbrotKernel);
+		RayEngine::Log::ShutDown();
+		return result;
+	}
+	// Frame ring reader process launched by frame-pub-bench.
+	if (argc > 1 && argv[1] == exampleFrameReaderFlag)
+		return RunFrameReaderProcess(argc, argv);
+#endif
+
 	auto& app = RayEngine::Application::GetInstance();
 
 	if (!app.Initialize()) // explicit init with error reporting
 		return -1;
 
-	app.PushLayer(std::make_unique<ExampleLayerAsync>());
+	// Optional demo selection: Sandbox [async|task|task-bench|io-bench|io-bench-pread|alloc-report|multi|dist-bench|frame-pub-bench|bvh-bench|sampling-bench|film-bench|numa-bench|cache-bench|ecs-bench|light-bench|stream-bench|idle-bench|material-bench]
+	const std::string_view demo = argc > 1 ? argv[1] : "async";
+	if (demo == "multi")
+		return RunMultiInstanceExample(4);
+	else if (demo == "bvh-bench")
+		return RunBVHCompressionBenchmark();
+	else if (demo == "sampling-bench")
+		return RunSamplingBenchmark();
+	else if (demo == "film-bench")
+		return RunFilmBenchmark();
+	else if (demo == "numa-bench")
+		return RunNumaBenchmark();
+	else if (demo == "cache-bench")
+		return RunTileCacheBenchmark();
+	else if (demo == "ecs-bench")
+		return RunECSBenchmark();
+	else if (demo == "light-bench")
+		return RunLightBVHBenchmark();
+	else if (demo == "stream-bench")
+		return RunStreamingBenchmark();
+	else if (demo == "idle-bench")
+		return RunIdleBenchmark();
+	else if (demo == "material-bench")
+		return RunMaterialBenchmark();
+#ifdef __linux__
+	else if (demo == "dist-bench")
+		return RunDistributedRenderBenchmark();
+	else if (demo == "frame-pub-bench")
+		app.PushLayer(std::make_unique<ExampleLayerFramePublish>());
+#endif
+	else if (demo == "task")
+		app.PushLayer(std::make_unique<ExampleLayerTask>());
+	else if (demo == "task-bench")
+		app.PushLayer(std::make_unique<ExampleLayerTaskBench>());
+	else if (demo == "io-bench")
+		app.PushLayer(std::make_unique<ExampleLayerIOBench>());
+	else if (demo == "io-bench-pread")
+		app.PushLayer(std::make_unique<ExampleLayerIOBench>(RayEngine::IOService::BackendType::Pread));
+	else if (demo == "alloc-report")
+		app.PushLayer(std::make_unique<ExampleLayerAllocReport>());
+	else
+		app.PushLayer(std::make_unique<ExampleLayerAsync>());
 	return app.Run() ? 0 : -1;
-}
\ No newline at end of file
+}